@@ -24,6 +24,9 @@ using gol::Coordinate;
 
 auto constexpr dead_cell = ox::Glyph{U' '};
 
+/// Most generations stepped by one Timer_event when catching up.
+auto constexpr max_catch_up_steps = 4;
+
 /// Applies the given \p offset to each cell Coordinate in \p cells.
 template <typename Container_t>
 void apply(bool hi_res, Coordinate offset, Container_t& cells)
@@ -71,7 +74,10 @@ void GoL_widget::step()
 {
     if (this->is_animated())
         return;
-    engine_.step_to_next_generation();
+    // Catch up on missed frames, bounded so a slow step can't spiral.
+    auto const steps = std::min(this->frame_time().steps, max_catch_up_steps);
+    for (auto i = 0; i < steps; ++i)
+        engine_.step_to_next_generation();
     this->update();
 }
 
@@ -147,8 +147,8 @@ auto populated_glyph_selector() -> std::unique_ptr<Glyph_selector>
         [&shapes](ox::Palette const& p) { shapes.set_text(color_shapes(p)); },
         shapes);
 
-    ox::Terminal::palette_changed.connect(build_blocks);
-    ox::Terminal::palette_changed.connect(build_shapes);
+    ox::Terminal::palette_changed().connect(build_blocks);
+    ox::Terminal::palette_changed().connect(build_shapes);
 
     return result;
 }
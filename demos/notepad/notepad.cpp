@@ -68,7 +68,7 @@ Labeled_color_select::Labeled_color_select(Parameters p)
 {
     using namespace ox::pipe;
 
-    ox::Terminal::palette_changed.connect(
+    ox::Terminal::palette_changed().connect(
         [this](auto const& pal) { this->set_heights(pal); });
 
     this->set_heights(ox::Terminal::current_palette());
@@ -195,7 +195,7 @@ class Palette_creator : public ox::HPair<Color_control, ox::Color_select> {
         control.new_color.connect(
             [this](ox::True_color c) { this->update_selected(c); });
         select.color_selected.connect([this](ox::Color c) { selected_ = c; });
-        ox::Terminal::palette_changed.connect(
+        ox::Terminal::palette_changed().connect(
             [this](auto const& pal) { palette_ = pal; });
     }
 
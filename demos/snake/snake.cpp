@@ -342,7 +342,11 @@ auto Game_space::key_press_event(ox::Key k) -> bool
 
 auto Game_space::timer_event() -> bool
 {
-    engine_.increment();
+    for (auto i = 0; i < this->frame_time().steps; ++i) {
+        engine_.increment();
+        if (engine_.is_game_over())
+            break;
+    }
     this->update();
     return Widget::timer_event();
 }
@@ -36,7 +36,7 @@ class Priority_queue {
     {
         auto result = std::move(const_cast<T&>(this->top()));
         queue_.pop();
-        return std::move(result);
+        return result;
     }
 
    private:
@@ -0,0 +1,462 @@
+#ifndef TERMOX_COMMON_SMALL_VECTOR_HPP
+#define TERMOX_COMMON_SMALL_VECTOR_HPP
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace ox {
+
+/// Contiguous container with the interface of std::vector and inline storage.
+/** The first \p N elements are stored within the object itself, the heap is
+ *  only used once the size grows past \p N. T must be trivially copyable, so
+ *  elements are relocated with a plain copy and never destroyed. Iterators
+ *  are raw pointers and are invalidated on any reallocation, and on move and
+ *  swap while the elements are held inline. */
+template <typename T, std::size_t N>
+class Small_vector {
+   public:
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Small_vector: T must be trivially copyable.");
+    static_assert(N > 0, "Small_vector: Inline capacity must be non-zero.");
+
+    using value_type             = T;
+    using allocator_type         = std::allocator<T>;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T&;
+    using const_reference        = T const&;
+    using pointer                = T*;
+    using const_pointer          = T const*;
+    using iterator               = T*;
+    using const_iterator         = T const*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// The number of elements that can be held without a heap allocation.
+    static constexpr auto inline_capacity = N;
+
+   public:
+    Small_vector() = default;
+
+    explicit Small_vector(size_type count) { this->resize(count); }
+
+    Small_vector(size_type count, T const& value)
+    {
+        this->assign(count, value);
+    }
+
+    template <typename InputIterator,
+              typename = typename std::iterator_traits<
+                  InputIterator>::iterator_category>
+    Small_vector(InputIterator first, InputIterator last)
+    {
+        this->assign(first, last);
+    }
+
+    Small_vector(std::initializer_list<T> list)
+    {
+        this->assign(list.begin(), list.end());
+    }
+
+    Small_vector(Small_vector const& other)
+    {
+        this->assign(other.begin(), other.end());
+    }
+
+    Small_vector(Small_vector&& other) noexcept { this->steal(other); }
+
+    auto operator=(Small_vector const& other) -> Small_vector&
+    {
+        if (this != &other)
+            this->assign(other.begin(), other.end());
+        return *this;
+    }
+
+    auto operator=(Small_vector&& other) noexcept -> Small_vector&
+    {
+        if (this != &other) {
+            this->release();
+            this->steal(other);
+        }
+        return *this;
+    }
+
+    auto operator=(std::initializer_list<T> list) -> Small_vector&
+    {
+        this->assign(list.begin(), list.end());
+        return *this;
+    }
+
+    ~Small_vector() { this->release(); }
+
+   public:
+    void assign(size_type count, T const& value)
+    {
+        auto const copy = value;
+        this->clear();
+        this->reserve(count);
+        std::uninitialized_fill_n(data_, count, copy);
+        size_ = count;
+    }
+
+    template <typename InputIterator,
+              typename = typename std::iterator_traits<
+                  InputIterator>::iterator_category>
+    void assign(InputIterator first, InputIterator last)
+    {
+        this->clear();
+        this->insert(this->end(), first, last);
+    }
+
+    void assign(std::initializer_list<T> list)
+    {
+        this->assign(list.begin(), list.end());
+    }
+
+    [[nodiscard]] auto get_allocator() const -> allocator_type { return {}; }
+
+   public:
+    [[nodiscard]] auto at(size_type pos) -> reference
+    {
+        if (pos >= size_)
+            throw std::out_of_range{"Small_vector::at: Index out of range."};
+        return data_[pos];
+    }
+
+    [[nodiscard]] auto at(size_type pos) const -> const_reference
+    {
+        if (pos >= size_)
+            throw std::out_of_range{"Small_vector::at: Index out of range."};
+        return data_[pos];
+    }
+
+    [[nodiscard]] auto operator[](size_type pos) -> reference
+    {
+        return data_[pos];
+    }
+
+    [[nodiscard]] auto operator[](size_type pos) const -> const_reference
+    {
+        return data_[pos];
+    }
+
+    [[nodiscard]] auto front() -> reference { return data_[0]; }
+
+    [[nodiscard]] auto front() const -> const_reference { return data_[0]; }
+
+    [[nodiscard]] auto back() -> reference { return data_[size_ - 1]; }
+
+    [[nodiscard]] auto back() const -> const_reference
+    {
+        return data_[size_ - 1];
+    }
+
+    [[nodiscard]] auto data() noexcept -> pointer { return data_; }
+
+    [[nodiscard]] auto data() const noexcept -> const_pointer { return data_; }
+
+   public:
+    [[nodiscard]] auto begin() noexcept -> iterator { return data_; }
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return data_;
+    }
+
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator
+    {
+        return data_;
+    }
+
+    [[nodiscard]] auto end() noexcept -> iterator { return data_ + size_; }
+
+    [[nodiscard]] auto end() const noexcept -> const_iterator
+    {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] auto cend() const noexcept -> const_iterator
+    {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] auto rbegin() noexcept -> reverse_iterator
+    {
+        return reverse_iterator{this->end()};
+    }
+
+    [[nodiscard]] auto rbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{this->end()};
+    }
+
+    [[nodiscard]] auto crbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{this->end()};
+    }
+
+    [[nodiscard]] auto rend() noexcept -> reverse_iterator
+    {
+        return reverse_iterator{this->begin()};
+    }
+
+    [[nodiscard]] auto rend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{this->begin()};
+    }
+
+    [[nodiscard]] auto crend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{this->begin()};
+    }
+
+   public:
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+    [[nodiscard]] auto size() const noexcept -> size_type { return size_; }
+
+    [[nodiscard]] auto max_size() const noexcept -> size_type
+    {
+        return std::numeric_limits<difference_type>::max() / sizeof(T);
+    }
+
+    /// Grow the capacity to at least \p count, never shrinks.
+    void reserve(size_type count)
+    {
+        if (count > capacity_)
+            this->reallocate(count);
+    }
+
+    [[nodiscard]] auto capacity() const noexcept -> size_type
+    {
+        return capacity_;
+    }
+
+    /// Move back into the inline buffer if the elements fit, else trim heap.
+    void shrink_to_fit()
+    {
+        if (this->is_inline() || size_ == capacity_)
+            return;
+        if (size_ <= N) {
+            auto* const heap = data_;
+            auto const cap   = capacity_;
+            std::uninitialized_copy_n(heap, size_, this->buffer());
+            data_     = this->buffer();
+            capacity_ = N;
+            allocator_type{}.deallocate(heap, cap);
+        }
+        else
+            this->reallocate(size_);
+    }
+
+   public:
+    /// Removes all elements, keeps the current capacity.
+    void clear() noexcept { size_ = 0; }
+
+    auto insert(const_iterator pos, T const& value) -> iterator
+    {
+        return this->insert(pos, size_type{1}, value);
+    }
+
+    auto insert(const_iterator pos, size_type count, T const& value)
+        -> iterator
+    {
+        auto const copy  = value;
+        auto* const at   = this->open_gap(pos, count);
+        std::uninitialized_fill_n(at, count, copy);
+        return at;
+    }
+
+    template <typename InputIterator,
+              typename = typename std::iterator_traits<
+                  InputIterator>::iterator_category>
+    auto insert(const_iterator pos, InputIterator first, InputIterator last)
+        -> iterator
+    {
+        using Category =
+            typename std::iterator_traits<InputIterator>::iterator_category;
+        if constexpr (std::is_convertible_v<InputIterator, const_pointer>) {
+            // open_gap() moves or frees the elements a self range points at.
+            if (this->owns(first)) {
+                auto const copy = Small_vector(first, last);
+                return this->insert(pos, copy.begin(), copy.end());
+            }
+        }
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            auto const count =
+                static_cast<size_type>(std::distance(first, last));
+            auto* const at = this->open_gap(pos, count);
+            std::uninitialized_copy(first, last, at);
+            return at;
+        }
+        else {
+            auto const offset = pos - this->cbegin();
+            for (auto at = offset; first != last; ++first, ++at)
+                this->insert(this->cbegin() + at, *first);
+            return this->begin() + offset;
+        }
+    }
+
+    auto insert(const_iterator pos, std::initializer_list<T> list) -> iterator
+    {
+        return this->insert(pos, list.begin(), list.end());
+    }
+
+    template <typename... Args>
+    auto emplace(const_iterator pos, Args&&... args) -> iterator
+    {
+        return this->insert(pos, T(std::forward<Args>(args)...));
+    }
+
+    auto erase(const_iterator pos) -> iterator
+    {
+        return this->erase(pos, pos + 1);
+    }
+
+    auto erase(const_iterator first, const_iterator last) -> iterator
+    {
+        auto* const at = this->begin() + (first - this->cbegin());
+        std::copy(last, this->cend(), at);
+        size_ -= static_cast<size_type>(last - first);
+        return at;
+    }
+
+    void push_back(T const& value)
+    {
+        if (size_ == capacity_) {
+            auto const copy = value;
+            this->reallocate(this->grown_capacity(size_ + 1));
+            ::new (static_cast<void*>(data_ + size_)) T(copy);
+        }
+        else
+            ::new (static_cast<void*>(data_ + size_)) T(value);
+        ++size_;
+    }
+
+    template <typename... Args>
+    auto emplace_back(Args&&... args) -> reference
+    {
+        this->push_back(T(std::forward<Args>(args)...));
+        return this->back();
+    }
+
+    void pop_back() { --size_; }
+
+    void resize(size_type count) { this->resize(count, T{}); }
+
+    void resize(size_type count, T const& value)
+    {
+        if (count > size_)
+            this->insert(this->cend(), count - size_, value);
+        else
+            size_ = count;
+    }
+
+    void swap(Small_vector& other) noexcept
+    {
+        auto temp = std::move(other);
+        other     = std::move(*this);
+        *this     = std::move(temp);
+    }
+
+   private:
+    pointer data_       = this->buffer();
+    size_type size_     = 0;
+    size_type capacity_ = N;
+    alignas(T) unsigned char storage_[N * sizeof(T)];
+
+   private:
+    [[nodiscard]] auto buffer() noexcept -> pointer
+    {
+        return reinterpret_cast<pointer>(storage_);
+    }
+
+    [[nodiscard]] auto is_inline() const noexcept -> bool
+    {
+        return data_ == reinterpret_cast<const_pointer>(storage_);
+    }
+
+    /// Return true if \p p points into the current storage of this.
+    [[nodiscard]] auto owns(const_pointer p) const noexcept -> bool
+    {
+        return std::less_equal<const_pointer>{}(data_, p) &&
+               std::less<const_pointer>{}(p, data_ + capacity_);
+    }
+
+    /// Doubles the capacity, or jumps straight to \p minimum if larger.
+    [[nodiscard]] auto grown_capacity(size_type minimum) const -> size_type
+    {
+        return std::max(capacity_ * 2, minimum);
+    }
+
+    /// Move elements into a new heap block of \p capacity elements.
+    void reallocate(size_type capacity)
+    {
+        auto* const block = allocator_type{}.allocate(capacity);
+        std::uninitialized_copy_n(data_, size_, block);
+        this->release();
+        data_     = block;
+        capacity_ = capacity;
+    }
+
+    /// Shift [pos, end) right by \p count elements, growing if needed.
+    /** Returns a pointer to the uninitialized gap. */
+    auto open_gap(const_iterator pos, size_type count) -> pointer
+    {
+        auto const offset = static_cast<size_type>(pos - this->cbegin());
+        if (size_ + count > capacity_) {
+            auto const cap    = this->grown_capacity(size_ + count);
+            auto* const block = allocator_type{}.allocate(cap);
+            std::uninitialized_copy_n(data_, offset, block);
+            std::uninitialized_copy(data_ + offset, data_ + size_,
+                                    block + offset + count);
+            this->release();
+            data_     = block;
+            capacity_ = cap;
+        }
+        else if (count != 0) {
+            std::memmove(static_cast<void*>(data_ + offset + count),
+                         static_cast<void const*>(data_ + offset),
+                         (size_ - offset) * sizeof(T));
+        }
+        size_ += count;
+        return data_ + offset;
+    }
+
+    /// Free the heap block, if any. Leaves size_ and capacity_ untouched.
+    void release() noexcept
+    {
+        if (!this->is_inline())
+            allocator_type{}.deallocate(data_, capacity_);
+    }
+
+    /// Take the contents of \p other, leaving it empty and inline.
+    void steal(Small_vector& other) noexcept
+    {
+        if (other.is_inline()) {
+            std::uninitialized_copy_n(other.data_, other.size_,
+                                      this->buffer());
+            data_     = this->buffer();
+            capacity_ = N;
+        }
+        else {
+            data_     = other.data_;
+            capacity_ = other.capacity_;
+        }
+        size_           = other.size_;
+        other.data_     = other.buffer();
+        other.size_     = 0;
+        other.capacity_ = N;
+    }
+};
+
+}  // namespace ox
+#endif  // TERMOX_COMMON_SMALL_VECTOR_HPP
@@ -11,7 +11,7 @@ class Timer {
    public:
     using Clock_t    = std::chrono::steady_clock;
     using Time_point = Clock_t::time_point;
-    using Duration_t = std::chrono::milliseconds;
+    using Duration_t = std::chrono::nanoseconds;
 
    public:
     /// Construct a Timer with the given interval.
@@ -37,6 +37,10 @@ class Timer {
     /// Return the currently set interval.
     [[nodiscard]] auto get_interval() const -> Duration_t;
 
+    /// Return the time point that wait() sleeps until.
+    /** In the past if begin() has not been called. */
+    [[nodiscard]] auto deadline() const -> Time_point;
+
    private:
     Duration_t interval_;
     Time_point last_time_;
@@ -47,5 +51,22 @@ class Timer {
     [[nodiscard]] auto get_sleep_time() const -> Clock_t::duration;
 };
 
+/// Timing of a single animation frame, carried by each Timer_event.
+struct Frame_time {
+    /// The deadline this frame was due at, on the Widget's interval.
+    Timer::Time_point scheduled = {};
+
+    /// When the frame was actually fired by the animation engine.
+    Timer::Time_point actual = {};
+
+    /// Time since the previous frame, or since animation was enabled.
+    Timer::Duration_t elapsed = Timer::Duration_t::zero();
+
+    /// Intervals that have passed since the previous frame, at least one.
+    /** Greater than one when frames were missed, a Widget can advance its
+     *  animation by this many steps to keep pace with the clock. */
+    int steps = 1;
+};
+
 }  // namespace ox
 #endif  // TERMOX_COMMON_TIMER_HPP
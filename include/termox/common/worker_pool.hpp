@@ -0,0 +1,50 @@
+#ifndef TERMOX_COMMON_WORKER_POOL_HPP
+#define TERMOX_COMMON_WORKER_POOL_HPP
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace ox {
+
+/// Fixed number of threads that run submitted work in submission order.
+/** Used to keep blocking work off of the event loops, see task.hpp for
+ *  awaiting its completion from a coroutine. */
+class Worker_pool {
+   public:
+    /// Launch \p thread_count threads, at least one.
+    explicit Worker_pool(std::size_t thread_count = default_thread_count());
+
+    Worker_pool(Worker_pool const&) = delete;
+    Worker_pool& operator=(Worker_pool const&) = delete;
+
+    /// Finish all submitted work, then join the threads.
+    ~Worker_pool();
+
+   public:
+    /// Run \p work on one of the pool's threads, \p work must not throw.
+    void submit(std::function<void()> work);
+
+    /// Return the number of threads in the pool.
+    [[nodiscard]] auto thread_count() const -> std::size_t;
+
+    /// Return std::thread::hardware_concurrency(), or one if it is unknown.
+    [[nodiscard]] static auto default_thread_count() -> std::size_t;
+
+   private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> work_;
+    bool exit_ = false;
+    std::vector<std::future<void>> threads_;
+
+   private:
+    /// Run work until exit_ is set and there is no more work.
+    void loop_function();
+};
+
+}  // namespace ox
+#endif  // TERMOX_COMMON_WORKER_POOL_HPP
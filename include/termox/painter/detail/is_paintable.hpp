@@ -1,5 +1,6 @@
 #ifndef TERMOX_PAINTER_DETAIL_IS_PAINTABLE_HPP
 #define TERMOX_PAINTER_DETAIL_IS_PAINTABLE_HPP
+#include <termox/widget/rect.hpp>
 
 namespace ox {
 class Widget;
@@ -8,7 +9,12 @@ class Widget;
 namespace ox::detail {
 
 /// A check for whether a widget is in a state that can be painted.
+/** False if no part of \p w is visible, see visible_region(). */
 [[nodiscard]] auto is_paintable(Widget const& w) -> bool;
 
+/// Return the part of \p w that is not clipped away, in local coordinates.
+/** \p w is clipped to each ancestor that clips_children(). */
+[[nodiscard]] auto visible_region(Widget const& w) -> Rect;
+
 }  // namespace ox::detail
 #endif  // TERMOX_PAINTER_DETAIL_IS_PAINTABLE_HPP
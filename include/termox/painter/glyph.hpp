@@ -11,6 +11,8 @@ namespace ox {
 struct Glyph {
    public:
     /// The Glyph's symbol is the wide character that will be displayed.
+    /** Or, if is_grapheme_cluster(symbol), an interned grapheme cluster. See
+     *  intern_grapheme(). */
     char32_t symbol = U'\0';
 
     /// The Brush that will determine the Traits and Colors of the symbol.
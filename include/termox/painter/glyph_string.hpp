@@ -1,22 +1,29 @@
 #ifndef TERMOX_PAINTER_GLYPH_STRING_HPP
 #define TERMOX_PAINTER_GLYPH_STRING_HPP
+#include <cstddef>
 #include <string>
 #include <string_view>
-#include <vector>
 
 #include <termox/common/mb_to_u32.hpp>
+#include <termox/common/small_vector.hpp>
 #include <termox/painter/brush.hpp>
 #include <termox/painter/color.hpp>
 #include <termox/painter/glyph.hpp>
+#include <termox/painter/grapheme.hpp>
 #include <termox/painter/trait.hpp>
 
 namespace ox {
 
-// TODO hold a vector instead of inherit from one, explicitly defer to vector
-// methods instead of using = statements.
+namespace detail {
+
+/// Glyph_string storage, short labels and titles stay off of the heap.
+using Glyph_vector = Small_vector<Glyph, 15>;
+
+}  // namespace detail
 
 /// Holds a collection of Glyphs with a similar interface to std::string.
-class Glyph_string : private std::vector<Glyph> {
+/** Up to 15 Glyphs are stored inline, longer strings spill to the heap. */
+class Glyph_string : private detail::Glyph_vector {
    public:
     /// Used to indicate 'Until the end of the string'.
     static constexpr auto npos = -1;
@@ -28,13 +35,20 @@ class Glyph_string : private std::vector<Glyph> {
     /// Construct with \p count \p glyph's, adding given Traits to each.
     explicit Glyph_string(Glyph glyph, int count = 1);
 
-    /// Construct with a Glyph for each char32_t in \p symbols and Brush \p b.
-    /** Attributes can be background/foreground Colors and Traits. */
+    /// Construct with a Glyph for each grapheme cluster in \p symbols.
+    /** Combining sequences, ZWJ emoji and flags become a single Glyph, see
+     *  intern_grapheme(). Attributes can be background/foreground Colors and
+     *  Traits. */
     template <typename... Attributes>
     Glyph_string(std::u32string_view symbols, Attributes... attrs)
     {
-        for (char32_t c : symbols)
-            this->append(Glyph{c, Brush{attrs...}});
+        auto const brush = Brush{attrs...};
+        for (auto i = std::size_t{0}; i < symbols.size();) {
+            auto const end = next_grapheme_boundary(symbols, i);
+            this->append(
+                Glyph{intern_grapheme(symbols.substr(i, end - i)), brush});
+            i = end;
+        }
     }
 
     template <typename... Attributes>
@@ -70,7 +84,7 @@ class Glyph_string : private std::vector<Glyph> {
     /** The iterator type must be iterating over Glyphs. */
     template <typename InputIterator>
     Glyph_string(InputIterator first, InputIterator last)
-        : vector<Glyph>::vector(first, last)
+        : detail::Glyph_vector(first, last)
     {}
 
    public:
@@ -90,7 +104,7 @@ class Glyph_string : private std::vector<Glyph> {
     [[nodiscard]] auto size() const -> int;
 
    public:
-    /// Convert to a std::u32string, each Glyph being a char32_t.
+    /// Convert to a std::u32string, expanding grapheme clusters.
     /** All Brush attributes are lost. */
     [[nodiscard]] auto u32str() const -> std::u32string;
 
@@ -123,46 +137,47 @@ class Glyph_string : private std::vector<Glyph> {
 
    public:
     using size_type = int;
-    using std::vector<Glyph>::value_type;
-    using std::vector<Glyph>::allocator_type;
-    using std::vector<Glyph>::difference_type;
-    using std::vector<Glyph>::reference;
-    using std::vector<Glyph>::const_reference;
-    using std::vector<Glyph>::pointer;
-    using std::vector<Glyph>::const_pointer;
-    using std::vector<Glyph>::iterator;
-    using std::vector<Glyph>::const_iterator;
-    using std::vector<Glyph>::reverse_iterator;
-    using std::vector<Glyph>::const_reverse_iterator;
-
-    using std::vector<Glyph>::operator[];
-    using std::vector<Glyph>::size;
-    using std::vector<Glyph>::assign;
-    using std::vector<Glyph>::get_allocator;
-    using std::vector<Glyph>::at;
-    using std::vector<Glyph>::front;
-    using std::vector<Glyph>::back;
-    using std::vector<Glyph>::data;
-    using std::vector<Glyph>::begin;
-    using std::vector<Glyph>::cbegin;
-    using std::vector<Glyph>::end;
-    using std::vector<Glyph>::cend;
-    using std::vector<Glyph>::rbegin;
-    using std::vector<Glyph>::crbegin;
-    using std::vector<Glyph>::rend;
-    using std::vector<Glyph>::crend;
-    using std::vector<Glyph>::empty;
-    using std::vector<Glyph>::max_size;
-    using std::vector<Glyph>::reserve;
-    using std::vector<Glyph>::capacity;
-    using std::vector<Glyph>::shrink_to_fit;
-    using std::vector<Glyph>::clear;
-    using std::vector<Glyph>::insert;
-    using std::vector<Glyph>::erase;
-    using std::vector<Glyph>::push_back;
-    using std::vector<Glyph>::pop_back;
-    using std::vector<Glyph>::resize;
-    using std::vector<Glyph>::swap;
+    using detail::Glyph_vector::value_type;
+    using detail::Glyph_vector::allocator_type;
+    using detail::Glyph_vector::difference_type;
+    using detail::Glyph_vector::reference;
+    using detail::Glyph_vector::const_reference;
+    using detail::Glyph_vector::pointer;
+    using detail::Glyph_vector::const_pointer;
+    using detail::Glyph_vector::iterator;
+    using detail::Glyph_vector::const_iterator;
+    using detail::Glyph_vector::reverse_iterator;
+    using detail::Glyph_vector::const_reverse_iterator;
+
+    using detail::Glyph_vector::operator[];
+    using detail::Glyph_vector::size;
+    using detail::Glyph_vector::assign;
+    using detail::Glyph_vector::get_allocator;
+    using detail::Glyph_vector::at;
+    using detail::Glyph_vector::front;
+    using detail::Glyph_vector::back;
+    using detail::Glyph_vector::data;
+    using detail::Glyph_vector::begin;
+    using detail::Glyph_vector::cbegin;
+    using detail::Glyph_vector::end;
+    using detail::Glyph_vector::cend;
+    using detail::Glyph_vector::rbegin;
+    using detail::Glyph_vector::crbegin;
+    using detail::Glyph_vector::rend;
+    using detail::Glyph_vector::crend;
+    using detail::Glyph_vector::empty;
+    using detail::Glyph_vector::max_size;
+    using detail::Glyph_vector::reserve;
+    using detail::Glyph_vector::capacity;
+    using detail::Glyph_vector::shrink_to_fit;
+    using detail::Glyph_vector::emplace_back;
+    using detail::Glyph_vector::clear;
+    using detail::Glyph_vector::insert;
+    using detail::Glyph_vector::erase;
+    using detail::Glyph_vector::push_back;
+    using detail::Glyph_vector::pop_back;
+    using detail::Glyph_vector::resize;
+    using detail::Glyph_vector::swap;
 };
 
 // Traits ----------------------------------------------------------------------
@@ -0,0 +1,116 @@
+#ifndef TERMOX_PAINTER_GRAPHEME_HPP
+#define TERMOX_PAINTER_GRAPHEME_HPP
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace ox {
+
+/// Set on a Glyph::symbol that refers to an interned grapheme cluster.
+/** Unicode code points only use the low 21 bits, the remaining bits of a
+ *  cluster symbol are its index in the process wide cluster table. */
+inline constexpr auto grapheme_cluster_flag = char32_t{0x8000'0000};
+
+/// The most grapheme clusters the process wide cluster table holds.
+inline constexpr auto max_grapheme_clusters = std::size_t{1} << 16;
+
+/// Code points of a grapheme cluster beyond this are dropped when interned.
+inline constexpr auto max_grapheme_cluster_length = std::size_t{32};
+
+/// Return true if \p symbol refers to an interned grapheme cluster.
+[[nodiscard]] constexpr auto is_grapheme_cluster(char32_t symbol) -> bool
+{
+    return (symbol & grapheme_cluster_flag) != 0;
+}
+
+/// Return true if \p c continues the grapheme cluster before it.
+/** Covers combining marks of the common scripts, joiners, variation
+ *  selectors, emoji modifiers and tag characters. */
+[[nodiscard]] constexpr auto is_grapheme_extender(char32_t c) -> bool
+{
+    if (c < 0x0300)
+        return false;
+    auto const in = [c](char32_t first, char32_t last) {
+        return c >= first && c <= last;
+    };
+    return in(0x0300, 0x036F) || in(0x0483, 0x0489) || in(0x0591, 0x05BD) ||
+           c == 0x05BF || in(0x05C1, 0x05C2) || in(0x05C4, 0x05C5) ||
+           c == 0x05C7 || in(0x0610, 0x061A) || in(0x064B, 0x065F) ||
+           c == 0x0670 || in(0x06D6, 0x06DC) || in(0x06DF, 0x06E4) ||
+           in(0x06E7, 0x06E8) || in(0x06EA, 0x06ED) || in(0x0900, 0x0903) ||
+           in(0x093A, 0x094F) || in(0x0951, 0x0957) || in(0x0962, 0x0963) ||
+           c == 0x0E31 || in(0x0E34, 0x0E3A) || in(0x0E47, 0x0E4E) ||
+           in(0x1AB0, 0x1AFF) || in(0x1DC0, 0x1DFF) || in(0x200C, 0x200D) ||
+           in(0x20D0, 0x20FF) || in(0xFE00, 0xFE0F) || in(0xFE20, 0xFE2F) ||
+           in(0x1F3FB, 0x1F3FF) || in(0xE0020, 0xE007F) ||
+           in(0xE0100, 0xE01EF);
+}
+
+/// Return the index one past the grapheme cluster starting at \p at.
+/** A simplified form of the Unicode extended grapheme cluster rules: CR LF,
+ *  a code point followed by extenders, emoji joined by ZWJ, and pairs of
+ *  regional indicators (flags) are each one cluster. */
+[[nodiscard]] constexpr auto next_grapheme_boundary(std::u32string_view text,
+                                                    std::size_t at)
+    -> std::size_t
+{
+    auto constexpr zwj         = char32_t{0x200D};
+    auto const is_regional     = [](char32_t c) {
+        return c >= 0x1F1E6 && c <= 0x1F1FF;
+    };
+    auto const is_pictographic = [](char32_t c) {
+        return (c >= 0x2600 && c <= 0x27BF) || (c >= 0x1F000 && c <= 0x1FAFF);
+    };
+    auto const first = text[at++];
+    if (first == U'\r')
+        return (at < text.size() && text[at] == U'\n') ? at + 1 : at;
+    if (first < 0x20 || first == 0x7F)
+        return at;
+    if (is_regional(first) && at < text.size() && is_regional(text[at]))
+        ++at;
+    while (at < text.size()) {
+        if (text[at - 1] == zwj && is_pictographic(text[at]))
+            ++at;
+        else if (is_grapheme_extender(text[at]))
+            ++at;
+        else
+            break;
+    }
+    return at;
+}
+
+namespace detail {
+
+/// Add \p cluster to the cluster table if new, and return its symbol.
+[[nodiscard]] auto intern_grapheme_cluster(std::u32string_view cluster)
+    -> char32_t;
+
+}  // namespace detail
+
+/// Return the Glyph::symbol for the single grapheme cluster \p cluster.
+/** A lone code point is its own symbol, longer clusters are interned. Cluster
+ *  symbols are valid for the lifetime of the process and are shared by all
+ *  Sessions, equal clusters always have the same symbol. The value of a
+ *  cluster symbol depends on the order clusters were first interned in, so
+ *  compare or hash the grapheme_code_points() of a symbol when the result
+ *  must be reproducible across processes. At most max_grapheme_clusters are
+ *  interned, once the table is full a new cluster is returned as its first
+ *  code point, and only the first max_grapheme_cluster_length code points of
+ *  a cluster are kept. */
+[[nodiscard]] inline auto intern_grapheme(std::u32string_view cluster)
+    -> char32_t
+{
+    if (cluster.size() == 1)
+        return cluster.front();
+    return detail::intern_grapheme_cluster(cluster);
+}
+
+/// Return the code points that \p symbol stands for.
+/** Throws std::out_of_range if \p symbol is a cluster that was not interned. */
+[[nodiscard]] auto grapheme_code_points(char32_t symbol) -> std::u32string;
+
+/// Return \p symbol as a multi-byte string, expanding interned clusters.
+[[nodiscard]] auto grapheme_to_mb(char32_t symbol) -> std::string;
+
+}  // namespace ox
+#endif  // TERMOX_PAINTER_GRAPHEME_HPP
@@ -1,8 +1,11 @@
 #ifndef TERMOX_PAINTER_PAINTER_HPP
 #define TERMOX_PAINTER_PAINTER_HPP
+#include <cstddef>
+
 #include <termox/painter/brush.hpp>
 #include <termox/widget/area.hpp>
 #include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
 
 namespace ox {
 class Glyph_string;
@@ -17,10 +20,14 @@ class Canvas;
 namespace ox {
 
 /// Contains functions to paint Glyphs to a Widget's screen area.
-/** For use within Widget::paint_event(...), and virtual overrides. */
+/** For use within Widget::paint_event(...), and virtual overrides. Painting is
+ *  clipped to the Widget's damage region, see Widget::update(Rect), and to
+ *  the part of the Widget that is visible on the canvas. */
 class Painter {
    public:
     /// Construct an object ready to paint Glyphs from \p w to \p canvas.
+    /** Wallpaper fills the damage region of \p w, except for the region a
+     *  child paints over, see Widget::covered_region(). */
     Painter(Widget& w, detail::Canvas& canvas);
 
     Painter(Painter const&) = delete;
@@ -51,9 +58,22 @@ class Painter {
     /// Draw a vertical line from \p a to \p b, inclusive, in local coords.
     auto vline(Glyph tile, Point a, Point b) -> Painter&;
 
-    /// Fill the entire widget screen with wallpaper.
+    /// Fill the clip region with wallpaper, except the covered_region().
     auto wallpaper_fill() -> Painter&;
 
+    /// Return the region being repainted, in local coordinates.
+    /** Glyphs put outside of it are discarded and at() is unspecified there,
+     *  paint_event implementations can skip any work outside of it. */
+    [[nodiscard]] auto clip() const -> Rect;
+
+#ifdef TERMOX_PROFILER
+    /// Return the number of Glyphs written so far, including the wallpaper.
+    [[nodiscard]] auto cells_written() const -> std::size_t
+    {
+        return cells_written_;
+    }
+#endif
+
    private:
     /// Put a single Glyph to the canvas_ container.
     /** No bounds checking, used internally for all painting. Main entry point
@@ -77,7 +97,11 @@ class Painter {
    private:
     Widget const& widget_;
     detail::Canvas& canvas_;
-    Brush brush_;
+    Brush brush_;  // Widget::effective_brush(), resolved once per Painter.
+    Rect clip_;
+#ifdef TERMOX_PROFILER
+    std::size_t cells_written_ = 0;
+#endif
 };
 
 }  // namespace ox
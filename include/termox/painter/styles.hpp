@@ -0,0 +1,47 @@
+#ifndef TERMOX_PAINTER_STYLES_HPP
+#define TERMOX_PAINTER_STYLES_HPP
+#include <string>
+#include <unordered_map>
+
+#include <termox/painter/brush.hpp>
+
+namespace ox {
+
+/// Named Brushes that Widgets refer to by style class.
+/** A Widget's style is its style class' Brush merged over its parent's style,
+ *  so unset Colors and all Traits are inherited along the Widget tree. See
+ *  Widget::set_style_class(). Changing a style class resolves the style of
+ *  every Widget again and repaints only those whose Brush changed. Undefined
+ *  style classes have an empty Brush. */
+class Styles {
+   public:
+    using Map_t = std::unordered_map<std::string, Brush>;
+
+    /// Style classes owned by each Session.
+    struct State {
+        Map_t classes;
+    };
+
+   public:
+    /// Define or replace the style class \p name.
+    static void set(std::string const& name, Brush b);
+
+    /// Remove the style class \p name, no-op if it is not defined.
+    static void remove(std::string const& name);
+
+    /// Replace all style classes at once, for switching themes.
+    static void set_theme(Map_t classes);
+
+    /// Return the Brush of style class \p name, or Brush{} if not defined.
+    [[nodiscard]] static auto get(std::string const& name) -> Brush;
+
+   private:
+    /// Return the State of the current Session.
+    [[nodiscard]] static auto state() -> State&;
+
+    /// Resolve the style of the head Widget's tree and each overlay again.
+    static void restyle_all();
+};
+
+}  // namespace ox
+#endif  // TERMOX_PAINTER_STYLES_HPP
@@ -1,8 +1,13 @@
 #ifndef TERMOX_SYSTEM_ANIMATION_ENGINE_HPP
 #define TERMOX_SYSTEM_ANIMATION_ENGINE_HPP
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <vector>
 
+#include <termox/common/fps.hpp>
 #include <termox/common/lockable.hpp>
 #include <termox/common/timer.hpp>
 #include <termox/system/event_loop.hpp>
@@ -12,6 +17,8 @@ namespace ox {
 class Widget;
 
 /// Registers Widgets with intervals to send timer events.
+/** Also calls scheduled functions from its loop, these are what resume the
+ *  coroutines of task.hpp. */
 class Animation_engine : private Lockable<std::recursive_mutex> {
    public:
     using Clock_t    = Timer::Clock_t;
@@ -21,9 +28,20 @@ class Animation_engine : private Lockable<std::recursive_mutex> {
     struct Registered_data {
         Duration_t interval;
         Time_point last_event_time;
+        Time_point next_deadline;
     };
 
-    static auto constexpr default_interval = Duration_t{100};
+    static auto constexpr default_interval =
+        Duration_t{std::chrono::milliseconds{100}};
+
+    /// Time per frame after which remaining Timer_events wait a frame.
+    static auto constexpr frame_budget = Event_queue::Budget_t{8'000};
+
+    /// Stale ticks are coalesced and no new frame is started while lagging.
+    static auto constexpr backpressure = Backpressure{4'096, true, true, true};
+
+    /// Minimum time between the frames of schedule_frame(), 60 FPS.
+    static auto constexpr frame_period = fps_to_period<Duration_t>(FPS{60});
 
    public:
     /// Register to start sending Timer_events to \p w every \p interval.
@@ -35,9 +53,27 @@ class Animation_engine : private Lockable<std::recursive_mutex> {
     /// Stop the given Widget from being sent Timer_events.
     void unregister_widget(Widget& w);
 
+    /// Stop sending Timer_events to \p w, keeping its interval for resume.
+    /** No-op if \p w is not registered. */
+    void suspend_widget(Widget& w);
+
+    /// Resume sending Timer_events to \p w, if it was suspended.
+    void resume_widget(Widget& w);
+
     /// Return true if there are no registered widgets
     [[nodiscard]] auto is_empty() const -> bool;
 
+    /// Call \p f from this engine's loop once \p when has passed.
+    /** Callable from any thread, does not start the engine. Every function
+     *  that is due on a frame is called, in order of \p when, from a single
+     *  Custom_event. */
+    void schedule(Time_point when, std::function<void()> f);
+
+    /// Call \p f from this engine's loop on its next frame.
+    /** Callable from any thread, does not start the engine. Frames are at
+     *  least frame_period apart. */
+    void schedule_frame(std::function<void()> f);
+
     /// Start another thread that waits on intervals and sents timer events.
     void start();
 
@@ -47,15 +83,32 @@ class Animation_engine : private Lockable<std::recursive_mutex> {
     /// Return true if start() has been called, and hasn't been exited.
     [[nodiscard]] auto is_running() const -> bool;
 
+    /// Return how many Timer_events and frames have been shed so far.
+    [[nodiscard]] auto shed_counts() const -> Shed_counts;
+
    private:
     std::map<Widget*, Registered_data> subjects_;
+    std::map<Widget*, Registered_data> suspended_;
     Event_loop loop_;
     Timer timer_ = Timer{default_interval};
+    std::vector<Timer_event> timer_events_;
+    std::multimap<Time_point, std::function<void()>> scheduled_;
+    std::vector<std::function<void()>> due_;
+    Time_point last_frame_ = {};
+
+    // Cuts the wait between frames short, for schedule() and stop().
+    std::mutex wake_mtx_;
+    std::condition_variable wake_cv_;
+    bool wake_ = false;
 
    private:
     /// Post any Timer_events that are ready to be posted.
+    /** Also moves any scheduled functions that are due into due_. */
     auto get_timer_events() -> std::vector<Timer_event>&;
 
+    /// Wake the loop if it is waiting for its next frame.
+    void wake();
+
     /// Waits on intervals then sends Timer_events.
     void loop_function(Event_queue& queue);
 };
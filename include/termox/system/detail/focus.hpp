@@ -8,6 +8,14 @@ class Widget;
 namespace ox::detail {
 
 class Focus {
+   public:
+    /// Focus state owned by each Session.
+    struct State {
+        ox::Widget* focus_widget = nullptr;
+        bool tab_enabled         = true;
+        bool tab_suppressed      = false;
+    };
+
    public:
     /// Return a pointer to the currently focused Widget, can return nullptr.
     [[nodiscard]] static auto focus_widget() -> ox::Widget*;
@@ -45,9 +53,8 @@ class Focus {
     static void unsuppress_tab();
 
    private:
-    static ox::Widget* focus_widget_;
-    static bool tab_enabled_;
-    static bool tab_suppressed_;
+    /// Return the State of the current Session.
+    [[nodiscard]] static auto state() -> State&;
 };
 
 }  // namespace ox::detail
@@ -9,6 +9,7 @@
 
 #include <esc/event.hpp>
 
+#include <termox/common/timer.hpp>
 #include <termox/painter/color.hpp>
 #include <termox/system/key.hpp>
 #include <termox/system/mouse.hpp>
@@ -101,6 +102,7 @@ struct Resize_event {
 
 struct Timer_event {
     Widget_ref receiver;
+    Frame_time time = {};
 };
 
 struct Dynamic_color_event {
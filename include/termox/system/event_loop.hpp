@@ -6,6 +6,7 @@
 #include <utility>
 
 #include <termox/system/event_queue.hpp>
+#include <termox/system/session_scope.hpp>
 
 namespace ox {
 
@@ -38,15 +39,18 @@ class Event_loop {
 
     /// Start the event loop in a separate thread.
     /** loop_function should have signature: void(Event_queue&). It should
-        probably append an Event to the provided queue. */
+        probably append an Event to the provided queue. The new thread belongs
+        to the Session of the calling thread. */
     template <typename F>
     void run_async(F&& loop_function)
     {
         if (fut_.valid())
             return;
-        fut_ = std::async(std::launch::async, [this, loop_function] {
-            return this->run(std::move(loop_function));
-        });
+        fut_ = std::async(std::launch::async,
+                          [this, loop_function, s = Session_scope::get()] {
+                              auto const scope = Session_scope{s};
+                              return this->run(std::move(loop_function));
+                          });
         assert(fut_.valid());
     }
 
@@ -0,0 +1,149 @@
+#ifndef TERMOX_SYSTEM_INPUT_RECORDING_HPP
+#define TERMOX_SYSTEM_INPUT_RECORDING_HPP
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <esc/event.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/widget/area.hpp>
+
+namespace ox {
+class Widget;
+
+/// A single input event and when it was read, relative to the recording start.
+struct Input_record {
+    std::chrono::microseconds offset;
+    esc::Event event;
+};
+
+/// Writes every input event read by a Session to a compact binary file.
+/** Attaches to the current Session on construction and detaches on
+ *  destruction. Events are recorded as they come out of the terminal, before
+ *  they are turned into ox::Events, along with a steady_clock timestamp. Each
+ *  record is a varint encoded time delta, a tag byte and the varint encoded
+ *  fields of the event, typically 3 to 8 bytes. Events generated by the
+ *  Animation_engine and Dynamic_color_engine are not recorded, they are
+ *  driven by the clock and are regenerated when replayed at recorded speed. */
+class Input_recorder {
+   public:
+    /// Open \p path for writing and start recording the current Session.
+    /** Throws std::runtime_error if \p path cannot be opened. */
+    explicit Input_recorder(std::string const& path);
+
+    Input_recorder(Input_recorder const&) = delete;
+    Input_recorder& operator=(Input_recorder const&) = delete;
+
+    /// Stop recording and flush the file.
+    ~Input_recorder();
+
+   public:
+    /// Append \p event to the recording, timestamped with the current time.
+    /** Called by the Session on its own thread for each event read. */
+    void record(esc::Event const& event);
+
+    /// Return the number of events recorded so far.
+    [[nodiscard]] auto size() const -> std::size_t;
+
+   private:
+    using Clock_t = std::chrono::steady_clock;
+
+    Session& session_;
+    std::ofstream file_;
+    Clock_t::time_point last_ = Clock_t::now();
+    std::size_t size_         = 0;
+    std::string buffer_;
+};
+
+/// How fast Input_replay feeds recorded events to its Session.
+/** Recorded:    Each event is read at the offset it was recorded at.
+ *  Unthrottled: Each event is read as soon as the previous one is processed. */
+enum class Replay_speed { Recorded, Unthrottled };
+
+/// Results of an Input_replay run, for comparing performance between builds.
+struct Replay_report {
+    /// Time spent processing each event, including painting the result.
+    /** The first entry is the initial paint, before any input. */
+    std::vector<std::chrono::nanoseconds> frame_times;
+
+    /// Number of bytes that would have been written to the terminal.
+    std::size_t bytes_written = 0;
+
+    /// screen_hash() of the terminal screen after the last event.
+    std::uint64_t screen_hash = 0;
+
+    /// Wall clock time of the entire replay.
+    std::chrono::nanoseconds total_time{0};
+};
+
+/// Replays a file written by Input_recorder into a headless Session.
+/** The Session has no terminal, output is counted and discarded, see
+ *  Session_backend. After the last recorded event the Session exits and a
+ *  Replay_report is returned. With Replay_speed::Unthrottled, replays of
+ *  applications that only change on input are deterministic, so equal
+ *  screen_hash values mean equal final screens. */
+class Input_replay {
+   public:
+    /// Load the recording at \p path.
+    /** Throws std::runtime_error if \p path cannot be read or is malformed. */
+    explicit Input_replay(std::string const& path);
+
+   public:
+    /// Construct a Widget_t head in a new headless Session and replay into it.
+    /** \p area is the screen size of the Session; a recorded Window_resize
+     *  changes it as it would have on the recorded terminal. \p args... are
+     *  passed on to the Widget_t constructor, which runs with the new Session
+     *  current. */
+    template <typename Widget_t, typename... Args>
+    auto run(Replay_speed speed, Area area, Args&&... args) -> Replay_report
+    {
+        auto session     = Session{this->backend(speed, area)};
+        auto const scope = Session_scope{&session};
+        auto head        = Widget_t(std::forward<Args>(args)...);
+        return this->run(session, head);
+    }
+
+    /// Return the loaded records, in the order they were recorded.
+    [[nodiscard]] auto records() const -> std::vector<Input_record> const&;
+
+   private:
+    using Clock_t = std::chrono::steady_clock;
+
+    std::vector<Input_record> records_;
+
+    // State of the current run.
+    std::size_t next_ = 0;
+    Area area_;
+    Replay_speed speed_ = Replay_speed::Unthrottled;
+    Clock_t::time_point start_;
+    Clock_t::time_point frame_start_;
+    std::vector<std::chrono::nanoseconds> frame_times_;
+    std::size_t bytes_written_ = 0;
+    std::uint64_t screen_hash_ = 0;
+
+   private:
+    /// Return a headless backend that reads from records_.
+    [[nodiscard]] auto backend(Replay_speed speed, Area area)
+        -> Session_backend;
+
+    /// Return the next recorded event, blocks if replaying at recorded speed.
+    [[nodiscard]] auto read() -> esc::Event;
+
+    /// Run \p session with \p head until records_ are exhausted.
+    auto run(Session& session, Widget& head) -> Replay_report;
+};
+
+/// Return a 64 bit FNV-1a hash of the symbols and Brushes of \p screen.
+/** Interned grapheme clusters are hashed by their code points, so the hash
+ *  does not depend on the order clusters were interned in. */
+[[nodiscard]] auto screen_hash(detail::Canvas const& screen) -> std::uint64_t;
+
+}  // namespace ox
+#endif  // TERMOX_SYSTEM_INPUT_RECORDING_HPP
@@ -0,0 +1,195 @@
+#ifndef TERMOX_SYSTEM_PROFILER_HPP
+#define TERMOX_SYSTEM_PROFILER_HPP
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <termox/painter/painter.hpp>
+#include <termox/system/event.hpp>
+
+namespace ox {
+
+/// Per Widget and per Event type cost of event handling.
+/** Opt-in at build time, configure with -DTERMOX_PROFILER=ON. Otherwise the
+ *  hooks in System::send_event and Painter compile to nothing and every query
+ *  below returns empty results. Time is measured around filter_send() and
+ *  send() for each Event, so it includes the time of Events sent from within
+ *  a handler. Cells are counted for Paint_events, as every Glyph written by
+ *  the Painter, including the wallpaper fill and paints by event filters.
+ *  Data is kept per Session, query it from an event handler or after the
+ *  Session has stopped running. */
+class Profiler {
+   public:
+    using Clock_t = std::chrono::steady_clock;
+
+    /// Accumulated cost of one Event type sent to one Widget.
+    struct Entry {
+        int widget_id;  // -1 for Events without a receiver.
+        std::string widget_name;
+        std::string event;
+        std::size_t count = 0;
+        std::chrono::nanoseconds total{0};
+        std::chrono::nanoseconds max{0};
+        std::size_t cells = 0;
+    };
+
+    /// A single sent Event, for the Chrome trace export.
+    struct Span {
+        int widget_id;
+        std::uint8_t event;
+        std::uint32_t thread;
+        Clock_t::time_point begin;
+        std::chrono::nanoseconds duration;
+        std::size_t cells;
+    };
+
+    /// Profile data owned by each Session.
+    struct State {
+        std::map<std::pair<int, std::uint8_t>, Entry> entries;
+        std::vector<Span> spans;
+        Clock_t::time_point epoch = Clock_t::now();
+        std::size_t pending_cells = 0;
+        bool overlay              = false;
+    };
+
+    /// Spans past this count are dropped, the Entry totals are still updated.
+    static auto constexpr max_spans = std::size_t{1'000'000};
+
+   public:
+    /// Return true if the library was built with TERMOX_PROFILER.
+    [[nodiscard]] static auto is_compiled_in() -> bool;
+
+    /// Return every Entry, most expensive total time first.
+    [[nodiscard]] static auto entries() -> std::vector<Entry>;
+
+    /// Write entries() as a fixed width table, one Entry per line.
+    static void write_report(std::ostream& os);
+
+    /// Write every Span as Chrome trace-event JSON.
+    /** Open the file with chrome://tracing or https://ui.perfetto.dev. */
+    static void write_chrome_trace(std::ostream& os);
+
+    /// Discard all recorded data.
+    static void clear();
+
+    /// Heat-color the background of each Widget by its total paint time.
+    /** Painted over the composited frame just before it is written, so the
+     *  heat colors never reach the saved base layer beneath overlays. Turning
+     *  it off repaints every Widget. */
+    static void show_overlay(bool show = true);
+
+    /// Return true if the overlay is currently shown.
+    [[nodiscard]] static auto is_overlay_shown() -> bool;
+
+   public:
+    /// Record one Event sent to Widget \p id with \p name.
+    /** Used by detail::profile(), \p event is the index into ox::Event. */
+    static void record(int id,
+                       std::string const& name,
+                       std::uint8_t event,
+                       Clock_t::time_point begin,
+                       std::chrono::nanoseconds duration,
+                       std::size_t cells);
+
+    /// Paint the overlay onto the next screen buffer of the current Session.
+    static void paint_overlay();
+
+    /// Return the State of the current Session.
+    [[nodiscard]] static auto state() -> State&;
+};
+
+}  // namespace ox
+
+namespace ox::detail {
+
+/// Index of the alternative \p T in std::variant \p V.
+template <typename T, typename V>
+struct Variant_index;
+
+template <typename T, typename... Ts>
+struct Variant_index<T, std::variant<Ts...>> {
+    static auto constexpr value = [] {
+        auto i = std::size_t{0};
+        ((std::is_same_v<T, Ts> ? true : (++i, false)) || ...);
+        return i;
+    }();
+};
+
+/// Return the Widget an Event is sent to, or nullptr if there is none.
+template <typename Event_t>
+[[nodiscard]] auto receiver_of(Event_t const& e) -> Widget const*
+{
+    if constexpr (std::is_same_v<Event_t, Delete_event>)
+        return e.removed.get();
+    else if constexpr (std::is_same_v<Event_t, Key_press_event> ||
+                       std::is_same_v<Event_t, Key_release_event>) {
+        return e.receiver ? &e.receiver->get() : nullptr;
+    }
+    else if constexpr (std::is_same_v<Event_t, Dynamic_color_event> ||
+                       std::is_same_v<Event_t, ::esc::Window_resize> ||
+                       std::is_same_v<Event_t, Custom_event>) {
+        return nullptr;
+    }
+    else
+        return &e.receiver.get();
+}
+
+/// Call \p send, recording its cost for \p e with TERMOX_PROFILER defined.
+/** \p e is an ox::Event or one of its alternatives. It is inspected before
+ *  \p send is called, as a Delete_event destroys its Widget. */
+template <typename Event_t, typename F>
+void profile([[maybe_unused]] Event_t const& e, F&& send)
+{
+#ifdef TERMOX_PROFILER
+    auto const* receiver = [&] {
+        if constexpr (std::is_same_v<Event_t, Event>)
+            return std::visit([](auto const& x) { return receiver_of(x); }, e);
+        else
+            return receiver_of(e);
+    }();
+    auto const index = [&] {
+        if constexpr (std::is_same_v<Event_t, Event>)
+            return e.index();
+        else
+            return Variant_index<Event_t, Event>::value;
+    }();
+    auto const id    = receiver == nullptr ? -1 : int{receiver->unique_id()};
+    auto const name  = receiver == nullptr ? std::string{} : receiver->name();
+    auto& state      = Profiler::state();
+    auto const outer = std::exchange(state.pending_cells, 0);
+    auto const begin = Profiler::Clock_t::now();
+    send();
+    auto const end = Profiler::Clock_t::now();
+    Profiler::record(id, name, static_cast<std::uint8_t>(index), begin,
+                     end - begin, std::exchange(state.pending_cells, outer));
+#else
+    send();
+#endif
+}
+
+/// Add the cells written by \p p to the Event currently being profiled.
+inline void profile_cells([[maybe_unused]] Painter const& p)
+{
+#ifdef TERMOX_PROFILER
+    Profiler::state().pending_cells += p.cells_written();
+#endif
+}
+
+/// Paint the Profiler overlay if it is shown, called after each compose().
+inline void profile_overlay()
+{
+#ifdef TERMOX_PROFILER
+    if (Profiler::state().overlay)
+        Profiler::paint_overlay();
+#endif
+}
+
+}  // namespace ox::detail
+#endif  // TERMOX_SYSTEM_PROFILER_HPP
@@ -0,0 +1,175 @@
+#ifndef TERMOX_SYSTEM_SESSION_HPP
+#define TERMOX_SYSTEM_SESSION_HPP
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <esc/event.hpp>
+#include <signals_light/signal.hpp>
+
+#include <termox/common/lockable.hpp>
+#include <termox/painter/color.hpp>
+#include <termox/painter/styles.hpp>
+#include <termox/system/animation_engine.hpp>
+#include <termox/system/detail/focus.hpp>
+#include <termox/system/detail/user_input_event_loop.hpp>
+#include <termox/system/event.hpp>
+#include <termox/system/profiler.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/system/shortcuts.hpp>
+#include <termox/terminal/detail/color_tables.hpp>
+#include <termox/terminal/detail/screen_buffers.hpp>
+#include <termox/terminal/dynamic_color_engine.hpp>
+#include <termox/terminal/dynamic_color_mode.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/detail/widget_index.hpp>
+
+namespace ox {
+class Widget;
+class Event_queue;
+class Input_recorder;
+class System;
+class Terminal;
+}  // namespace ox
+
+namespace ox {
+
+/// The terminal a Session reads input from and writes output to.
+/** The default is the process' stdin and stdout, through the esc library. Any
+ *  other output_fd, such as the master side of a pty, is written to directly
+ *  and its window size is read with TIOCGWINSZ. The owner of a non-default
+ *  terminal is responsible for its termios settings, and must provide read,
+ *  which blocks until the next input event from that terminal. read is called
+ *  on the Session's thread, it defaults to esc::read().
+ *
+ *  An output_fd of -1 is headless: output is counted and discarded, and the
+ *  screen has the fixed size headless_area. Used to replay recorded input. */
+struct Session_backend {
+    int output_fd                    = 1;
+    std::function<esc::Event()> read = nullptr;
+    Area headless_area               = {80, 24};
+};
+
+/// An independent TUI: head Widget, focus, Event_queues, screen and colors.
+/** Many Sessions can run in one process, each on its own thread, for instance
+ *  one per connected pty. The static System, Terminal and Shortcuts functions
+ *  operate on the current Session of the calling thread, which is the default
+ *  Session unless a Session_scope has selected another. Threads started by a
+ *  Session's Event_loops inherit its scope. */
+class Session : private Lockable<std::mutex> {
+   public:
+    explicit Session(Session_backend backend = {});
+
+    Session(Session const&) = delete;
+    Session& operator=(Session const&) = delete;
+
+   public:
+    /// Run the user input loop with \p head on the calling thread.
+    /** Blocks until exit() is called, returns the exit code. Makes this the
+     *  current Session of the calling thread for the duration. */
+    auto run(Widget& head) -> int;
+
+    /// Construct a Widget_t head on a new thread and run() with it.
+    /** \p args... are copied to the new thread and passed on to the Widget_t
+     *  constructor. Use wait() to retrieve the exit code. */
+    template <typename Widget_t, typename... Args>
+    void run_async(Args... args)
+    {
+        if (fut_.valid())
+            return;
+        fut_ = std::async(std::launch::async, [this, args...]() mutable {
+            auto const scope = Session_scope{this};
+            auto head        = Widget_t(std::move(args)...);
+            return this->run(head);
+        });
+    }
+
+    /// Set the exit flag of the user input loop.
+    /** run() returns once the Event being processed has been handled, or after
+     *  the next input if called from another thread. */
+    void exit(int exit_code);
+
+    /// Block until a Session started with run_async() returns its exit code.
+    auto wait() -> int;
+
+    /// Return true if this is the Session used by the static API by default.
+    [[nodiscard]] auto is_default() const -> bool;
+
+    /// Return the number of bytes written to the terminal so far.
+    [[nodiscard]] auto bytes_written() const -> std::size_t;
+
+   public:
+    /// Return the current Session of the calling thread.
+    [[nodiscard]] static auto current() -> Session&;
+
+    /// Return the process' default Session, on stdin and stdout.
+    [[nodiscard]] static auto default_session() -> Session&;
+
+   private:
+    Session_backend backend_;
+    std::string output_;
+    std::future<int> fut_;
+    std::atomic<std::size_t> bytes_written_      = 0;
+    std::atomic<Input_recorder*> input_recorder_ = nullptr;
+
+    // System
+    std::atomic<Widget*> head_ = nullptr;
+    detail::User_input_event_loop user_input_loop_;
+    Animation_engine animation_engine_;
+    std::reference_wrapper<Event_queue> current_queue_;
+    detail::Focus::State focus_;
+    Shortcuts::State shortcuts_;
+    Profiler::State profiler_;
+    Styles::State styles_;
+    detail::Widget_index::State widget_index_;
+
+    // Terminal
+    detail::Screen_buffers screen_buffers_{Area{0, 0}};
+    Palette palette_;
+    detail::Color_tables colors_;
+    Dynamic_color_engine dynamic_color_engine_;
+    Dynamic_color_mode dynamic_color_mode_ = Dynamic_color_mode::Repaint;
+    sl::Signal<void(Palette const&)> palette_changed_;
+    bool is_initialized_  = false;
+    bool full_repaint_    = false;
+    bool dithering_       = false;
+    bool run_compression_ = false;
+
+   private:
+    /// Return true if this Session writes to the process' stdout.
+    [[nodiscard]] auto is_stdio() const -> bool;
+
+    /// Return true if this Session discards its output, see Session_backend.
+    [[nodiscard]] auto is_headless() const -> bool;
+
+    /// Stage \p bytes to be written to the terminal on the next flush().
+    void write(std::string_view bytes);
+
+    /// Write all staged bytes to the terminal.
+    void flush();
+
+    /// Return the dimensions of the terminal.
+    [[nodiscard]] auto area() const -> Area;
+
+    /// Block until the next input event from the terminal.
+    /** The event is passed to the attached Input_recorder, if any. */
+    [[nodiscard]] auto read() -> esc::Event;
+
+    friend class System;
+    friend class Terminal;
+    friend class Shortcuts;
+    friend class Event_queue;
+    friend class detail::Focus;
+    friend class Input_recorder;
+    friend class Profiler;
+    friend class Styles;
+    friend class detail::Widget_index;
+};
+
+}  // namespace ox
+#endif  // TERMOX_SYSTEM_SESSION_HPP
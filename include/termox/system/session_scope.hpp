@@ -0,0 +1,32 @@
+#ifndef TERMOX_SYSTEM_SESSION_SCOPE_HPP
+#define TERMOX_SYSTEM_SESSION_SCOPE_HPP
+
+namespace ox {
+class Session;
+
+/// Makes a Session the current Session of the calling thread for its lifetime.
+/** The previously current Session is restored on destruction, so scopes can
+ *  be nested. Constructing with nullptr selects the default Session. */
+class Session_scope {
+   public:
+    explicit Session_scope(Session* session) : previous_{current_}
+    {
+        current_ = session;
+    }
+
+    Session_scope(Session_scope const&) = delete;
+    Session_scope& operator=(Session_scope const&) = delete;
+
+    ~Session_scope() { current_ = previous_; }
+
+   public:
+    /// Return the Session of the calling thread, or nullptr for the default.
+    [[nodiscard]] static auto get() -> Session* { return current_; }
+
+   private:
+    Session* previous_;
+    inline static thread_local Session* current_ = nullptr;
+};
+
+}  // namespace ox
+#endif  // TERMOX_SYSTEM_SESSION_SCOPE_HPP
@@ -10,6 +10,16 @@ namespace ox {
 
 /// Provides functions for defining global keyboard shortcuts.
 class Shortcuts {
+   private:
+    using Map_t = std::unordered_map<Key, sl::Signal<void()>>;
+
+   public:
+    /// Shortcuts owned by each Session.
+    struct State {
+        Map_t shortcuts;
+        bool enabled = true;
+    };
+
    public:
     /// Add an entry for the \p key, returning a Signal to connect an action to.
     /** Key has combined key presses defined for multi-key shortcuts. The
@@ -35,9 +45,8 @@ class Shortcuts {
     static void enable_all();
 
    private:
-    using Map_t = std::unordered_map<Key, sl::Signal<void()>>;
-    inline static Map_t shortcuts_;
-    inline static bool enabled_ = true;
+    /// Return the State of the current Session.
+    [[nodiscard]] static auto state() -> State&;
 };
 
 }  // namespace ox
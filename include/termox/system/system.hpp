@@ -1,18 +1,16 @@
 #ifndef TERMOX_SYSTEM_SYSTEM_HPP
 #define TERMOX_SYSTEM_SYSTEM_HPP
-#include <atomic>
-#include <functional>
 #include <utility>
 
 #include <signals_light/signal.hpp>
 
 #include <termox/system/animation_engine.hpp>
-#include <termox/system/detail/user_input_event_loop.hpp>
 #include <termox/system/event_fwd.hpp>
 #include <termox/terminal/key_mode.hpp>
 #include <termox/terminal/mouse_mode.hpp>
 #include <termox/terminal/signals.hpp>
 #include <termox/widget/cursor.hpp>
+#include <termox/widget/rect.hpp>
 
 namespace ox {
 class Widget;
@@ -23,7 +21,9 @@ namespace ox {
 
 /// Organizes the highest level of the TUI framework.
 /** Constructing an instance of this class initializes the display system.
- *  Manages the head Widget and the main User_input_event_loop. */
+ *  Manages the head Widget and the main User_input_event_loop. The static
+ *  functions operate on the current Session of the calling thread, which is
+ *  the default Session unless another is selected, see Session. */
 class System {
    public:
     static sl::Slot<void()> quit;
@@ -92,6 +92,19 @@ class System {
      *  on the screen. */
     [[nodiscard]] static auto head() -> Widget*;
 
+    /// Show \p w above the head Widget's tree, at \p region of the screen.
+    /** \p w is enabled, moved and resized to \p region, and paints into its
+     *  own layer. Overlays with a higher \p z are drawn above lower ones.
+     *  Mouse Events within \p region go to \p w. Calling again with the same
+     *  \p w moves it. \p w is not owned, it must not be a descendant of head
+     *  and must be hidden before it is destroyed. */
+    static void show_overlay(Widget& w, Rect region, int z = 0);
+
+    /// Disable \p w and remove it from the overlay layers.
+    /** The cells beneath \p w are restored from the saved layers below it,
+     *  no Paint_events are sent to the Widgets underneath. */
+    static void hide_overlay(Widget& w);
+
     /// Create a Widget_t object, set it as head widget and call System::run().
     /** \p args... are passed on to the Widget_t constructor. Blocks until
      *  System::exit() is called, returns the exit code. Will throw a
@@ -135,7 +148,8 @@ class System {
     /// Sets the exit flag for the user input event loop.
     /** Only call from the main user input event loop, not animation loop. This
      *  is because shutdown will be blocked until more user input is entered.
-     *  This calls std::_Exit, does not clean up with destructors.
+     *  This calls std::_Exit, does not clean up with destructors. The quit
+     *  Slot only ends the current Session if it is not the default Session.
      *  TODO threading design makes this difficult to do properly. */
     [[noreturn]] static void exit();
 
@@ -152,18 +166,26 @@ class System {
     /** Does not stop the animation_engine, even if its empty. */
     static void disable_animation(Widget& w);
 
+    /// Stop Timer_events to \p w until resume_animation(w), if animated.
+    /** \p w stays animated, and keeps its interval, while suspended. */
+    static void suspend_animation(Widget& w);
+
+    /// Resume Timer_events to \p w, if suspended by suspend_animation(w).
+    static void resume_animation(Widget& w);
+
+    /// Return the Timer_events and frames shed by the animation engine.
+    [[nodiscard]] static auto animation_shed_counts() -> Shed_counts;
+
+    /// Return the animation engine of the current Session.
+    /** Used by the awaitables of task.hpp to schedule coroutines. */
+    [[nodiscard]] static auto animation_engine() -> Animation_engine&;
+
     /// Set the terminal cursor via \p cursor parameters and \p offset applied.
     static void set_cursor(Cursor cursor, Point offset);
 
     /// Set the Event_queue that will be used by post_event.
     /** Set by Event_queue::send_all. */
     static void set_current_queue(Event_queue& queue);
-
-   private:
-    inline static std::atomic<Widget*> head_ = nullptr;
-    static detail::User_input_event_loop user_input_loop_;
-    static Animation_engine animation_engine_;
-    static std::reference_wrapper<Event_queue> current_queue_;
 };
 
 }  // namespace ox
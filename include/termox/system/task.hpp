@@ -0,0 +1,333 @@
+#ifndef TERMOX_SYSTEM_TASK_HPP
+#define TERMOX_SYSTEM_TASK_HPP
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#    error "termox/system/task.hpp requires C++20 coroutines."
+#endif
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <signals_light/signal.hpp>
+
+#include <termox/common/timer.hpp>
+#include <termox/common/worker_pool.hpp>
+#include <termox/system/animation_engine.hpp>
+#include <termox/system/event.hpp>
+#include <termox/system/system.hpp>
+
+// The library itself is C++17, this header is only usable from C++20 code.
+
+namespace ox {
+
+/// Coroutine that runs on the event loops of the current Session.
+/** Starts running when called, on the calling thread, which should be one of
+ *  the Session's event loops. It is resumed by the Animation_engine's loop
+ *  after next_frame() and sleep_for(), by the emitting loop after on(), and
+ *  by the Animation_engine's loop after a Worker_pool finishes its work. All
+ *  of these hold the Session lock, so a Task can touch Widgets freely.
+ *
+ *  Awaiting a Task from another Task resumes the awaiting one when it is done,
+ *  rethrowing any exception. A Task that is destroyed before it is done keeps
+ *  running and cleans itself up, exceptions it throws afterwards are rethrown
+ *  from a posted Custom_event. Tasks that are suspended when their Session
+ *  exits are never resumed. */
+class Task {
+   public:
+    class promise_type {
+       public:
+        [[nodiscard]] auto get_return_object() -> Task
+        {
+            return Task{Handle_t::from_promise(*this)};
+        }
+
+        [[nodiscard]] auto initial_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+
+        [[nodiscard]] auto final_suspend() noexcept -> auto
+        {
+            struct Final_awaiter {
+                [[nodiscard]] auto await_ready() noexcept -> bool
+                {
+                    return false;
+                }
+
+                [[nodiscard]] auto await_suspend(Handle_t h) noexcept
+                    -> std::coroutine_handle<>
+                {
+                    auto& p = h.promise();
+                    if (p.continuation_)
+                        return p.continuation_;
+                    if (p.is_detached_) {
+                        auto const e = p.exception_;
+                        h.destroy();
+                        if (e != nullptr) {
+                            System::post_event(Custom_event{
+                                [e] { std::rethrow_exception(e); }});
+                        }
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept {}
+            };
+            return Final_awaiter{};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() { exception_ = std::current_exception(); }
+
+       private:
+        std::coroutine_handle<> continuation_ = nullptr;
+        std::exception_ptr exception_         = nullptr;
+        bool is_detached_                     = false;
+
+        friend class Task;
+    };
+
+   public:
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    Task(Task&& other) noexcept : handle_{std::exchange(other.handle_, nullptr)}
+    {}
+
+    Task& operator=(Task&& other) noexcept
+    {
+        if (this != &other) {
+            this->release();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    /// Destroys a finished coroutine, otherwise detaches from it.
+    ~Task() { this->release(); }
+
+   public:
+    /// Return true if the coroutine has returned, or has thrown.
+    [[nodiscard]] auto is_done() const -> bool
+    {
+        return handle_ == nullptr || handle_.done();
+    }
+
+   public:
+    [[nodiscard]] auto await_ready() const noexcept -> bool
+    {
+        return this->is_done();
+    }
+
+    void await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+        handle_.promise().continuation_ = awaiting;
+    }
+
+    void await_resume() const
+    {
+        if (handle_ != nullptr && handle_.promise().exception_ != nullptr)
+            std::rethrow_exception(handle_.promise().exception_);
+    }
+
+   private:
+    using Handle_t = std::coroutine_handle<promise_type>;
+
+    Handle_t handle_;
+
+   private:
+    explicit Task(Handle_t h) : handle_{h} {}
+
+    void release()
+    {
+        if (handle_ == nullptr)
+            return;
+        if (handle_.done())
+            handle_.destroy();
+        else
+            handle_.promise().is_detached_ = true;
+        handle_ = nullptr;
+    }
+};
+
+namespace detail {
+
+/// Return the current Session's Animation_engine, starting it if needed.
+[[nodiscard]] inline auto started_animation_engine() -> Animation_engine&
+{
+    auto& engine = System::animation_engine();
+    if (!engine.is_running())
+        engine.start();
+    return engine;
+}
+
+/// Awaiter that resumes from the Animation_engine's loop at a time point.
+class Resume_at {
+   public:
+    explicit Resume_at(std::optional<Timer::Time_point> when) : when_{when} {}
+
+   public:
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> h) const
+    {
+        auto& engine = started_animation_engine();
+        if (when_.has_value())
+            engine.schedule(*when_, [h] { h.resume(); });
+        else
+            engine.schedule_frame([h] { h.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+   private:
+    std::optional<Timer::Time_point> when_;
+};
+
+/// Awaiter that resumes after the next emission of a Signal.
+/** Resumes with nothing, the single argument, or a std::tuple of arguments. */
+template <typename... Args>
+class Resume_on {
+   public:
+    using Signal_t = sl::Signal<void(Args...)>;
+    using Args_t   = std::tuple<std::decay_t<Args>...>;
+    using Result_t = std::conditional_t<
+        sizeof...(Args) == 0,
+        void,
+        std::conditional_t<
+            sizeof...(Args) == 1,
+            std::tuple_element_t<0, std::tuple<std::decay_t<Args>..., void>>,
+            Args_t>>;
+
+   public:
+    explicit Resume_on(Signal_t& signal) : signal_{signal} {}
+
+   public:
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        id_ = signal_.connect(Slot_t{[this, h](Args... args) {
+            if (args_.has_value())
+                return;
+            args_.emplace(args...);
+            // Disconnecting while the Signal is being emitted is not safe.
+            System::post_event(Custom_event{[this, h] {
+                signal_.disconnect(id_);
+                h.resume();
+            }});
+        }});
+    }
+
+    [[nodiscard]] auto await_resume() -> Result_t
+    {
+        if constexpr (sizeof...(Args) == 1)
+            return std::get<0>(std::move(*args_));
+        else if constexpr (sizeof...(Args) > 1)
+            return std::move(*args_);
+    }
+
+   private:
+    using Slot_t = typename Signal_t::Slot_t;
+    using Id_t   = decltype(std::declval<Signal_t&>().connect(Slot_t{}));
+
+    Signal_t& signal_;
+    Id_t id_ = {};
+    std::optional<Args_t> args_;
+};
+
+/// Awaiter that runs a function on a Worker_pool, resuming with its result.
+template <typename F>
+class Resume_after_work {
+   public:
+    using Result_t = std::invoke_result_t<F&>;
+
+   public:
+    Resume_after_work(Worker_pool& pool, F work)
+        : pool_{pool}, work_{std::move(work)}
+    {}
+
+   public:
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+        auto& engine = started_animation_engine();
+        pool_.submit([this, h, &engine] {
+            try {
+                if constexpr (std::is_void_v<Result_t>)
+                    work_();
+                else
+                    result_.emplace(work_());
+            }
+            catch (...) {
+                exception_ = std::current_exception();
+            }
+            engine.schedule(Timer::Clock_t::now(), [h] { h.resume(); });
+        });
+    }
+
+    [[nodiscard]] auto await_resume() -> Result_t
+    {
+        if (exception_ != nullptr)
+            std::rethrow_exception(exception_);
+        if constexpr (!std::is_void_v<Result_t>)
+            return std::move(*result_);
+    }
+
+   private:
+    using Storage_t = std::conditional_t<std::is_void_v<Result_t>,
+                                         std::nullptr_t,
+                                         std::optional<Result_t>>;
+
+    Worker_pool& pool_;
+    F work_;
+    Storage_t result_             = {};
+    std::exception_ptr exception_ = nullptr;
+};
+
+}  // namespace detail
+
+/// Resume on the Animation_engine's next frame.
+/** Frames are at least Animation_engine::frame_period apart, so a Task that
+ *  awaits this in a loop runs at most once per frame. */
+[[nodiscard]] inline auto next_frame() -> detail::Resume_at
+{
+    return detail::Resume_at{std::nullopt};
+}
+
+/// Resume on the Animation_engine's first frame after \p d has passed.
+/** No thread sleeps for the Task, the engine wakes when the time is due. */
+[[nodiscard]] inline auto sleep_for(Timer::Duration_t d) -> detail::Resume_at
+{
+    return detail::Resume_at{Timer::Clock_t::now() + d};
+}
+
+/// Resume after \p signal is next emitted, with the arguments it was sent.
+/** \p signal must outlive the wait. Resumes on the event loop that emitted
+ *  \p signal, after the Event being handled. Awaits a single emission, the
+ *  Slot is disconnected before resuming. */
+template <typename... Args>
+[[nodiscard]] auto on(sl::Signal<void(Args...)>& signal)
+    -> detail::Resume_on<Args...>
+{
+    return detail::Resume_on<Args...>{signal};
+}
+
+/// Run \p work on \p pool, resuming with its result once it has returned.
+/** Exceptions thrown by \p work are rethrown by the co_await. Resumes on the
+ *  Animation_engine's loop, \p pool must be destroyed before the Session. */
+template <typename F>
+[[nodiscard]] auto in_pool(Worker_pool& pool, F work)
+    -> detail::Resume_after_work<F>
+{
+    return detail::Resume_after_work<F>{pool, std::move(work)};
+}
+
+}  // namespace ox
+#endif  // TERMOX_SYSTEM_TASK_HPP
@@ -1,10 +1,13 @@
 #ifndef TERMOX_TERMINAL_DETAIL_CANVAS_HPP
 #define TERMOX_TERMINAL_DETAIL_CANVAS_HPP
+#include <array>
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include <termox/painter/brush.hpp>
 #include <termox/painter/color.hpp>
 #include <termox/painter/glyph.hpp>
 #include <termox/widget/area.hpp>
@@ -69,10 +72,50 @@ class Canvas {
     void swap(Canvas& x);
 };
 
+/// Per Color count of the Glyphs in each row of a Canvas that use the Color.
+/** Lets a Color targeted repaint visit only the rows that contain the Color,
+ *  instead of scanning the entire Canvas. A Glyph counts towards a Color if
+ *  either its foreground or background is that Color, it is counted once if
+ *  both are the same Color. Kept up to date by the merge functions below. */
+class Color_occupancy {
+   public:
+    /// Construct with zero counts for a Canvas with \p height rows.
+    explicit Color_occupancy(int height = 0);
+
+   public:
+    /// Resize to \p canvas and recount every Glyph in it.
+    void rebuild(Canvas const& canvas);
+
+    /// Update the counts for a Glyph in row \p y replaced by \p next.
+    void replace(int y, Glyph previous, Glyph next);
+
+    /// Return the number of Glyphs in row \p y that use \p c.
+    [[nodiscard]] auto count(Color c, int y) const -> int;
+
+    /// Return the number of Glyphs in the entire Canvas that use \p c.
+    [[nodiscard]] auto total(Color c) const -> int;
+
+    /// Return the number of rows being tracked.
+    [[nodiscard]] auto height() const -> int;
+
+   private:
+    int height_;
+    // Indexed by [color.value * height_ + y].
+    std::vector<std::uint16_t> counts_;
+    std::array<int, 256> totals_;
+
+   private:
+    void add(int y, Brush b, int amount);
+};
+
 /// Merge \p next into \p current.
 /** A Glyph with null(zero) symbol is considered an untouched cell. */
 void merge(Canvas const& next, Canvas& current);
 
+/// Merge \p next into \p current, updating \p occupancy for \p current.
+/** A Glyph with null(zero) symbol is considered an untouched cell. */
+void merge(Canvas const& next, Canvas& current, Color_occupancy& occupancy);
+
 /// Merge \p next into \p current, producing a diff of the changes.
 /** The diff is stored into \p diff_out, which is cleared at the start.
  *  diff_out is an out parameter for efficiency, to reduce allocations. A
@@ -81,6 +124,13 @@ void merge_and_diff(Canvas const& next,
                     Canvas& current,
                     Canvas::Diff& diff_out);
 
+/// Merge \p next into \p current, producing a diff of the changes.
+/** Same as above, and also updates \p occupancy to reflect \p current. */
+void merge_and_diff(Canvas const& next,
+                    Canvas& current,
+                    Canvas::Diff& diff_out,
+                    Color_occupancy& occupancy);
+
 /// Generate a Canvas::Diff containing only the items that contain \p color.
 /** Added to the diff if \p color can be found in either the Glyph's
  *  brush.foreground or brush.background members. The diff is written to \p
@@ -89,6 +139,14 @@ void generate_color_diff(Color color,
                          Canvas const& canvas,
                          Canvas::Diff& diff_out);
 
+/// Generate a Canvas::Diff containing only the items that contain \p color.
+/** Same as above, but only visits the rows that \p occupancy reports as
+ *  containing \p color. \p occupancy must be up to date with \p canvas. */
+void generate_color_diff(Color color,
+                         Canvas const& canvas,
+                         Color_occupancy const& occupancy,
+                         Canvas::Diff& diff_out);
+
 /// Writes the entire contents of \p canvas into \p diff_out.
 /** Clears diff_out before writing. */
 void generate_full_diff(Canvas const& canvas, Canvas::Diff& diff_out);
@@ -0,0 +1,47 @@
+#ifndef TERMOX_TERMINAL_DETAIL_COLOR_QUANTIZER_HPP
+#define TERMOX_TERMINAL_DETAIL_COLOR_QUANTIZER_HPP
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include <termox/painter/color.hpp>
+#include <termox/widget/point.hpp>
+
+namespace ox::detail {
+
+/// A set of terminal palette indices, one bit per index.
+using Palette_mask = std::bitset<256>;
+
+/// Return the terminal palette index nearest to \p tc.
+/** For terminals without true color support. \p color_count is the size of
+ *  the terminal's palette, 256+ maps onto the xterm color cube and grayscale
+ *  ramp [16 - 255], anything less maps onto the system colors [0 - 15] or
+ *  [0 - 7]. Nearest is measured by CIE76 distance in Lab space. Lookups go
+ *  through a 32x32x32 table per palette size, built on first use.
+ *
+ *  Indices in \p excluded are never returned, they have been redefined, such
+ *  as the slots reserved for Dynamic_colors. The table for the last non-empty
+ *  \p excluded is cached per thread and rebuilt when it changes. */
+[[nodiscard]] auto quantize(True_color tc,
+                            std::uint16_t color_count,
+                            Palette_mask const& excluded = {}) -> Color_index;
+
+/// Return the palette index for \p tc with ordered dithering at \p p.
+/** Offsets \p tc by a 4x4 Bayer matrix threshold for screen Point \p p before
+ *  the lookup, so that neighboring cells alternate between the nearest
+ *  palette colors instead of banding. \p excluded is as for quantize(). */
+[[nodiscard]] auto quantize_dithered(True_color tc,
+                                     std::uint16_t color_count,
+                                     Point p,
+                                     Palette_mask const& excluded = {})
+    -> Color_index;
+
+/// Return the Color in \p palette nearest to each xterm palette index.
+/** The result has 256 entries, Color_index definitions are compared using the
+ *  xterm default RGB values. Dynamic_colors are skipped, and each index maps
+ *  to Color{index} if \p palette has nothing to compare against. */
+[[nodiscard]] auto nearest_palette_colors(Palette const& palette)
+    -> std::vector<Color>;
+
+}  // namespace ox::detail
+#endif  // TERMOX_TERMINAL_DETAIL_COLOR_QUANTIZER_HPP
@@ -0,0 +1,28 @@
+#ifndef TERMOX_TERMINAL_DETAIL_COLOR_TABLES_HPP
+#define TERMOX_TERMINAL_DETAIL_COLOR_TABLES_HPP
+#include <map>
+#include <string>
+
+#include <termox/painter/color.hpp>
+#include <termox/terminal/detail/color_quantizer.hpp>
+
+namespace ox::detail {
+
+/// Terminal escape sequences and definitions for each Color in a Palette.
+struct Color_tables {
+    std::map<Color, std::string> fg;
+    std::map<Color, std::string> bg;
+
+    /// The True_color value of each palette Color that is defined by one.
+    /** Used to dither each cell individually when True_colors are quantized. */
+    std::map<Color, True_color> true_colors;
+
+    /// Terminal palette indices reserved for Dynamic_colors in Palette mode.
+    std::map<Color, Color_index> palette_slots;
+
+    /// The indices in palette_slots, never the result of quantization.
+    Palette_mask reserved_slots;
+};
+
+}  // namespace ox::detail
+#endif  // TERMOX_TERMINAL_DETAIL_COLOR_TABLES_HPP
@@ -1,13 +1,29 @@
 #ifndef TERMOX_TERMINAL_DETAIL_SCREEN_BUFFERS_HPP
 #define TERMOX_TERMINAL_DETAIL_SCREEN_BUFFERS_HPP
+#include <optional>
+#include <vector>
+
+#include <termox/painter/glyph.hpp>
 #include <termox/terminal/detail/canvas.hpp>
 #include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
+
+namespace ox {
+class Widget;
+}  // namespace ox
 
 namespace ox::detail {
 
 /// Holds the current and next screen buffers as Canvas objects.
 /** Provides merge and diff capabilities for the two buffers to determine what
- *  has changed and what should be written to the screen. */
+ *  has changed and what should be written to the screen.
+ *
+ *  Overlay layers are drawn above the base layer, the head Widget's tree. Each
+ *  overlay Widget paints into its own Canvas, and compose() writes the top
+ *  most Glyph of each changed cell into next before it is merged. While any
+ *  layer is shown, the base layer is kept in a Canvas of its own, so hiding a
+ *  layer recomposites the saved cells beneath it instead of repainting. */
 class Screen_buffers {
    public:
     Canvas current;
@@ -37,14 +53,64 @@ class Screen_buffers {
     /// Generates a Canvas::Diff, with every Glyph from current that has \p c.
     /** This isn't a true difference, it is meant to be used to generate a list
      *  of Glyphs that need to be re-written to the screen. Used by
-     *  Dynamic_color_engine. */
+     *  Dynamic_color_engine. Only visits the rows of current that contain \p
+     *  c, tracked by merge() and merge_and_diff(). */
     [[nodiscard]] auto generate_color_diff(Color c) -> Canvas::Diff const&;
 
     /// Returns the entire current screen as a Diff. Used on Window Resize.
     [[nodiscard]] auto current_screen_as_diff() -> Canvas::Diff const&;
 
+    /// Show a layer for \p owner at \p region above the base layer.
+    /** Layers with a higher \p z are drawn above lower ones. If \p owner
+     *  already has a layer it is moved and its previous region recomposited.
+     *  Cells of the layer that have not been painted are transparent. */
+    void show_layer(Widget& owner, int z, Rect region);
+
+    /// Remove the layer of \p owner and recomposite the cells beneath it.
+    /** No-op if \p owner does not have a layer. */
+    void hide_layer(Widget const& owner);
+
+    /// Return the Canvas that \p w paints to, next unless within a layer.
+    /** A layer is within \p w's tree if its owner is \p w or an ancestor of
+     *  \p w. The returned layer is recomposited on the next compose(). */
+    [[nodiscard]] auto canvas_for(Widget const& w) -> Canvas&;
+
+    /// Return the owner of the top most layer at \p p, or nullptr if none.
+    [[nodiscard]] auto layer_at(Point p) const -> Widget*;
+
+    /// Return the owner of each layer, bottom most first.
+    [[nodiscard]] auto layer_owners() const -> std::vector<Widget*>;
+
+    /// Write the composite of all layers into next, for each changed cell.
+    /** Called before merge() or merge_and_diff(), no-op without layers. */
+    void compose();
+
+    /// Return the Diff generated by the last call to one of the above.
+    /** Used to inspect which cells the last refresh wrote to the terminal. */
+    [[nodiscard]] auto last_diff() const -> Canvas::Diff const&;
+
+   private:
+    struct Layer {
+        Widget* owner;
+        int z;
+        Rect region;
+        Canvas canvas;
+        bool is_dirty = true;
+    };
+
    private:
     Canvas::Diff diff_;
+    Color_occupancy occupancy_;
+    Canvas base_;
+    std::vector<Layer> layers_;  // Sorted by z, top most last.
+    std::vector<Rect> stale_;    // Regions to recomposite on next compose().
+
+   private:
+    /// Return the Glyph shown at \p p by the top most layer, or base_.
+    [[nodiscard]] auto composite_at(Point p) const -> Glyph;
+
+    /// Return the Glyph at \p p of the top most layer painted there.
+    [[nodiscard]] auto layer_glyph_at(Point p) const -> std::optional<Glyph>;
 };
 
 }  // namespace ox::detail
@@ -1,5 +1,6 @@
 #ifndef TERMOX_TERMINAL_DYNAMIC_COLOR_ENGINE_HPP
 #define TERMOX_TERMINAL_DYNAMIC_COLOR_ENGINE_HPP
+#include <chrono>
 #include <mutex>
 #include <vector>
 
@@ -24,7 +25,14 @@ class Dynamic_color_engine : private Lockable<std::mutex> {
         Time_point last_event_time;
     };
 
-    static auto constexpr default_interval = Duration_t{100};
+    static auto constexpr default_interval =
+        Duration_t{std::chrono::milliseconds{100}};
+
+    /// Time per frame after which a remaining color update waits a frame.
+    static auto constexpr frame_budget = Event_queue::Budget_t{8'000};
+
+    /// Only the newest value of each Color is kept while the UI is lagging.
+    static auto constexpr backpressure = Backpressure{64, true, true, true};
 
    public:
     /// Add a dynamic color linked to \p color.
@@ -47,6 +55,9 @@ class Dynamic_color_engine : private Lockable<std::mutex> {
     /// Sends exit signal and waits for animation thread to exit.
     void stop();
 
+    /// Return how many color updates and frames have been shed so far.
+    [[nodiscard]] auto shed_counts() const -> Shed_counts;
+
    private:
     std::vector<Registered_data> data_;
     Event_loop loop_;
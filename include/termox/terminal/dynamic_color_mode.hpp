@@ -0,0 +1,16 @@
+#ifndef TERMOX_TERMINAL_DYNAMIC_COLOR_MODE_HPP
+#define TERMOX_TERMINAL_DYNAMIC_COLOR_MODE_HPP
+
+namespace ox {
+
+/// Describes how Dynamic_colors are animated on the terminal screen.
+/** Repaint: Each tick updates the Color's escape sequence and rewrites every
+ *           cell on the screen that uses the Color.
+ *  Palette: Each Dynamic_color is mapped to a reserved terminal palette index,
+ *           each tick redefines that index in place with a single OSC 4
+ *           sequence, no cells are rewritten. Requires a 256 color terminal
+ *           that supports OSC 4, falls back to Repaint otherwise. */
+enum class Dynamic_color_mode { Repaint, Palette };
+
+}  // namespace ox
+#endif  // TERMOX_TERMINAL_DYNAMIC_COLOR_MODE_HPP
@@ -7,8 +7,9 @@
 #include <termox/painter/color.hpp>
 #include <termox/painter/glyph.hpp>
 #include <termox/system/event_fwd.hpp>
+#include <termox/system/event_queue.hpp>
 #include <termox/terminal/detail/screen_buffers.hpp>
-#include <termox/terminal/dynamic_color_engine.hpp>
+#include <termox/terminal/dynamic_color_mode.hpp>
 #include <termox/terminal/key_mode.hpp>
 #include <termox/terminal/mouse_mode.hpp>
 #include <termox/terminal/signals.hpp>
@@ -16,11 +17,18 @@
 
 namespace ox {
 
+/// Display and input of the current Session's terminal.
+/** The static functions operate on the current Session of the calling thread,
+ *  which is the default Session, on stdin and stdout, unless another is
+ *  selected, see Session. */
 class Terminal {
    public:
-    inline static sl::Signal<void(Palette const&)> palette_changed;
+    /// Emitted by set_palette() with the new Palette of the current Session.
+    [[nodiscard]] static auto palette_changed()
+        -> sl::Signal<void(Palette const&)>&;
 
-    inline static detail::Screen_buffers screen_buffers{Area{0, 0}};
+    /// Return the staged and on screen Canvases of the current Session.
+    [[nodiscard]] static auto screen_buffers() -> detail::Screen_buffers&;
 
    public:
     /// Initializes the terminal screen into curses mode.
@@ -72,7 +80,45 @@ class Terminal {
     /** Used by Dynamic_color_engine. */
     static void repaint_color(Color c);
 
+    /// Display the Dynamic_color \p c with its next value \p tc.
+    /** Used by Dynamic_color_engine. If \p c has a reserved palette index, the
+     *  index is redefined in place, otherwise falls back to
+     *  update_color_stores() and repaint_color(). */
+    static void update_dynamic_color(Color c, True_color tc);
+
+    /// Set how Dynamic_colors are animated, see Dynamic_color_mode.
+    /** Re-applies the current palette so the new mode takes effect. */
+    static void set_dynamic_color_mode(Dynamic_color_mode mode);
+
+    /// Return the currently requested Dynamic_color_mode.
+    [[nodiscard]] static auto dynamic_color_mode() -> Dynamic_color_mode;
+
+    /// Return the color updates and frames shed by the Dynamic_color_engine.
+    [[nodiscard]] static auto dynamic_color_shed_counts() -> Shed_counts;
+
+    /// Enable ordered dithering of True_colors on terminals without true color.
+    /** Each cell using a True_color or Dynamic_color defined Color is
+     *  quantized individually with a 4x4 Bayer matrix, instead of every cell
+     *  using the single nearest palette color. Useful for gradients such as
+     *  Color_graph and pixel buffers. No effect on true color terminals. */
+    static void set_dithering(bool enable = true);
+
+    /// Return true if dithering has been enabled with set_dithering().
+    [[nodiscard]] static auto is_dithering() -> bool;
+
+    /// Enable writing runs of identical Glyphs with fewer bytes, default off.
+    /** Repeated Glyphs are written once then repeated with REP, blank runs
+     *  are erased with ECH or EL, and full screen repaints begin by clearing
+     *  the screen. Only enable for terminals that implement REP and fill
+     *  erased cells with the current background color (BCE), such as xterm. */
+    static void set_run_compression(bool enable = true);
+
+    /// Return true if run compression is enabled, see set_run_compression().
+    [[nodiscard]] static auto is_run_compression() -> bool;
+
     /// Change Color definitions.
+    /** True_color and Dynamic_color definitions are quantized to the nearest
+     *  palette color if the terminal does not support true color. */
     static void set_palette(Palette colors);
 
     /// Append a Color_definition::Value_t to the current color palette.
@@ -118,11 +164,7 @@ class Terminal {
     static void handle_signint(bool x);
 
    private:
-    inline static Palette palette_;
-    inline static Dynamic_color_engine dynamic_color_engine_;
-    inline static bool is_initialized_ = false;
-    inline static bool full_repaint_   = false;
-    inline static bool handle_sigint_  = true;
+    inline static bool handle_sigint_ = true;
 };
 
 }  // namespace ox
@@ -37,17 +37,24 @@
 #include <termox/painter/glyph.hpp>
 #include <termox/painter/glyph_matrix.hpp>
 #include <termox/painter/glyph_string.hpp>
+#include <termox/painter/grapheme.hpp>
 #include <termox/painter/painter.hpp>
+#include <termox/painter/styles.hpp>
 #include <termox/painter/trait.hpp>
 
 #include <termox/system/animation_engine.hpp>
 #include <termox/system/event.hpp>
 #include <termox/system/event_loop.hpp>
+#include <termox/system/input_recording.hpp>
 #include <termox/system/key.hpp>
 #include <termox/system/mouse.hpp>
+#include <termox/system/profiler.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
 #include <termox/system/shortcuts.hpp>
 #include <termox/system/system.hpp>
 
+#include <termox/terminal/dynamic_color_mode.hpp>
 #include <termox/terminal/key_mode.hpp>
 #include <termox/terminal/mouse_mode.hpp>
 #include <termox/terminal/signals.hpp>
@@ -90,6 +97,7 @@
 #include <termox/widget/widgets/selectable.hpp>
 #include <termox/widget/widgets/slider.hpp>
 #include <termox/widget/widgets/spinner.hpp>
+#include <termox/widget/widgets/terminal_view.hpp>
 #include <termox/widget/widgets/text_view.hpp>
 #include <termox/widget/widgets/textbox.hpp>
 #include <termox/widget/widgets/tile.hpp>
@@ -104,11 +112,14 @@
 #include <termox/widget/boundary.hpp>
 #include <termox/widget/cursor.hpp>
 #include <termox/widget/focus_policy.hpp>
+#include <termox/widget/framed.hpp>
 #include <termox/widget/growth.hpp>
 #include <termox/widget/layout.hpp>
 #include <termox/widget/pair.hpp>
 #include <termox/widget/pipe.hpp>
 #include <termox/widget/point.hpp>
+#include <termox/widget/scroll_area.hpp>
+#include <termox/widget/select.hpp>
 #include <termox/widget/size_policy.hpp>
 #include <termox/widget/tuple.hpp>
 #include <termox/widget/widget.hpp>
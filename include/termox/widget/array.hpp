@@ -6,6 +6,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <termox/widget/layouts/detail/static_geometry.hpp>
 #include <termox/widget/layouts/horizontal.hpp>
 #include <termox/widget/layouts/stack.hpp>
 #include <termox/widget/layouts/vertical.hpp>
@@ -13,9 +14,10 @@
 namespace ox {
 
 /// Homogeneous collection of Widgets within a Layout_t<Widget_t>.
-/** Depends on Layout_t::make_child(args...) to construct the Widget_t. */
+/** Depends on Layout_t::make_child(args...) to construct the Widget_t. Linear
+ *  Layouts of fixed size Widgets are laid out by Static_geometry. */
 template <typename Layout_t, std::size_t N>
-class Array : public Layout_t {
+class Array : public layout::detail::Static_geometry<Layout_t, N> {
    public:
     /// \p args will be copied into each Widget's constructor call.
     template <typename... Args>
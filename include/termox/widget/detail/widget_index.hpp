@@ -0,0 +1,71 @@
+#ifndef TERMOX_WIDGET_DETAIL_WIDGET_INDEX_HPP
+#define TERMOX_WIDGET_DETAIL_WIDGET_INDEX_HPP
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ox {
+class Widget;
+}  // namespace ox
+
+namespace ox::detail {
+
+/// Index of the current Session's Widgets by name and by most derived type.
+/** Kept up to date by Widget: names on construction and set_name(), types on
+ *  set_parent(), since a Widget is only fully constructed once it is given a
+ *  parent, and both are removed on destruction. A Widget that has never had
+ *  a parent is only indexed by name.
+ *
+ *  Each Session owns its index, so a Widget is renamed and destroyed in the
+ *  Session that was current when it was constructed, like its focus. */
+class Widget_index {
+   public:
+    /// The Widgets of each Session.
+    struct State {
+        std::unordered_map<std::string, std::unordered_set<Widget*>> by_name;
+        std::unordered_map<std::type_index, std::unordered_set<Widget*>>
+            by_type;
+        std::unordered_map<Widget const*, std::type_index> type_of;
+        std::unordered_map<std::type_index, std::string> type_names;
+    };
+
+   public:
+    /// Index \p w under \p name, empty names are not indexed.
+    static void add(Widget& w, std::string const& name);
+
+    /// Move \p w from \p old_name to \p new_name, empty names are not indexed.
+    static void rename(Widget& w,
+                       std::string const& old_name,
+                       std::string const& new_name);
+
+    /// Index \p w by its dynamic type, no-op if already indexed.
+    static void add_type(Widget& w);
+
+    /// Remove \p w from both indices, \p name is its current name.
+    /** Does not use the dynamic type of \p w, safe to call from ~Widget. */
+    static void remove(Widget& w, std::string const& name);
+
+    /// Return every Widget with \p name.
+    [[nodiscard]] static auto with_name(std::string const& name)
+        -> std::vector<Widget*>;
+
+    /// Return every Widget with a type named \p name.
+    /** Only Widgets indexed by type are considered, see type_name(). */
+    [[nodiscard]] static auto with_type(std::string_view name)
+        -> std::vector<Widget*>;
+
+    /// Return the unqualified class name of \p t, without template arguments.
+    /** ox::layout::Vertical<> is "Linear_layout", as Vertical is an alias. */
+    [[nodiscard]] static auto type_name(std::type_index t)
+        -> std::string const&;
+
+   private:
+    /// Return the State of the current Session.
+    [[nodiscard]] static auto state() -> State&;
+};
+
+}  // namespace ox::detail
+#endif  // TERMOX_WIDGET_DETAIL_WIDGET_INDEX_HPP
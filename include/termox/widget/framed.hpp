@@ -0,0 +1,234 @@
+#ifndef TERMOX_WIDGET_FRAMED_HPP
+#define TERMOX_WIDGET_FRAMED_HPP
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <signals_light/signal.hpp>
+
+#include <termox/painter/painter.hpp>
+#include <termox/system/event.hpp>
+#include <termox/system/system.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/bordered.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace ox {
+
+/// Wraps Widget_t in a Border that is painted instead of built from Widgets.
+/** Same interface as Bordered<Widget_t>. This is a single Widget holding
+ *  wrapped as its only child, inset by one cell for each enabled Wall, the
+ *  Border is painted around it. No part of the Border takes part in layout,
+ *  focus traversal or hit testing, a click on it gives focus to wrapped. */
+template <typename Widget_t>
+class Framed : public Widget {
+    static_assert(std::is_base_of<Widget, Widget_t>::value,
+                  "Framed: Widget_t must be a Widget type");
+
+   public:
+    struct Parameters {
+        Border border;
+        typename Widget_t::Parameters wrapped_parameters;
+    };
+
+   public:
+    Widget_t& wrapped;
+
+    /// Called on set_border(...) after the Border has been set.
+    sl::Signal<void()> border_set;
+
+   public:
+    template <typename... Args>
+    explicit Framed(Border b, Args&&... wrapped_args)
+        : wrapped{this->adopt(
+              std::make_unique<Widget_t>(std::forward<Args>(wrapped_args)...))},
+          border_{std::move(b)}
+    {
+        this->initialize();
+    }
+
+    // This overload is required for apple-clang and clang 9 & 10.
+    // Otherwise you'd just have Border have a default value above.
+    Framed()
+        : wrapped{this->adopt(std::make_unique<Widget_t>())},
+          border_{border::rounded()}
+    {
+        this->initialize();
+    }
+
+    explicit Framed(Parameters p)
+        : Framed{std::move(p.border), std::move(p.wrapped_parameters)}
+    {}
+
+    /// Create a border around an existing Widget.
+    /** Defaults to border::rounded(), can be modified with pipe op. */
+    explicit Framed(std::unique_ptr<Widget_t> w_ptr)
+        : wrapped{this->adopt(std::move(w_ptr))}, border_{border::rounded()}
+    {
+        this->initialize();
+    }
+
+   public:
+    /// Set the currently used Border, updating the display.
+    void set_border(Border b)
+    {
+        border_ = b;
+        this->place_wrapped();
+        this->update();
+        border_set.emit();
+    }
+
+    /// Return the currenly set Border.
+    auto border() const -> Border { return border_; }
+
+    /// Repaint the Border.
+    /** wrapped is only repainted with it if the Border's wallpaper fill covers
+     *  wrapped, which is when wrapped is a Layout, as Layouts do not paint. */
+    void update() override
+    {
+        Widget::update();
+        if (!is_empty(this->covered_region()))
+            return;
+        wrapped.update();
+        for (Widget* const d : wrapped.get_descendants())
+            d->update();
+    }
+
+    using Widget::update;
+
+    /// Return the area within the Border, unless wrapped does not paint it.
+    [[nodiscard]] auto covered_region() const -> Rect override
+    {
+        auto const& w = static_cast<Widget const&>(wrapped);
+        if (w.is_layout_type() || !w.is_enabled())
+            return {};
+        return this->inner_region();
+    }
+
+   protected:
+    auto paint_event(Painter& p) -> bool override
+    {
+        auto const& b = border_;
+        auto const x  = this->area().width - 1;
+        auto const y  = this->area().height - 1;
+        if (b.north.has_value())
+            p.hline(*b.north, {0, 0}, {x, 0});
+        if (b.south.has_value())
+            p.hline(*b.south, {0, y}, {x, y});
+        if (b.west.has_value())
+            p.vline(*b.west, {0, 0}, {0, y});
+        if (b.east.has_value())
+            p.vline(*b.east, {x, 0}, {x, y});
+        if (b.north.has_value() && b.west.has_value())
+            p.put(b.nw_corner, {0, 0});
+        if (b.north.has_value() && b.east.has_value())
+            p.put(b.ne_corner, {x, 0});
+        if (b.south.has_value() && b.west.has_value())
+            p.put(b.sw_corner, {0, y});
+        if (b.south.has_value() && b.east.has_value())
+            p.put(b.se_corner, {x, y});
+        return Widget::paint_event(p);
+    }
+
+    auto enable_event() -> bool override
+    {
+        this->place_wrapped();
+        return Widget::enable_event();
+    }
+
+    auto disable_event() -> bool override
+    {
+        wrapped.disable();
+        return Widget::disable_event();
+    }
+
+    auto move_event(Point new_position, Point old_position) -> bool override
+    {
+        this->place_wrapped();
+        return Widget::move_event(new_position, old_position);
+    }
+
+    auto resize_event(Area new_size, Area old_size) -> bool override
+    {
+        this->place_wrapped();
+        return Widget::resize_event(new_size, old_size);
+    }
+
+   private:
+    Border border_;
+
+   private:
+    /// Make \p w the only child of *this, and return a reference to it.
+    auto adopt(std::unique_ptr<Widget_t> w) -> Widget_t&
+    {
+        auto& child = *w;
+        children_.push_back(std::move(w));
+        child.set_parent(this);
+        return child;
+    }
+
+    /// Return the area within the Border in local coordinates, can be empty.
+    [[nodiscard]] auto inner_region() const -> Rect
+    {
+        auto const& b     = border_;
+        auto const offset = Point{b.west.has_value() ? 1 : 0,
+                                  b.north.has_value() ? 1 : 0};
+        auto const area   = Area{
+            this->area().width - offset.x - (b.east.has_value() ? 1 : 0),
+            this->area().height - offset.y - (b.south.has_value() ? 1 : 0)};
+        return {offset, area};
+    }
+
+    /// Move and resize wrapped to the area within the Border.
+    /** Disables wrapped if the Border leaves no room for it. */
+    void place_wrapped()
+    {
+        if (!this->is_enabled())
+            return;
+        auto const inner = this->inner_region();
+        if (is_empty(inner)) {
+            wrapped.disable();
+            return;
+        }
+        wrapped.enable();
+        System::post_event(
+            Move_event{wrapped, this->top_left() + inner.top_left});
+        System::post_event(Resize_event{wrapped, inner.area});
+    }
+
+    void initialize()
+    {
+        // Can't use pipe:: in this file.
+        this->focus_policy = wrapped.focus_policy;
+        this->focused_in.connect([&] { System::set_focus(wrapped); });
+    }
+};
+
+/// Helper function to create an instance of Framed<Widget_t>.
+template <typename Widget_t>
+[[nodiscard]] auto framed(typename Framed<Widget_t>::Parameters p = {
+                              border::rounded(),
+                              {}}) -> std::unique_ptr<Framed<Widget_t>>
+{
+    return std::make_unique<Framed<Widget_t>>(std::move(p));
+}
+
+/// Helper function to create an instance of Framed<Widget_t>.
+template <typename Widget_t, typename... Args>
+[[nodiscard]] auto framed(Border b = border::rounded(), Args&&... wrapped_args)
+{
+    return std::make_unique<Framed<Widget_t>>(
+        std::move(b), std::forward<Args>(wrapped_args)...);
+}
+
+template <typename Widget_t>
+[[nodiscard]] auto framed(std::unique_ptr<Widget_t> w_ptr)
+    -> std::unique_ptr<Framed<Widget_t>>
+{
+    return std::make_unique<Framed<Widget_t>>(std::move(w_ptr));
+}
+
+}  // namespace ox
+#endif  // TERMOX_WIDGET_FRAMED_HPP
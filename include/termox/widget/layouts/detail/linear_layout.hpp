@@ -167,6 +167,16 @@ class Linear_layout : public Layout<Child> {
    protected:
     using Parameters_t = Parameters;
 
+   protected:
+    /// Lay out children without the general solution, return false if unable.
+    /** Overridden by Static_geometry, for layouts with a fixed child count. */
+    virtual auto try_static_layout() -> bool { return false; }
+
+    /// Return true if the general solution is sent rather than posted.
+    /** Overridden by Static_geometry, so that Resize and Move events posted by
+     *  an earlier general solution do not overwrite a later direct send. */
+    [[nodiscard]] virtual auto sends_directly() const -> bool { return false; }
+
    protected:
     auto enable_event() -> bool override
     {
@@ -231,6 +241,9 @@ class Linear_layout : public Layout<Child> {
         }
 #endif
 
+        if (this->try_static_layout())
+            return;
+
         auto const primary_lengths = shared_space_.calculate_lengths(*this);
         auto const primary_pos =
             shared_space_.calculate_positions(primary_lengths);
@@ -270,7 +283,10 @@ class Linear_layout : public Layout<Child> {
             auto& child = children[offset + i];
             auto const area =
                 typename Parameters::get_area{}(primary[i], secondary[i]);
-            System::post_event(Resize_event{child, area});
+            if (this->sends_directly())
+                System::send_event(Resize_event{child, area});
+            else
+                System::post_event(Resize_event{child, area});
         }
     }
 
@@ -287,7 +303,10 @@ class Linear_layout : public Layout<Child> {
             auto& child      = children[offset + i];
             auto const point = typename Parameters::get_point{}(
                 primary[i] + primary_offset, secondary[i] + secondary_offset);
-            System::post_event(Move_event{child, point});
+            if (this->sends_directly())
+                System::send_event(Move_event{child, point});
+            else
+                System::post_event(Move_event{child, point});
         }
     }
 
@@ -0,0 +1,159 @@
+#ifndef TERMOX_WIDGET_LAYOUTS_DETAIL_STATIC_GEOMETRY_HPP
+#define TERMOX_WIDGET_LAYOUTS_DETAIL_STATIC_GEOMETRY_HPP
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <termox/system/event.hpp>
+#include <termox/system/system.hpp>
+#include <termox/widget/layouts/detail/linear_layout.hpp>
+#include <termox/widget/size_policy.hpp>
+
+namespace ox::layout::detail {
+
+/// The parts of a Size_policy that Static_geometry depends on.
+struct Length_limits {
+    int min;
+    int hint;
+    int max;
+};
+
+/// Return the primary lengths Shared_space would give \p limits, if simple.
+/** Simple is when each child is fixed, min == hint == max, except for at most
+ *  one, and the fixed lengths plus the other's min fit within \p length. The
+ *  non-fixed child gets what is left, up to its max. Returns std::nullopt
+ *  otherwise, where the general Shared_space solution is needed. */
+template <std::size_t N>
+[[nodiscard]] constexpr auto static_lengths(
+    std::array<Length_limits, N> const& limits,
+    int length) -> std::optional<std::array<int, N>>
+{
+    auto result    = std::array<int, N>{};
+    auto flexible  = N;
+    auto fixed_sum = 0;
+    for (auto i = std::size_t{0}; i < N; ++i) {
+        auto const& l = limits[i];
+        if (l.min == l.hint && l.hint == l.max) {
+            if (l.max > length - fixed_sum)
+                return std::nullopt;
+            result[i] = l.max;
+            fixed_sum += l.max;
+        }
+        else if (flexible == N)
+            flexible = i;
+        else
+            return std::nullopt;
+    }
+    if (flexible == N)
+        return result;
+    auto const remaining = length - fixed_sum;
+    if (remaining < limits[flexible].min)
+        return std::nullopt;
+    result[flexible] = std::min(remaining, limits[flexible].max);
+    return result;
+}
+
+/// Return the secondary length Unique_space would give for \p limit space.
+[[nodiscard]] constexpr auto unique_length(Length_limits const& l,
+                                           bool can_ignore_min,
+                                           int limit) -> int
+{
+    if (limit > l.max)
+        return l.max;
+    if (limit < l.min && !can_ignore_min)
+        return 0;
+    return limit;
+}
+
+template <typename Child_t, typename Parameters>
+auto is_linear_layout_impl(Linear_layout<Child_t, Parameters>&)
+    -> std::true_type;
+
+auto is_linear_layout_impl(...) -> std::false_type;
+
+/// True if T is a Linear_layout type or derived from one.
+template <typename T>
+inline bool constexpr is_linear_layout_v =
+    decltype(is_linear_layout_impl(std::declval<T&>()))::value;
+
+/// Layout_t, unchanged if it is not a Linear_layout.
+template <typename Layout_t, std::size_t N, typename SFINAE = void>
+class Static_geometry : public Layout_t {
+   public:
+    using Layout_t::Layout_t;
+};
+
+/// Linear_layout with an allocation free path for N fixed size children.
+/** Used by Tuple, Array and Pair, which know their child count at compile
+ *  time. When children are fixed size, except for at most one, and fit, their
+ *  geometry is computed into std::arrays and sent directly, rather than posted
+ *  as events for a later pass of the event queue. Falls back to the general
+ *  Linear_layout solution otherwise, or if the child count is not N, which is
+ *  also sent directly so the two paths never interleave. */
+template <typename Layout_t, std::size_t N>
+class Static_geometry<Layout_t,
+                      N,
+                      std::enable_if_t<is_linear_layout_v<Layout_t>>>
+    : public Layout_t {
+   public:
+    using Layout_t::Layout_t;
+
+   protected:
+    [[nodiscard]] auto sends_directly() const -> bool override { return true; }
+
+    auto try_static_layout() -> bool override
+    {
+        using Parameters = typename Layout_t::Parameters_t;
+        using Primary    = typename Parameters::Primary;
+        using Secondary  = typename Parameters::Secondary;
+
+        auto const children = this->get_children();
+        if (children.size() != N || this->get_child_offset() != 0)
+            return false;
+
+        auto primary_limits   = std::array<Length_limits, N>{};
+        auto secondary_limits = std::array<Length_limits, N>{};
+        for (auto i = std::size_t{0}; i < N; ++i) {
+            primary_limits[i] =
+                limits_of(typename Primary::get_policy{}(children[i]));
+            secondary_limits[i] =
+                limits_of(typename Secondary::get_policy{}(children[i]));
+        }
+        auto const primary = static_lengths(
+            primary_limits, typename Primary::get_length{}(*this));
+        if (!primary.has_value())
+            return false;
+
+        auto const secondary_limit = typename Secondary::get_length{}(*this);
+        auto const secondary_offset = typename Secondary::get_offset{}(*this);
+        auto position = typename Primary::get_offset{}(*this);
+        for (auto i = std::size_t{0}; i < N; ++i) {
+            auto& child = children[i];
+            auto const length    = (*primary)[i];
+            auto const secondary = unique_length(
+                secondary_limits[i],
+                typename Secondary::get_policy{}(child).can_ignore_min(),
+                secondary_limit);
+            child.enable(length != 0 && secondary != 0);
+            System::send_event(Resize_event{
+                child, typename Parameters::get_area{}(length, secondary)});
+            System::send_event(Move_event{
+                child,
+                typename Parameters::get_point{}(position, secondary_offset)});
+            position += length;
+        }
+        return true;
+    }
+
+   private:
+    [[nodiscard]] static auto limits_of(Size_policy const& p) -> Length_limits
+    {
+        return {p.min(), p.hint(), p.max()};
+    }
+};
+
+}  // namespace ox::layout::detail
+#endif  // TERMOX_WIDGET_LAYOUTS_DETAIL_STATIC_GEOMETRY_HPP
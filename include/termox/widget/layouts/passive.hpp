@@ -1,11 +1,14 @@
 #ifndef TERMOX_WIDGET_LAYOUTS_PASSIVE_HPP
 #define TERMOX_WIDGET_LAYOUTS_PASSIVE_HPP
 #include <array>
+#include <cstddef>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 #include <termox/widget/bordered.hpp>
+#include <termox/widget/framed.hpp>
 #include <termox/widget/layouts/horizontal.hpp>
 #include <termox/widget/layouts/vertical.hpp>
 #include <termox/widget/pipe.hpp>
@@ -24,6 +27,9 @@ struct Is_bordered : std::false_type {};
 template <typename W>
 struct Is_bordered<::ox::Bordered<W>> : std::true_type {};
 
+template <typename W>
+struct Is_bordered<::ox::Framed<W>> : std::true_type {};
+
 template <typename W>
 inline auto constexpr is_bordered_v = Is_bordered<W>::value;
 
@@ -35,7 +41,9 @@ class Passive;
 
 /// Make any Linear_layout type passive.
 /** A Passive Layout will always have the size policy that is the sum of its
- *  children's size hints. */
+ *  children's size hints. The sum is kept up to date by the change in each
+ *  child's hint, and the size policy is only reset, and so only propagated to
+ *  the parent, when the sum changes. */
 template <typename Layout_t>
 class Passive<Layout_t,
               std::enable_if_t<detail::is_horizontal_or_vertical_v<Layout_t> &&
@@ -53,70 +61,120 @@ class Passive<Layout_t,
     template <typename... Args>
     Passive(Args&&... args) : Base_t{std::forward<Args>(args)...}
     {
-        this->set_length(
-            sum_hints(this->get_children(), this->get_child_offset()));
+        this->recount();
     }
 
-    Passive(Parameters p) : Base_t{std::move(p)}
-    {
-        this->set_length(
-            sum_hints(this->get_children(), this->get_child_offset()));
-    }
+    Passive(Parameters p) : Base_t{std::move(p)} { this->recount(); }
 
    protected:
     auto child_added_event(ox::Widget& child) -> bool override
     {
-        this->set_length(
-            sum_hints(this->get_children(), this->get_child_offset()));
+        this->track(child);
         return Base_t::child_added_event(child);
     }
 
     auto child_removed_event(ox::Widget& child) -> bool override
     {
-        this->set_length(
-            sum_hints(this->get_children(), this->get_child_offset()));
+        this->untrack(child);
         return Base_t::child_removed_event(child);
     }
 
     auto child_polished_event(ox::Widget& child) -> bool override
     {
-        this->set_length(
-            sum_hints(this->get_children(), this->get_child_offset()));
+        // set_child_offset() posts this with *this as the child.
+        if (&child == this)
+            this->recount();
+        else
+            this->track(child);
         return Base_t::child_polished_event(child);
     }
 
    private:
-    /// Return the sum of all hints in the inherited from Layout_t direction.
-    static auto sum_hints(decltype(std::declval<Layout_t>().get_children())
-                              const& children,
-                          std::size_t begin_offset) -> int
+    /// Last seen hint of each child counted in sum_.
+    std::unordered_map<Widget const*, int> hints_;
+    int sum_                  = 0;
+    std::size_t counted_from_ = 0;
+
+   private:
+    [[nodiscard]] static auto hint_of(Widget const& child) -> int
     {
-        auto get_hint = [](Widget const& child) {
-            if constexpr (is_vertical)
-                return child.height_policy.hint();
-            else
-                return child.width_policy.hint();
-        };
-
-        auto sum = 0;
-        for (auto i = begin_offset; i < children.size(); ++i)
-            sum += get_hint(children[i]);
-        return sum;
+        if constexpr (is_vertical)
+            return child.height_policy.hint();
+        else
+            return child.width_policy.hint();
     }
 
+    /// Rebuild hints_ and sum_ from the children at or after the offset.
+    void recount()
+    {
+        auto const& children = this->get_children();
+        counted_from_        = this->get_child_offset();
+        hints_.clear();
+        sum_ = 0;
+        for (auto i = counted_from_; i < children.size(); ++i) {
+            auto const hint       = hint_of(children[i]);
+            hints_[&children[i]] = hint;
+            sum_ += hint;
+        }
+        this->set_length(sum_);
+    }
+
+    /// Add the change in \p child's hint to sum_.
+    /** Only an offset of zero makes every child counted, otherwise a child's
+     *  index is needed to tell whether it is counted, so recount instead. */
+    void track(Widget const& child)
+    {
+        if (counted_from_ != 0 || this->get_child_offset() != 0) {
+            this->recount();
+            return;
+        }
+        if (child.parent() != this)  // Removed before this event was sent.
+            return;
+        auto const hint = hint_of(child);
+        auto& last      = hints_[&child];  // Zero if not yet counted.
+        sum_ += hint - last;
+        last = hint;
+        this->set_length(sum_);
+    }
+
+    /// Subtract \p child's last seen hint from sum_.
+    /** \p child may already be deleted, it is only used as a key. */
+    void untrack(Widget const& child)
+    {
+        if (counted_from_ != 0 || this->get_child_offset() != 0) {
+            this->recount();
+            return;
+        }
+        auto const at = hints_.find(&child);
+        if (at == std::end(hints_))
+            return;
+        sum_ -= at->second;
+        hints_.erase(at);
+        this->set_length(sum_);
+    }
+
+    /// Set the fixed length, if it differs from the current size policy.
     void set_length(int length)
     {
-        if constexpr (is_vertical)
-            *this | pipe::fixed_height(length);
-        else
-            *this | pipe::fixed_width(length);
+        auto const policy = Size_policy::fixed(length);
+        if constexpr (is_vertical) {
+            if (this->height_policy != policy)
+                *this | pipe::fixed_height(length);
+        }
+        else {
+            if (this->width_policy != policy)
+                *this | pipe::fixed_width(length);
+        }
     }
 };
 
-template <typename Widget_t>
-class Passive<Bordered<Widget_t>> : public Bordered<Widget_t> {
+/// Make a Bordered or Framed Widget take on the size policies of wrapped.
+/** The policies are grown by the space the Border takes up. */
+template <typename Bordered_t>
+class Passive<Bordered_t, std::enable_if_t<detail::is_bordered_v<Bordered_t>>>
+    : public Bordered_t {
    private:
-    using Base_t = Bordered<Widget_t>;
+    using Base_t = Bordered_t;
 
    public:
     using Parameters = typename Base_t::Parameters;
@@ -131,14 +189,17 @@ class Passive<Bordered<Widget_t>> : public Bordered<Widget_t> {
     Passive(Parameters p) : Base_t{std::move(p)} { this->initialize(); }
 
    private:
+    /// Only assigns changed policies, so unchanged policies do not propagate.
     void set_policies(Size_policy height, Size_policy width)
     {
-        this->height_policy = height;
-        this->width_policy  = width;
+        if (this->height_policy != height)
+            this->height_policy = height;
+        if (this->width_policy != width)
+            this->width_policy = width;
     }
 
     /// Returns [height, width]
-    [[nodiscard]] static auto adjust_size_policies(Widget_t const& wrapped,
+    [[nodiscard]] static auto adjust_size_policies(Widget const& wrapped,
                                                    Border b)
         -> std::array<ox::Size_policy, 2>
     {
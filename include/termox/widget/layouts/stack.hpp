@@ -2,10 +2,13 @@
 #define TERMOX_WIDGET_LAYOUTS_STACK_HPP
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -24,13 +27,30 @@ namespace ox::layout {
 /// A Layout enabling only a single Widget at a time.
 /** A Stack is made up of pages, which are child Widgets that can be displayed
  *  one at a time within the Stack. The active page determines which child
- *  Widget is currently displayed. */
+ *  Widget is currently displayed.
+ *
+ *  Lazy pages are built by a Page_factory the first time they become active,
+ *  until then a default constructed Child_t stands in for the page. */
 template <typename Child_t = Widget>
 class Stack : public Layout<Child_t> {
+   public:
+    /// Builds a lazy page, may be called again if the page is destroyed.
+    using Page_factory = std::function<std::unique_ptr<Child_t>()>;
+
+    /// What is done with a page when it stops being the active page.
+    enum class Hibernation {
+        None,     // The page is disabled, this is the default.
+        Suspend,  // Also suspend animation on the page and its descendants.
+        Destroy   // As Suspend, but lazy pages are destroyed and later rebuilt.
+    };
+
    public:
     /// Emitted when the active page is changed, sends the new index along.
     sl::Signal<void(std::size_t)> page_changed;
 
+    /// Emitted after a lazy page is built, with its index and the new page.
+    sl::Signal<void(std::size_t, Child_t&)> page_built;
+
    public:
     using Layout<Child_t>::Layout;
 
@@ -42,11 +62,16 @@ class Stack : public Layout<Child_t> {
         if (index > this->Stack::size())
             throw std::out_of_range{"Stack::set_active_page: index is invalid"};
         auto* previous = active_page_;
-        active_page_   = std::addressof(this->get_children()[index]);
-        if (active_page_ == previous)
+        auto* next     = std::addressof(this->get_children()[index]);
+        if (next == previous)
             return;
-        if (previous != nullptr)
+        if (previous != nullptr) {
             previous->disable();
+            active_page_ = nullptr;
+            this->hibernate(*previous);
+        }
+        active_page_ = &this->build_if_lazy(index);
+        this->wake(*active_page_);
 
         active_page_->enable(this->is_enabled());
         // TODO move if enabled and force move if disabled?
@@ -64,6 +89,16 @@ class Stack : public Layout<Child_t> {
         sets_focus_ = sets_focus;
     }
 
+    /// Set what is done with pages that stop being the active page.
+    /** Only affects pages that are deactivated after this call. */
+    void set_hibernation(Hibernation h) { hibernation_ = h; }
+
+    /// Return the current Hibernation policy.
+    [[nodiscard]] auto hibernation() const -> Hibernation
+    {
+        return hibernation_;
+    }
+
     /// Construct and append a page to the Stack.
     /** This will construct a child Widget of type T, using \p args passed to
      *  T's constructor, and then automatically disable it. Returns a reference
@@ -110,6 +145,52 @@ class Stack : public Layout<Child_t> {
         return result;
     }
 
+    /// Append a page that is built by \p make when it first becomes active.
+    void append_lazy_page(Page_factory make)
+    {
+        this->insert_lazy_page(std::move(make), this->Stack::size());
+    }
+
+    /// Insert a page at \p index that is built by \p make on activation.
+    /** Throws std::out_of_range if \p index > number of children. */
+    void insert_lazy_page(Page_factory make, std::size_t index)
+    {
+        static_assert(std::is_default_constructible_v<Child_t>,
+                      "Stack::insert_lazy_page: Child_t must be default "
+                      "constructible, to stand in for unbuilt pages");
+        if (index > this->Stack::size())
+            throw std::out_of_range{"Stack::insert_lazy_page: invalid index"};
+        auto& placeholder =
+            this->insert_page(std::make_unique<Child_t>(), index);
+        lazy_.emplace(&placeholder, Lazy{std::move(make), false});
+    }
+
+    /// Append a lazy page that constructs a Widget_t from copies of \p args.
+    template <typename Widget_t = Child_t, typename... Args>
+    void make_lazy_page(Args&&... args)
+    {
+        static_assert(std::is_base_of<Child_t, Widget_t>::value,
+                      "Stack::make_lazy_page: Widget_t must be a Child_t type");
+        this->append_lazy_page(
+            [args = std::make_tuple(std::forward<Args>(args)...)] {
+                return std::apply(
+                    [](auto const&... a) -> std::unique_ptr<Child_t> {
+                        return std::make_unique<Widget_t>(a...);
+                    },
+                    args);
+            });
+    }
+
+    /// Return false if the page at \p index is lazy and not yet built.
+    /** Throws std::out_of_range if \p index is invalid. */
+    [[nodiscard]] auto is_built(std::size_t index) const -> bool
+    {
+        if (index >= this->Stack::size())
+            throw std::out_of_range{"Stack::is_built: index is invalid"};
+        auto const at = lazy_.find(&this->get_children()[index]);
+        return at == std::end(lazy_) || at->second.is_built;
+    }
+
     /// Remove a page from the list, by \p index value, and delete it.
     /** Throws std::out_of_range if \p index is invalid. Sets active page to
      *  nullptr if the active page is being deleted. */
@@ -121,6 +202,7 @@ class Stack : public Layout<Child_t> {
             std::addressof(this->get_children()[index]);
         if (page_to_delete == this->get_active_page())
             active_page_ = nullptr;
+        lazy_.erase(page_to_delete);
         this->remove_and_delete_child(page_to_delete);
     }
 
@@ -129,15 +211,16 @@ class Stack : public Layout<Child_t> {
      *  Stack::delete_page() if you want to remove a page and destroy it.
      *  Letting the returned Widget destroy itself will potentially leave
      *  dangling pointers in the event system. Throws std::out_of_range if \p
-     *  index is invalid. Sets active page to nullptr if active page removed. */
+     *  index is invalid. Sets active page to nullptr if active page removed.
+     *  A lazy page is built first, and is no longer lazy once removed. */
     [[nodiscard]] auto remove_page(std::size_t index) -> std::unique_ptr<Widget>
     {
         if (index >= this->size())
             throw std::out_of_range{"Stack::remove_page: index is invalid."};
-        auto const* page_to_remove =
-            std::addressof(this->get_children()[index]);
+        auto const* page_to_remove = &this->build_if_lazy(index);
         if (page_to_remove == this->get_active_page())
             active_page_ = nullptr;
+        lazy_.erase(page_to_remove);
         return this->remove_child(page_to_remove);
     }
 
@@ -217,8 +300,86 @@ class Stack : public Layout<Child_t> {
     }
 
    private:
-    Child_t* active_page_ = nullptr;
-    bool sets_focus_      = true;
+    struct Lazy {
+        Page_factory make;
+        bool is_built;
+    };
+
+    Child_t* active_page_    = nullptr;
+    bool sets_focus_         = true;
+    Hibernation hibernation_ = Hibernation::None;
+
+    // Keyed by the current page, the placeholder while the page is unbuilt.
+    std::unordered_map<Widget const*, Lazy> lazy_;
+
+   private:
+    /// Build the page at \p index if it is lazy and unbuilt, return the page.
+    auto build_if_lazy(std::size_t index) -> Child_t&
+    {
+        auto& page = this->get_children()[index];
+        auto at    = lazy_.find(&page);
+        if (at == std::end(lazy_) || at->second.is_built)
+            return page;
+        auto built = at->second.make();
+        if (built == nullptr)
+            throw std::runtime_error{"Stack: Page_factory returned nullptr."};
+        auto lazy = std::move(at->second);
+        lazy_.erase(at);
+        auto& result  = this->replace_page(index, std::move(built));
+        lazy.is_built = true;
+        lazy_.emplace(&result, std::move(lazy));
+        this->page_built(index, result);
+        return result;
+    }
+
+    /// Apply the Hibernation policy to \p page, which is no longer active.
+    void hibernate(Child_t& page)
+    {
+        if (hibernation_ == Hibernation::None)
+            return;
+        auto const at = lazy_.find(&page);
+        if (hibernation_ == Hibernation::Destroy && at != std::end(lazy_)) {
+            auto lazy     = std::move(at->second);
+            lazy.is_built = false;
+            lazy_.erase(at);
+            auto& placeholder = this->replace_page(
+                this->index_of(page), std::make_unique<Child_t>());
+            lazy_.emplace(&placeholder, std::move(lazy));
+            return;
+        }
+        System::suspend_animation(page);
+        for (Widget* const d : page.get_descendants())
+            System::suspend_animation(*d);
+    }
+
+    /// Resume anything suspended by hibernate(page).
+    /** Ignores the current policy, \p page may have been suspended under an
+     *  earlier one. Resuming a Widget that is not suspended does nothing. */
+    void wake(Child_t& page)
+    {
+        System::resume_animation(page);
+        for (Widget* const d : page.get_descendants())
+            System::resume_animation(*d);
+    }
+
+    /// Swap the page at \p index for \p page and delete the old page.
+    /** Returns a reference to \p page, which is disabled. */
+    auto replace_page(std::size_t index, std::unique_ptr<Child_t> page)
+        -> Child_t&
+    {
+        auto old = this->remove_child_at(index);
+        System::post_event(Delete_event{std::move(old)});
+        return this->insert_page(std::move(page), index);
+    }
+
+    [[nodiscard]] auto index_of(Widget const& page) const -> std::size_t
+    {
+        auto const& children = this->get_children();
+        auto i               = std::size_t{0};
+        while (i < children.size() && &children[i] != &page)
+            ++i;
+        return i;
+    }
 
    private:
     void move_active_page()
@@ -2,6 +2,7 @@
 #define TERMOX_WIDGET_PAIR_HPP
 #include <memory>
 
+#include <termox/widget/layouts/detail/static_geometry.hpp>
 #include <termox/widget/layouts/horizontal.hpp>
 #include <termox/widget/layouts/stack.hpp>
 #include <termox/widget/layouts/vertical.hpp>
@@ -10,8 +11,9 @@
 namespace ox {
 
 /// Heterogeneous pair of Widgets within a Layout.
+/** Linear Layouts of fixed size Widgets are laid out by Static_geometry. */
 template <typename Layout_t, typename First, typename Second>
-struct Pair : Layout_t {
+struct Pair : layout::detail::Static_geometry<Layout_t, 2> {
    public:
     struct Parameters {
         typename First::Parameters first;
@@ -44,7 +46,8 @@ struct Pair : Layout_t {
 
     /// Existing Widgets are moved into the Pair.
     Pair(std::unique_ptr<First> a, std::unique_ptr<Second> b)
-        : Layout_t{std::move(a), std::move(b)},
+        : layout::detail::Static_geometry<Layout_t, 2>{std::move(a),
+                                                       std::move(b)},
           first{static_cast<First&>(this->get_children()[0])},
           second{static_cast<Second&>(this->get_children()[1])}
     {}
@@ -18,8 +18,10 @@
 #include <termox/widget/bordered.hpp>
 #include <termox/widget/detail/pipe_utility.hpp>
 #include <termox/widget/focus_policy.hpp>
+#include <termox/widget/framed.hpp>
 #include <termox/widget/growth.hpp>
 #include <termox/widget/point.hpp>
+#include <termox/widget/select.hpp>
 #include <termox/widget/widget.hpp>
 #include <termox/widget/wrap.hpp>
 #include "termox/widget/size_policy.hpp"
@@ -60,12 +62,22 @@ template <typename F>
 }
 
 /// Filter by name of Widget
+/** Scans a Range of children, use select() to search all descendants. */
 [[nodiscard]] inline auto find(std::string const& name)
 {
     return pipe::detail::Filter_predicate{
         [=](auto const& w) { return w.name() == name; }};
 }
 
+/// Widget -> std::vector<Widget*> of descendants matching \p selector.
+/** Uses the Widget index, see ox::select() for the selector syntax. */
+[[nodiscard]] inline auto select(std::string selector)
+{
+    return [s = std::move(selector)](auto&& w) {
+        return ::ox::select(get(w), s);
+    };
+}
+
 /// Dynamic cast, be aware.
 template <typename Widget_t>
 [[nodiscard]] auto filter()
@@ -147,6 +159,15 @@ template <typename Widget_t>
     };
 }
 
+// Style Modifiers -------------------------------------------------------------
+[[nodiscard]] inline auto style_class(std::string name)
+{
+    return [name = std::move(name)](auto&& w) -> decltype(auto) {
+        get(w).set_style_class(name);
+        return std::forward<decltype(w)>(w);
+    };
+}
+
 }  // namespace ox::pipe
 
 namespace ox {
@@ -248,6 +269,63 @@ auto operator|(std::unique_ptr<Bordered<Widget_t>> w_ptr, Foreground_color fg)
     return std::move(w_ptr);
 }
 
+template <
+    typename Widget_t,
+    typename std::enable_if_t<pipe::detail::is_widget_v<Widget_t>, int> = 0>
+auto operator|(Framed<Widget_t>& w, ox::Border const& b) -> Framed<Widget_t>&
+{
+    w.set_border(b);
+    return w;
+}
+
+template <
+    typename Widget_t,
+    typename std::enable_if_t<pipe::detail::is_widget_v<Widget_t>, int> = 0>
+auto operator|(std::unique_ptr<Framed<Widget_t>> w_ptr, ox::Border const& b)
+    -> std::unique_ptr<Framed<Widget_t>>
+{
+    w_ptr->set_border(b);
+    return w_ptr;
+}
+
+template <
+    typename Widget_t,
+    typename std::enable_if_t<pipe::detail::is_widget_v<Widget_t>, int> = 0>
+auto operator|(Framed<Widget_t>& w, Background_color bg) -> Framed<Widget_t>&
+{
+    w.set_border(w.Framed<Widget_t>::border() | bg);
+    return w;
+}
+
+template <
+    typename Widget_t,
+    typename std::enable_if_t<pipe::detail::is_widget_v<Widget_t>, int> = 0>
+auto operator|(std::unique_ptr<Framed<Widget_t>> w_ptr, Background_color bg)
+    -> std::unique_ptr<Framed<Widget_t>>
+{
+    w_ptr->set_border(w_ptr->Framed<Widget_t>::border() | bg);
+    return w_ptr;
+}
+
+template <
+    typename Widget_t,
+    typename std::enable_if_t<pipe::detail::is_widget_v<Widget_t>, int> = 0>
+auto operator|(Framed<Widget_t>& w, Foreground_color fg) -> Framed<Widget_t>&
+{
+    w.set_border(w.Framed<Widget_t>::border() | fg);
+    return w;
+}
+
+template <
+    typename Widget_t,
+    typename std::enable_if_t<pipe::detail::is_widget_v<Widget_t>, int> = 0>
+auto operator|(std::unique_ptr<Framed<Widget_t>> w_ptr, Foreground_color fg)
+    -> std::unique_ptr<Framed<Widget_t>>
+{
+    w_ptr->set_border(w_ptr->Framed<Widget_t>::border() | fg);
+    return w_ptr;
+}
+
 }  // namespace ox
 
 namespace ox::pipe {
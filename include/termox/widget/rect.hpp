@@ -0,0 +1,62 @@
+#ifndef TERMOX_WIDGET_RECT_HPP
+#define TERMOX_WIDGET_RECT_HPP
+#include <algorithm>
+
+#include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+
+namespace ox {
+
+/// Rectangular region of cells, starting at the inclusive \p top_left.
+struct Rect {
+    Point top_left = {0, 0};
+    Area area      = {0, 0};
+};
+
+/// Return true if \p r does not contain any cells.
+[[nodiscard]] inline auto is_empty(Rect r) -> bool
+{
+    return r.area.width <= 0 || r.area.height <= 0;
+}
+
+/// Return true if Point \p p is within \p r.
+[[nodiscard]] inline auto contains(Rect r, Point p) -> bool
+{
+    return p.x >= r.top_left.x && p.y >= r.top_left.y &&
+           p.x < r.top_left.x + r.area.width &&
+           p.y < r.top_left.y + r.area.height;
+}
+
+/// Return the cells that are within both \p a and \p b, can be empty.
+[[nodiscard]] inline auto intersection(Rect a, Rect b) -> Rect
+{
+    auto const x     = std::max(a.top_left.x, b.top_left.x);
+    auto const y     = std::max(a.top_left.y, b.top_left.y);
+    auto const x_end = std::min(a.top_left.x + a.area.width,
+                                b.top_left.x + b.area.width);
+    auto const y_end = std::min(a.top_left.y + a.area.height,
+                                b.top_left.y + b.area.height);
+    if (x_end <= x || y_end <= y)
+        return {};
+    return {{x, y}, {x_end - x, y_end - y}};
+}
+
+/// Return the smallest Rect containing both \p a and \p b.
+/** An empty Rect does not contribute to the result. */
+[[nodiscard]] inline auto bounding(Rect a, Rect b) -> Rect
+{
+    if (is_empty(a))
+        return b;
+    if (is_empty(b))
+        return a;
+    auto const x     = std::min(a.top_left.x, b.top_left.x);
+    auto const y     = std::min(a.top_left.y, b.top_left.y);
+    auto const x_end = std::max(a.top_left.x + a.area.width,
+                                b.top_left.x + b.area.width);
+    auto const y_end = std::max(a.top_left.y + a.area.height,
+                                b.top_left.y + b.area.height);
+    return {{x, y}, {x_end - x, y_end - y}};
+}
+
+}  // namespace ox
+#endif  // TERMOX_WIDGET_RECT_HPP
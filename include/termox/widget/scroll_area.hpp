@@ -0,0 +1,238 @@
+#ifndef TERMOX_WIDGET_SCROLL_AREA_HPP
+#define TERMOX_WIDGET_SCROLL_AREA_HPP
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <signals_light/signal.hpp>
+
+#include <termox/system/event.hpp>
+#include <termox/system/mouse.hpp>
+#include <termox/system/system.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace ox {
+
+/// Viewport onto Widget_t, which is given a larger, virtual, content area.
+/** The wrapped Widget is the only child, it is sized to the content area and
+ *  moved by the scroll offset, so that the visible part of it lines up with
+ *  this Widget. Descendants are clipped to the viewport, those that are
+ *  entirely outside of it are not painted at all. Scrolling only moves the
+ *  wrapped Widget, it is not resized. Each dimension of the content area is
+ *  at least as large as the viewport. The mouse wheel over wrapped scrolls. */
+template <typename Widget_t>
+class Scroll_area : public Widget {
+    static_assert(std::is_base_of<Widget, Widget_t>::value,
+                  "Scroll_area: Widget_t must be a Widget type");
+
+   public:
+    struct Parameters {
+        Area content_area;
+        typename Widget_t::Parameters wrapped_parameters;
+    };
+
+   public:
+    Widget_t& wrapped;
+
+    /// Emitted with the new offset each time it changes.
+    sl::Signal<void(Point)> scrolled;
+
+   public:
+    template <typename... Args>
+    explicit Scroll_area(Area content_area, Args&&... wrapped_args)
+        : wrapped{this->adopt(
+              std::make_unique<Widget_t>(std::forward<Args>(wrapped_args)...))},
+          content_{content_area}
+    {
+        this->initialize();
+    }
+
+    Scroll_area() : wrapped{this->adopt(std::make_unique<Widget_t>())}
+    {
+        this->initialize();
+    }
+
+    explicit Scroll_area(Parameters p)
+        : Scroll_area{p.content_area, std::move(p.wrapped_parameters)}
+    {}
+
+    /// Create a Scroll_area around an existing Widget.
+    explicit Scroll_area(std::unique_ptr<Widget_t> w_ptr,
+                         Area content_area = {0, 0})
+        : wrapped{this->adopt(std::move(w_ptr))}, content_{content_area}
+    {
+        this->initialize();
+    }
+
+   public:
+    /// Set the area given to wrapped, expanded to at least the viewport.
+    void set_content_area(Area a)
+    {
+        content_ = a;
+        this->place_wrapped();
+        this->set_offset(offset_);
+    }
+
+    /// Return the area given to wrapped.
+    [[nodiscard]] auto content_area() const -> Area
+    {
+        return {std::max(content_.width, this->area().width),
+                std::max(content_.height, this->area().height)};
+    }
+
+    /// Scroll so \p p of the content area is at the top left of the viewport.
+    /** \p p is clamped so the viewport stays within the content area. */
+    void set_offset(Point p)
+    {
+        auto const content  = this->content_area();
+        auto const viewport = this->area();
+        p.x = std::clamp(p.x, 0, std::max(0, content.width - viewport.width));
+        p.y = std::clamp(p.y, 0, std::max(0, content.height - viewport.height));
+        if (p == offset_)
+            return;
+        offset_ = p;
+        this->move_wrapped();
+        scrolled.emit(offset_);
+    }
+
+    /// Return the point of the content area at the top left of the viewport.
+    [[nodiscard]] auto offset() const -> Point { return offset_; }
+
+    /// Scroll the viewport up by \p n cells.
+    void scroll_up(int n = 1) { this->set_offset({offset_.x, offset_.y - n}); }
+
+    /// Scroll the viewport down by \p n cells.
+    void scroll_down(int n = 1)
+    {
+        this->set_offset({offset_.x, offset_.y + n});
+    }
+
+    /// Scroll the viewport left by \p n cells.
+    void scroll_left(int n = 1)
+    {
+        this->set_offset({offset_.x - n, offset_.y});
+    }
+
+    /// Scroll the viewport right by \p n cells.
+    void scroll_right(int n = 1)
+    {
+        this->set_offset({offset_.x + n, offset_.y});
+    }
+
+    /// Descendants are clipped to the viewport.
+    [[nodiscard]] auto clips_children() const -> bool final override
+    {
+        return true;
+    }
+
+   protected:
+    auto enable_event() -> bool override
+    {
+        this->place_wrapped();
+        return Widget::enable_event();
+    }
+
+    auto disable_event() -> bool override
+    {
+        wrapped.disable();
+        return Widget::disable_event();
+    }
+
+    auto move_event(Point new_position, Point old_position) -> bool override
+    {
+        this->move_wrapped();
+        return Widget::move_event(new_position, old_position);
+    }
+
+    auto resize_event(Area new_size, Area old_size) -> bool override
+    {
+        this->place_wrapped();
+        this->set_offset(offset_);
+        return Widget::resize_event(new_size, old_size);
+    }
+
+    auto mouse_wheel_event_filter(Widget& receiver, Mouse const& m)
+        -> bool override
+    {
+        switch (m.button) {
+            case Mouse::Button::ScrollUp: this->scroll_up(); return true;
+            case Mouse::Button::ScrollDown: this->scroll_down(); return true;
+            default:
+                return Widget::mouse_wheel_event_filter(receiver, m);
+        }
+    }
+
+   private:
+    Area content_ = {0, 0};
+    Point offset_ = {0, 0};
+
+   private:
+    /// Make \p w the only child of *this, and return a reference to it.
+    auto adopt(std::unique_ptr<Widget_t> w) -> Widget_t&
+    {
+        auto& child = *w;
+        children_.push_back(std::move(w));
+        child.set_parent(this);
+        return child;
+    }
+
+    /// Move wrapped so that offset_ is at the top left of the viewport.
+    void move_wrapped()
+    {
+        if (!this->is_enabled())
+            return;
+        System::post_event(Move_event{wrapped, this->top_left() - offset_});
+    }
+
+    /// Enable, move and resize wrapped to the content area.
+    void place_wrapped()
+    {
+        if (!this->is_enabled())
+            return;
+        wrapped.enable();
+        this->move_wrapped();
+        System::post_event(Resize_event{wrapped, this->content_area()});
+    }
+
+    void initialize()
+    {
+        // Can't use pipe:: in this file.
+        this->focus_policy = wrapped.focus_policy;
+        this->focused_in.connect([&] { System::set_focus(wrapped); });
+        wrapped.install_event_filter(*this);
+    }
+};
+
+/// Helper function to create an instance of Scroll_area<Widget_t>.
+template <typename Widget_t>
+[[nodiscard]] auto scroll_area(typename Scroll_area<Widget_t>::Parameters p)
+    -> std::unique_ptr<Scroll_area<Widget_t>>
+{
+    return std::make_unique<Scroll_area<Widget_t>>(std::move(p));
+}
+
+/// Helper function to create an instance of Scroll_area<Widget_t>.
+template <typename Widget_t, typename... Args>
+[[nodiscard]] auto scroll_area(Area content_area = {0, 0},
+                               Args&&... wrapped_args)
+    -> std::unique_ptr<Scroll_area<Widget_t>>
+{
+    return std::make_unique<Scroll_area<Widget_t>>(
+        content_area, std::forward<Args>(wrapped_args)...);
+}
+
+/// Helper function to create an instance of Scroll_area<Widget_t>.
+template <typename Widget_t>
+[[nodiscard]] auto scroll_area(std::unique_ptr<Widget_t> w_ptr,
+                               Area content_area = {0, 0})
+    -> std::unique_ptr<Scroll_area<Widget_t>>
+{
+    return std::make_unique<Scroll_area<Widget_t>>(std::move(w_ptr),
+                                                   content_area);
+}
+
+}  // namespace ox
+#endif  // TERMOX_WIDGET_SCROLL_AREA_HPP
@@ -0,0 +1,24 @@
+#ifndef TERMOX_WIDGET_SELECT_HPP
+#define TERMOX_WIDGET_SELECT_HPP
+#include <string_view>
+#include <vector>
+
+namespace ox {
+class Widget;
+
+/// Return the descendants of \p root that match \p selector.
+/** A selector is a whitespace separated list of compounds, each compound is a
+ *  type name, a '#' followed by a Widget name, or both, as in "Label#title".
+ *  Each compound after the first must match a descendant of a Widget that
+ *  matches the compound before it, as in "#status Label". Type names are the
+ *  unqualified class name of the most derived type, without template
+ *  arguments; base classes do not match. Resolved with the Widget name and
+ *  type index, rather than walking the tree from \p root, and only Widgets
+ *  constructed in the calling thread's current Session are considered. The
+ *  order of the returned Widgets is unspecified. Throws std::invalid_argument
+ *  if \p selector is empty or malformed. */
+[[nodiscard]] auto select(Widget const& root, std::string_view selector)
+    -> std::vector<Widget*>;
+
+}  // namespace ox
+#endif  // TERMOX_WIDGET_SELECT_HPP
@@ -5,6 +5,7 @@
 #include <type_traits>
 #include <utility>
 
+#include <termox/widget/layouts/detail/static_geometry.hpp>
 #include <termox/widget/layouts/horizontal.hpp>
 #include <termox/widget/layouts/stack.hpp>
 #include <termox/widget/layouts/vertical.hpp>
@@ -12,9 +13,11 @@
 namespace ox {
 
 /// Heterogeneous collection of Widgets within a Layout_t.
-/** Widgets are added to Layout_t in the order that Widget_t types are given. */
+/** Widgets are added to Layout_t in the order that Widget_t types are given.
+ *  Linear Layouts of fixed size Widgets are laid out by Static_geometry. */
 template <typename Layout_t, typename... Widget_t>
-class Tuple : public Layout_t {
+class Tuple
+    : public layout::detail::Static_geometry<Layout_t, sizeof...(Widget_t)> {
    public:
     using Parameters = std::tuple<typename Widget_t::Parameters...>;
 
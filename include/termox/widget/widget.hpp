@@ -13,6 +13,7 @@
 #include <signals_light/signal.hpp>
 
 #include <termox/common/fps.hpp>
+#include <termox/common/timer.hpp>
 #include <termox/common/transform_view.hpp>
 #include <termox/painter/brush.hpp>
 #include <termox/painter/color.hpp>
@@ -24,6 +25,7 @@
 #include <termox/widget/cursor.hpp>
 #include <termox/widget/focus_policy.hpp>
 #include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
 #include <termox/widget/size_policy.hpp>
 
 namespace ox {
@@ -121,7 +123,7 @@ class Widget {
     /// Create an empty Widget.
     explicit Widget(Parameters p);
 
-    virtual ~Widget() = default;
+    virtual ~Widget();
 
     // Widgets are exclusively owned by std::unique_ptrs and sl::Slots often
     // depend on Widget references to remain valid, copying and moving would
@@ -172,10 +174,30 @@ class Widget {
     /// Post a paint event to this Widget.
     virtual void update();
 
+    /// Post a paint event to this Widget, repainting only the \p damage region.
+    /** \p damage is in local coordinates and is clipped to the Widget. Calls
+     *  made before the Paint_event is processed accumulate as their bounding
+     *  Rect. A call to update() takes precedence and repaints everything. */
+    void update(Rect damage);
+
+    /// Return the region the next Paint_event will repaint, local coordinates.
+    [[nodiscard]] auto damage() const -> Rect;
+
     /** Used by is_paintable to decide whether or not to send a Paint_event.
      *  This is a type parameter, Layout is the only thing that can't paint. */
     [[nodiscard]] virtual auto is_layout_type() const -> bool;
 
+    /// Return true if descendants are only shown within this Widget's area.
+    /** Used by Scroll_area, whose child is larger than itself. Painting and
+     *  Paint_events of descendants are clipped to this Widget. */
+    [[nodiscard]] virtual auto clips_children() const -> bool;
+
+    /// Return the local region that a child always paints over.
+    /** Used by Framed, the Painter does not wallpaper fill this region, so
+     *  repainting this Widget does not cover the child and the child does not
+     *  have to be repainted with it. Defaults to an empty Rect. */
+    [[nodiscard]] virtual auto covered_region() const -> Rect;
+
     /// Install another Widget as an Event filter.
     /** The installed Widget will get the first go at processing the event with
      *  its filter event handler function. Widgets are installed in the order
@@ -197,7 +219,7 @@ class Widget {
      *  handled on a separate thread from the main user input thread, and has
      *  its own staged_changes object that it paints to to avoid shared data
      *  issues. */
-    void enable_animation(std::chrono::milliseconds interval);
+    void enable_animation(std::chrono::nanoseconds interval);
 
     /// Enable animation with a frames-per-second value.
     void enable_animation(FPS fps);
@@ -210,6 +232,11 @@ class Widget {
     /// Return true if this Widget has animation enabled.
     [[nodiscard]] auto is_animated() const -> bool;
 
+    /// Return the timing of the most recent Timer_event sent to this Widget.
+    /** Read from timer_event() to find how late the current frame is, and how
+     *  many animation steps it should advance by. */
+    [[nodiscard]] auto frame_time() const -> Frame_time const&;
+
     /// Get a range containing Widget& to each child.
     [[nodiscard]] auto get_children()
     {
@@ -237,6 +264,21 @@ class Widget {
     /// If true, the brush will apply to the wallpaper Glyph.
     [[nodiscard]] auto paints_wallpaper_with_brush() const -> bool;
 
+    /// Set the style class that this Widget and its descendants inherit.
+    /** See Styles. The default, an empty \p name, inherits only the parent's
+     *  style. Repaints each Widget of this tree whose effective_brush() has
+     *  changed. */
+    void set_style_class(std::string name);
+
+    /// Return the name set with set_style_class().
+    [[nodiscard]] auto style_class() const -> std::string const&;
+
+    /// Return brush merged over the style inherited along the Widget tree.
+    /** This is the Brush that Painter applies. The inherited style is resolved
+     *  once and cached until a style class changes or the Widget is given a
+     *  new parent. */
+    [[nodiscard]] auto effective_brush() const -> Brush;
+
     /// Return the wallpaper Glyph.
     /** The Glyph has the brush applied to it, if brush_paints_wallpaper is set
      *  to true. */
@@ -392,8 +434,20 @@ class Widget {
     // The entire area of the widget.
     Area area_ = {0, 0};
 
+    // Accumulated from update(Rect), empty or full_damage_ repaints everything.
+    Rect damage_      = {};
+    bool full_damage_ = false;
+
     std::uint16_t const unique_id_;
 
+    std::string style_class_;
+
+    // The style class Brushes of *this and each ancestor, merged.
+    mutable Brush style_;
+    mutable bool is_style_resolved_ = false;
+
+    Frame_time frame_time_;
+
    public:
     /// Should only be used by Move_event send() function.
     void set_top_left(Point p);
@@ -401,8 +455,25 @@ class Widget {
     /// Should only be used by Resize_event send() function.
     void set_area(Area a);
 
+    /// Should only be used by Timer_event send() function.
+    void set_frame_time(Frame_time t);
+
+    /// Should only be used by System::send_event(Paint_event).
+    void clear_damage();
+
     /// Should only be used by Layout.
     void set_parent(Widget* parent);
+
+    /// Should only be used by Styles, resolves the style of this tree again.
+    /** Repaints each Widget whose effective_brush() has changed. */
+    void restyle();
+
+   private:
+    /// Return style_, resolving it from the parent's style if needed.
+    [[nodiscard]] auto style() const -> Brush;
+
+    /// Drop the resolved style of this Widget and all of its descendants.
+    void invalidate_style();
 };
 
 /// Helper function to create a Widget instance.
@@ -118,7 +118,10 @@ class Banner : public Widget {
 
     auto timer_event() -> bool override
     {
-        range_ = animator_();
+        // A stopped Animator disables animation, no more steps after that.
+        auto const steps = this->frame_time().steps;
+        for (auto i = 0; i < steps && this->is_animated(); ++i)
+            range_ = animator_();
         this->update();
         return Widget::timer_event();
     }
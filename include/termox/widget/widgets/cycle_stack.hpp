@@ -82,6 +82,29 @@ class Cycle_stack : public VPair<detail::CS_top_row, layout::Stack<Child>> {
             stack.set_active_page(0);
         return child;
     }
+
+    /// Append a page that is built by \p make when it first becomes active.
+    /** \p title is passed to the Cycle_box associated with this page. */
+    void append_lazy_page(Glyph_string title,
+                          typename layout::Stack<Child>::Page_factory make)
+    {
+        auto& signal = top_row.cycle_box.add_option(std::move(title));
+        signal.connect(slot::set_active_page(stack, stack.size()));
+        stack.append_lazy_page(std::move(make));
+        if (stack.size() == 1)
+            stack.set_active_page(0);
+    }
+
+    /// Append a lazy page that constructs a Widget_t from copies of \p args.
+    template <typename Widget_t = Child, typename... Args>
+    void make_lazy_page(Glyph_string title, Args&&... args)
+    {
+        auto& signal = top_row.cycle_box.add_option(std::move(title));
+        signal.connect(slot::set_active_page(stack, stack.size()));
+        stack.template make_lazy_page<Widget_t>(std::forward<Args>(args)...);
+        if (stack.size() == 1)
+            stack.set_active_page(0);
+    }
 };
 
 /// Helper function to create a Cycle_stack instance.
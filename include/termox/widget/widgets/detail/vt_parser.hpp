@@ -0,0 +1,78 @@
+#ifndef TERMOX_WIDGET_WIDGETS_DETAIL_VT_PARSER_HPP
+#define TERMOX_WIDGET_WIDGETS_DETAIL_VT_PARSER_HPP
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace ox::detail {
+class Vt_screen;
+
+/// Parameters and marker bytes of a single escape sequence.
+struct Vt_sequence {
+    /// Parameters past this count are dropped.
+    static auto constexpr max_params = 16;
+
+    std::array<int, max_params> params = {};
+
+    int param_count     = 0;
+    char private_marker = '\0';  // One of "<=>?", or '\0' if none.
+    char intermediate   = '\0';  // The last intermediate byte, or '\0'.
+
+    /// Return the number of parameters stored.
+    [[nodiscard]] auto size() const -> int
+    {
+        return param_count < max_params ? param_count : max_params;
+    }
+
+    /// Return parameter \p i, or \p fallback if it is missing or zero.
+    [[nodiscard]] auto get(int i, int fallback) const -> int
+    {
+        return (i < this->size() && params[i] != 0) ? params[i] : fallback;
+    }
+};
+
+/// Table driven VT500 style parser for the output of a terminal application.
+/** Follows the DEC ANSI parser state machine, with UTF-8 decoding in the
+ *  Ground state. Input is parsed in place and parameters are kept in a fixed
+ *  size Vt_sequence, so parsing never allocates. Runs of printable ASCII are
+ *  handed to the Vt_screen as a single string_view. OSC, DCS, SOS, PM and APC
+ *  strings are consumed and ignored. */
+class Vt_parser {
+   public:
+    enum class State : std::uint8_t {
+        Ground,
+        Escape,
+        Escape_intermediate,
+        Csi_entry,
+        Csi_param,
+        Csi_intermediate,
+        Csi_ignore,
+        Osc_string,
+        String_ignore,
+    };
+
+   public:
+    /// Parse \p bytes and apply each complete sequence to \p screen.
+    /** A sequence or UTF-8 character split across calls is resumed on the
+     *  next call. */
+    void parse(std::string_view bytes, Vt_screen& screen);
+
+    /// Return to the Ground state, dropping any partial sequence.
+    void reset();
+
+    /// Return the current state of the parser.
+    [[nodiscard]] auto state() const -> State;
+
+   private:
+    State state_ = State::Ground;
+    Vt_sequence sequence_;
+    char32_t codepoint_ = U'\0';
+    int utf8_remaining_ = 0;
+
+   private:
+    /// Decode one byte of a multi-byte UTF-8 character.
+    void decode_utf8(std::uint8_t byte, Vt_screen& screen);
+};
+
+}  // namespace ox::detail
+#endif  // TERMOX_WIDGET_WIDGETS_DETAIL_VT_PARSER_HPP
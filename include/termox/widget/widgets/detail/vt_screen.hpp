@@ -0,0 +1,197 @@
+#ifndef TERMOX_WIDGET_WIDGETS_DETAIL_VT_SCREEN_HPP
+#define TERMOX_WIDGET_WIDGETS_DETAIL_VT_SCREEN_HPP
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <termox/painter/brush.hpp>
+#include <termox/painter/color.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/widgets/detail/vt_parser.hpp>
+
+namespace ox::detail {
+
+/// The screen state of an emulated terminal, written to by Vt_parser.
+/** Holds a primary and an alternate Canvas, the cursor, the current Brush and
+ *  the scroll region. Each Canvas is a ring of rows, so scrolling the whole
+ *  screen moves a row offset instead of copying the Canvas. Rows that change
+ *  are marked as damaged until clear_damage() is called. SGR colors are xterm
+ *  palette indices, they are translated to Colors with a table set by
+ *  set_colors(). */
+class Vt_screen {
+   public:
+    /// Construct a blank screen of Area \p a, at least 1x1.
+    explicit Vt_screen(Area a);
+
+   public:
+    /// Put \p c at the cursor and advance the cursor, wrapping if enabled.
+    void print(char32_t c);
+
+    /// Put each char of \p ascii at the cursor, all are printable ASCII.
+    void print(std::string_view ascii);
+
+    /// Perform the C0 control character \p c.
+    void execute(char c);
+
+    /// Perform the escape sequence ESC \p intermediate \p final.
+    void esc_dispatch(char final, char intermediate);
+
+    /// Perform the control sequence CSI \p seq \p final.
+    void csi_dispatch(char final, Vt_sequence const& seq);
+
+   public:
+    /// Set the Color used for each of the 256 xterm palette indices.
+    /** Applies to colors set after this call, defaults to Color{index}. True
+     *  colors are quantized to the xterm palette and then looked up. */
+    void set_colors(std::vector<Color> colors);
+
+    /// Resize both screens to \p a, at least 1x1, keeping the cursor's row.
+    void resize(Area a);
+
+    /// Return the size of the screen.
+    [[nodiscard]] auto area() const -> Area;
+
+    /// Return the Glyph on screen at \p p.
+    [[nodiscard]] auto at(Point p) const -> Glyph;
+
+    /// Return the cursor position.
+    [[nodiscard]] auto cursor() const -> Point;
+
+    /// Return true if the application has not hidden the cursor.
+    [[nodiscard]] auto is_cursor_visible() const -> bool;
+
+    /// Return true if arrow keys should be sent as SS3 instead of CSI.
+    [[nodiscard]] auto is_application_cursor_keys() const -> bool;
+
+    /// Return true if any row has changed since the last clear_damage().
+    [[nodiscard]] auto is_damaged() const -> bool;
+
+    /// Return true if row \p y has changed since the last clear_damage().
+    [[nodiscard]] auto is_damaged(int y) const -> bool;
+
+    /// Mark every row as up to date.
+    void clear_damage();
+
+    /// Return the replies to device status and attribute requests.
+    /** These should be written back to the application, then cleared. */
+    [[nodiscard]] auto responses() const -> std::string_view;
+
+    /// Clear the stored responses.
+    void clear_responses();
+
+    /// Return to the initial state, with a blank primary screen.
+    void reset();
+
+   private:
+    /// A Canvas with its first row stored at physical row top_row.
+    struct Page {
+        Canvas cells;
+        int top_row = 0;
+    };
+
+    struct Saved_cursor {
+        Point position    = {0, 0};
+        Brush brush       = Brush{};
+        bool dec_graphics = false;
+        bool pending_wrap = false;
+    };
+
+    Page primary_;
+    Page alternate_;
+    bool on_alternate_ = false;
+
+    Point cursor_ = {0, 0};
+    Brush brush_  = Brush{};
+    Saved_cursor saved_;
+    int scroll_top_;
+    int scroll_bottom_;
+    char32_t last_printed_ = U' ';
+
+    bool pending_wrap_    = false;
+    bool autowrap_        = true;
+    bool cursor_visible_  = true;
+    bool app_cursor_keys_ = false;
+    bool dec_graphics_    = false;
+
+    std::vector<Color> colors_;
+    std::vector<std::uint8_t> damaged_rows_;
+    bool damaged_ = true;
+    std::string responses_;
+
+   private:
+    /// Return the active Page.
+    [[nodiscard]] auto page() -> Page&;
+
+    /// Return the active Page.
+    [[nodiscard]] auto page() const -> Page const&;
+
+    /// Return a pointer to the first Glyph of row \p y of the active Page.
+    [[nodiscard]] auto row(int y) -> Glyph*;
+
+    /// Return a pointer to the first Glyph of row \p y of the active Page.
+    [[nodiscard]] auto row(int y) const -> Glyph const*;
+
+    /// Return the Glyph used to erase cells, with the current background.
+    [[nodiscard]] auto blank() const -> Glyph;
+
+    void damage(int y);
+
+    void damage_all();
+
+    /// Move to the start of the next line if the last print hit the margin.
+    void wrap_if_pending();
+
+    /// Move the cursor, clamped to the screen, clears any pending wrap.
+    void move_to(Point p);
+
+    /// Move down a line, scrolling if the cursor is at the scroll bottom.
+    void index();
+
+    /// Move up a line, scrolling if the cursor is at the scroll top.
+    void reverse_index();
+
+    /// Scroll rows [top, bottom] up by \p n, blanking the bottom rows.
+    void scroll_up(int top, int bottom, int n);
+
+    /// Scroll rows [top, bottom] down by \p n, blanking the top rows.
+    void scroll_down(int top, int bottom, int n);
+
+    /// Blank cells [first, last) of row \p y.
+    void erase(int y, int first, int last);
+
+    /// Insert \p n blank cells at the cursor, shifting the rest right.
+    void insert_cells(int n);
+
+    /// Delete \p n cells at the cursor, shifting the rest left.
+    void delete_cells(int n);
+
+    void erase_in_display(int mode);
+
+    void erase_in_line(int mode);
+
+    void set_private_mode(int mode, bool enable);
+
+    void set_graphic_rendition(Vt_sequence const& seq);
+
+    void save_cursor();
+
+    void restore_cursor();
+
+    void use_alternate_page(bool enable);
+
+    /// Return the index into \p page's Canvas of row \p y on screen.
+    [[nodiscard]] static auto physical_row(Page const& page, int y) -> int;
+
+    /// Rotate \p page so that its top_row is zero.
+    static void linearize(Page& page);
+
+    /// Resize \p page to \p a, filling new cells with blanks.
+    static void resize_page(Page& page, Area a);
+};
+
+}  // namespace ox::detail
+#endif  // TERMOX_WIDGET_WIDGETS_DETAIL_VT_SCREEN_HPP
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -15,6 +16,7 @@
 #include <termox/painter/painter.hpp>
 #include <termox/widget/boundary.hpp>
 #include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
 #include <termox/widget/widget.hpp>
 
 namespace ox {
@@ -87,11 +89,12 @@ class Graph : public Widget {
         this->update();
     }
 
-    /// Add a single Coordinate to the Graph.
+    /// Add a single Coordinate to the Graph, repainting only its cell.
     void add(Coordinate c)
     {
         coordinates_.push_back(c);
-        this->update();
+        if (auto const offset = this->offset_of(c.x, c.y); offset)
+            this->update({{(int)offset->x, (int)offset->y}, {1, 1}});
     }
 
     /// Remove all points from the Graph and repaint.
@@ -110,22 +113,15 @@ class Graph : public Widget {
    protected:
     auto paint_event(Painter& p) -> bool override
     {
-        auto const area = this->area();
-        auto const h_ratio =
-            (double)area.width / distance(boundary_.west, boundary_.east);
-        auto const v_ratio =
-            (double)area.height / distance(boundary_.south, boundary_.north);
-
+        auto const clip = p.clip();
         for (auto const c : coordinates_) {
-            auto const h_offset = h_ratio * distance(boundary_.west, c.x);
-            auto const v_offset =
-                area.height - v_ratio * distance(boundary_.south, c.y);
-            if (h_offset >= area.width)  // h_offset already can't be negative.
+            auto const offset = this->offset_of(c.x, c.y);
+            if (!offset)
                 continue;
-            if (v_offset >= area.height || v_offset < 0)
+            auto const point = Point{(int)offset->x, (int)offset->y};
+            if (!contains(clip, point))
                 continue;
-            auto const point = Point{(int)h_offset, (int)v_offset};
-            auto const mask  = this->to_cell_mask(h_offset, v_offset);
+            auto const mask = this->to_cell_mask(offset->x, offset->y);
             auto current     = p.at(point);
             current.symbol   = combine(current.symbol, mask);
             p.put(current, point);
@@ -137,6 +133,33 @@ class Graph : public Widget {
     Boundary<Number_t> boundary_;
     std::vector<Coordinate> coordinates_;
 
+   private:
+    /// Offset from the top left of the Widget, in fractional cells.
+    struct Offset {
+        double x;
+        double y;
+    };
+
+   private:
+    /// Return the Offset of Coordinate {\p x, \p y}, if it is displayed.
+    [[nodiscard]] auto offset_of(Number_t x, Number_t y) const
+        -> std::optional<Offset>
+    {
+        auto const area = this->area();
+        auto const h_ratio =
+            (double)area.width / distance(boundary_.west, boundary_.east);
+        auto const v_ratio =
+            (double)area.height / distance(boundary_.south, boundary_.north);
+        auto const h_offset = h_ratio * distance(boundary_.west, x);
+        auto const v_offset =
+            area.height - v_ratio * distance(boundary_.south, y);
+        if (h_offset >= area.width || h_offset < 0)
+            return std::nullopt;
+        if (v_offset >= area.height || v_offset < 0)
+            return std::nullopt;
+        return Offset{h_offset, v_offset};
+    }
+
    private:
     /// Finds the distance between two values. It's just subtraction.
     [[nodiscard]] static auto distance(Number_t smaller, Number_t larger)
@@ -268,11 +291,13 @@ class Color_graph : public Widget {
         this->update();
     }
 
-    /// Add a single <Coordinate, Color> to the Graph.
+    /// Add a single <Coordinate, Color> to the Graph, repainting its cell.
     void add(std::pair<Coordinate, Color> p)
     {
         coordinates_.push_back(p);
-        this->update();
+        auto const offset = this->offset_of(p.first.x, p.first.y);
+        if (offset)
+            this->update({{(int)offset->x, (int)offset->y}, {1, 1}});
     }
 
     /// Remove all points from the Graph and repaint.
@@ -292,22 +317,15 @@ class Color_graph : public Widget {
    protected:
     auto paint_event(Painter& p) -> bool override
     {
-        auto const area = this->area();
-        auto const h_ratio =
-            (double)area.width / distance(boundary_.west, boundary_.east);
-        auto const v_ratio =
-            (double)area.height / distance(boundary_.south, boundary_.north);
-
+        auto const clip = p.clip();
         for (auto const& [coord, color] : coordinates_) {
-            auto const h_offset = h_ratio * distance(boundary_.west, coord.x);
-            auto const v_offset =
-                area.height - v_ratio * distance(boundary_.south, coord.y);
-            if (h_offset >= area.width)  // h_offset already can't be negative.
+            auto const offset = this->offset_of(coord.x, coord.y);
+            if (!offset)
                 continue;
-            if (v_offset >= area.height || v_offset < 0)
+            auto const point = Point{(int)offset->x, (int)offset->y};
+            if (!contains(clip, point))
                 continue;
-            auto const point  = Point{(int)h_offset, (int)v_offset};
-            auto const is_top = is_top_region(v_offset);
+            auto const is_top = is_top_region(offset->y);
             auto const glyph  = combine(p.at(point), is_top, color);
             p.put(glyph, point);
         }
@@ -318,6 +336,33 @@ class Color_graph : public Widget {
     Boundary<Number_t> boundary_;
     std::vector<std::pair<Coordinate, Color>> coordinates_;
 
+   private:
+    /// Offset from the top left of the Widget, in fractional cells.
+    struct Offset {
+        double x;
+        double y;
+    };
+
+   private:
+    /// Return the Offset of Coordinate {\p x, \p y}, if it is displayed.
+    [[nodiscard]] auto offset_of(Number_t x, Number_t y) const
+        -> std::optional<Offset>
+    {
+        auto const area = this->area();
+        auto const h_ratio =
+            (double)area.width / distance(boundary_.west, boundary_.east);
+        auto const v_ratio =
+            (double)area.height / distance(boundary_.south, boundary_.north);
+        auto const h_offset = h_ratio * distance(boundary_.west, x);
+        auto const v_offset =
+            area.height - v_ratio * distance(boundary_.south, y);
+        if (h_offset >= area.width || h_offset < 0)
+            return std::nullopt;
+        if (v_offset >= area.height || v_offset < 0)
+            return std::nullopt;
+        return Offset{h_offset, v_offset};
+    }
+
    private:
     /// Finds the distance between two values. It's just subtraction.
     [[nodiscard]] static auto distance(Number_t smaller, Number_t larger)
@@ -429,11 +474,13 @@ class Color_graph_static_bounds : public Widget {
         this->update();
     }
 
-    /// Add a single <Coordinate, Color> to the Graph.
+    /// Add a single <Coordinate, Color> to the Graph, repainting its cell.
     void add(std::pair<Coordinate, Color> p)
     {
         coordinates_.push_back(p);
-        this->update();
+        auto const offset = this->offset_of(p.first.x, p.first.y);
+        if (offset)
+            this->update({{(int)offset->x, (int)offset->y}, {1, 1}});
     }
 
     /// Remove all points from the Graph and repaint.
@@ -453,24 +500,15 @@ class Color_graph_static_bounds : public Widget {
    protected:
     auto paint_event(Painter& p) -> bool override
     {
-        constexpr double h_distance = distance(boundary_.west, boundary_.east);
-        constexpr double v_distance =
-            distance(boundary_.south, boundary_.north);
-
-        auto const area    = this->area();
-        auto const h_ratio = (double)area.width / h_distance;
-        auto const v_ratio = (double)area.height / v_distance;
-
+        auto const clip = p.clip();
         for (auto const& [coord, color] : coordinates_) {
-            auto const h_offset = h_ratio * distance(boundary_.west, coord.x);
-            auto const v_offset =
-                area.height - (v_ratio * distance(boundary_.south, coord.y));
-            if (h_offset >= area.width)  // h_offset already can't be negative.
+            auto const offset = this->offset_of(coord.x, coord.y);
+            if (!offset)
                 continue;
-            if (v_offset >= area.height || v_offset < 0)
+            auto const point = Point{(int)offset->x, (int)offset->y};
+            if (!contains(clip, point))
                 continue;
-            auto const point  = Point{(int)h_offset, (int)v_offset};
-            auto const is_top = is_top_region(v_offset);
+            auto const is_top = is_top_region(offset->y);
             auto const glyph  = combine(p.at(point), is_top, color);
             p.put(glyph, point);
         }
@@ -483,6 +521,35 @@ class Color_graph_static_bounds : public Widget {
 
     std::vector<std::pair<Coordinate, Color>> coordinates_;
 
+   private:
+    /// Offset from the top left of the Widget, in fractional cells.
+    struct Offset {
+        double x;
+        double y;
+    };
+
+   private:
+    /// Return the Offset of Coordinate {\p x, \p y}, if it is displayed.
+    [[nodiscard]] auto offset_of(Number_t x, Number_t y) const
+        -> std::optional<Offset>
+    {
+        constexpr double h_distance = distance(boundary_.west, boundary_.east);
+        constexpr double v_distance =
+            distance(boundary_.south, boundary_.north);
+
+        auto const area     = this->area();
+        auto const h_ratio  = (double)area.width / h_distance;
+        auto const v_ratio  = (double)area.height / v_distance;
+        auto const h_offset = h_ratio * distance(boundary_.west, x);
+        auto const v_offset =
+            area.height - (v_ratio * distance(boundary_.south, y));
+        if (h_offset >= area.width || h_offset < 0)
+            return std::nullopt;
+        if (v_offset >= area.height || v_offset < 0)
+            return std::nullopt;
+        return Offset{h_offset, v_offset};
+    }
+
    private:
     /// Finds the distance between two values. It's just subtraction.
     [[nodiscard]] static constexpr auto distance(Number_t smaller,
@@ -2,13 +2,17 @@
 #define TERMOX_WIDGET_WIDGETS_MATRIX_VIEW_HPP
 #include <memory>
 
+#include <termox/painter/glyph.hpp>
 #include <termox/painter/glyph_matrix.hpp>
 #include <termox/painter/painter.hpp>
+#include <termox/widget/point.hpp>
 #include <termox/widget/widget.hpp>
 
 namespace ox {
 
 /// Displays a Glyph_matrix object
+/** Call update() after modifying the matrix directly, or use set_cell() to
+ *  only repaint the modified cell. */
 class Matrix_view : public Widget {
    public:
     struct Parameters {
@@ -23,6 +27,11 @@ class Matrix_view : public Widget {
 
     explicit Matrix_view(Parameters p);
 
+   public:
+    /// Assign \p g to the matrix at \p p and repaint only that cell.
+    /** Throws std::out_of_range if \p p is not within the matrix. */
+    void set_cell(Point p, Glyph g);
+
    protected:
     auto paint_event(Painter& p) -> bool override;
 };
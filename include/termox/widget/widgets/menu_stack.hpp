@@ -61,6 +61,21 @@ class Menu_stack : public layout::Stack<Widget> {
         this->connect_to_menu(std::move(title), this->Stack::size() - 1);
     }
 
+    /// Append a page that is built by \p make when it first becomes active.
+    void append_lazy_page(Glyph_string title, Page_factory make)
+    {
+        this->Stack::append_lazy_page(std::move(make));
+        this->connect_to_menu(std::move(title), this->Stack::size() - 1);
+    }
+
+    /// Append a lazy page that constructs a Widget_t from copies of \p args.
+    template <typename Widget_t, typename... Args>
+    void make_lazy_page(Glyph_string title, Args&&... args)
+    {
+        this->Stack::make_lazy_page<Widget_t>(std::forward<Args>(args)...);
+        this->connect_to_menu(std::move(title), this->Stack::size() - 1);
+    }
+
     /// Insert a Widget at \p index.
     /** No-op if \p index is larger than Widget::child_count() - 1. */
     void insert_page(Glyph_string title,
@@ -0,0 +1,109 @@
+#ifndef TERMOX_WIDGET_WIDGETS_TERMINAL_VIEW_HPP
+#define TERMOX_WIDGET_WIDGETS_TERMINAL_VIEW_HPP
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <signals_light/signal.hpp>
+
+#include <termox/common/fps.hpp>
+#include <termox/common/lockable.hpp>
+#include <termox/painter/painter.hpp>
+#include <termox/system/key.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/widget.hpp>
+#include <termox/widget/widgets/detail/vt_parser.hpp>
+#include <termox/widget/widgets/detail/vt_screen.hpp>
+
+namespace ox {
+
+/// Runs a command on a pseudo terminal and displays its screen.
+/** The child's output is read on each Timer_event, parsed by a Vt_parser and
+ *  written to a Vt_screen, the widget only repaints the rows of the screen
+ *  that were damaged, and the Screen_buffers diff writes only the changed
+ *  cells to the terminal. Key presses are encoded and written to the child
+ *  while the widget has focus. The pty is resized with the widget. */
+class Terminal_view : public Widget, private Lockable<std::mutex> {
+   public:
+    struct Parameters {
+        std::vector<std::string> command = {"/bin/sh"};
+        FPS refresh_rate                 = FPS{60};
+    };
+
+   public:
+    /// Emitted with the child's exit status once it has been reaped.
+    sl::Signal<void(int)> exited;
+
+   public:
+    /// Spawn \p command, command[0] is searched for on the PATH.
+    /** Output is polled \p refresh_rate times per second. Throws
+     *  std::runtime_error if the pty cannot be opened. */
+    explicit Terminal_view(std::vector<std::string> command = {"/bin/sh"},
+                           FPS refresh_rate = FPS{60});
+
+    explicit Terminal_view(Parameters p);
+
+    /// Hangs up on the child process and reaps it.
+    /** The child is killed if it has not exited 100ms after the SIGHUP. */
+    ~Terminal_view() override;
+
+   public:
+    /// Write \p bytes to the child, as if typed on its terminal.
+    void send(std::string_view bytes);
+
+    /// Parse \p bytes as if they were output by the child.
+    void feed(std::string_view bytes);
+
+    /// Return true if the child process has not exited yet.
+    [[nodiscard]] auto is_running() const -> bool;
+
+   protected:
+    auto paint_event(Painter& p) -> bool override;
+
+    auto timer_event() -> bool override;
+
+    auto resize_event(Area new_size, Area old_size) -> bool override;
+
+    auto key_press_event(Key k) -> bool override;
+
+   private:
+    int master_fd_ = -1;
+    int pid_       = -1;
+    std::atomic<bool> app_cursor_keys_{false};
+    detail::Vt_parser parser_;
+    detail::Vt_screen screen_;
+    std::vector<char> read_buffer_;
+
+   private:
+    /// Repaint the rows of screen_ that changed, the lock must be held.
+    void update_damaged_rows();
+
+    /// Parse one read from the pty into screen_, false if nothing was read.
+    auto read_pty() -> bool;
+
+    /// Parse what is available from the pty into screen_, up to 64 reads.
+    void drain();
+
+    /// Return the child's exit status and close the pty if it has exited.
+    /** Everything left in the pty is parsed before it is closed. */
+    auto reap() -> std::optional<int>;
+
+    /// Write \p bytes to the pty, the lock must be held.
+    void write_to_child(std::string_view bytes);
+};
+
+/// Helper function to create a Terminal_view instance.
+[[nodiscard]] auto terminal_view(std::vector<std::string> command = {"/bin/sh"},
+                                 FPS refresh_rate = FPS{60})
+    -> std::unique_ptr<Terminal_view>;
+
+/// Helper function to create a Terminal_view instance.
+[[nodiscard]] auto terminal_view(Terminal_view::Parameters p)
+    -> std::unique_ptr<Terminal_view>;
+
+}  // namespace ox
+#endif  // TERMOX_WIDGET_WIDGETS_TERMINAL_VIEW_HPP
@@ -142,6 +142,8 @@ class Text_view : public Widget {
     /// Add call to Text_view::update_display() before posting Paint_event.
     void update() override;
 
+    using Widget::update;
+
    protected:
     /// Paint the portion of contents that is currently visible on screen.
     auto paint_event(Painter& p) -> bool override;
@@ -175,6 +177,12 @@ class Text_view : public Widget {
      *  wrap is enabled, and the contents.*/
     void update_display(int from_line = 0);
 
+    /// Call update_display() and repaint the lines from \p index downward.
+    /** Used after contents are modified at \p index, lines above it are only
+     *  repainted if their layout changed. Nothing is repainted if the change is
+     *  below the displayed lines. */
+    void update_from(int index);
+
    private:
     /// Provides a start index into contents and total length for a text line.
     struct Line_info {
@@ -14,6 +14,8 @@ void Timer::set_interval(Duration_t interval) { interval_ = interval; }
 
 auto Timer::get_interval() const -> Duration_t { return interval_; }
 
+auto Timer::deadline() const -> Time_point { return last_time_ + interval_; }
+
 auto Timer::get_sleep_time() const -> Clock_t::duration
 {
     auto const elapsed = Clock_t::now() - last_time_;
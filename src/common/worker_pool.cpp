@@ -0,0 +1,68 @@
+#include <termox/common/worker_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace ox {
+
+Worker_pool::Worker_pool(std::size_t thread_count)
+{
+    thread_count = std::max(thread_count, std::size_t{1});
+    for (auto i = std::size_t{0}; i < thread_count; ++i) {
+        threads_.push_back(
+            std::async(std::launch::async, [this] { this->loop_function(); }));
+    }
+}
+
+Worker_pool::~Worker_pool()
+{
+    {
+        auto const lock = std::lock_guard{mtx_};
+        exit_           = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_)
+        t.wait();
+}
+
+void Worker_pool::submit(std::function<void()> work)
+{
+    {
+        auto const lock = std::lock_guard{mtx_};
+        work_.push_back(std::move(work));
+    }
+    cv_.notify_one();
+}
+
+auto Worker_pool::thread_count() const -> std::size_t
+{
+    return threads_.size();
+}
+
+auto Worker_pool::default_thread_count() -> std::size_t
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void Worker_pool::loop_function()
+{
+    while (true) {
+        auto work = std::function<void()>{};
+        {
+            auto lock = std::unique_lock{mtx_};
+            cv_.wait(lock, [this] { return exit_ || !work_.empty(); });
+            if (work_.empty())
+                return;
+            work = std::move(work_.front());
+            work_.pop_front();
+        }
+        work();
+    }
+}
+
+}  // namespace ox
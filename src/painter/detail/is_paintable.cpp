@@ -1,12 +1,26 @@
 #include <termox/painter/detail/is_paintable.hpp>
 
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
 #include <termox/widget/widget.hpp>
 
 namespace ox::detail {
 
 auto is_paintable(Widget const& w) -> bool
 {
-    return w.is_enabled() && (w.area().width != 0) && (w.area().height != 0);
+    return w.is_enabled() && (w.area().width != 0) &&
+           (w.area().height != 0) && !is_empty(visible_region(w));
+}
+
+auto visible_region(Widget const& w) -> Rect
+{
+    auto const origin = w.top_left();
+    auto region       = Rect{origin, w.area()};
+    for (Widget const* p = w.parent(); p != nullptr; p = p->parent()) {
+        if (p->clips_children())
+            region = intersection(region, {p->top_left(), p->area()});
+    }
+    return {region.top_left - origin, region.area};
 }
 
 }  // namespace ox::detail
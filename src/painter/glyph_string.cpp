@@ -2,12 +2,12 @@
 
 #include <algorithm>
 #include <string>
-#include <vector>
 
 #include <termox/common/u32_to_mb.hpp>
 #include <termox/painter/brush.hpp>
 #include <termox/painter/color.hpp>
 #include <termox/painter/glyph.hpp>
+#include <termox/painter/grapheme.hpp>
 #include <termox/painter/trait.hpp>
 
 namespace ox {
@@ -33,14 +33,21 @@ auto Glyph_string::append(Glyph_string const& gs) -> Glyph_string&
 
 auto Glyph_string::length() const -> int { return this->size(); }
 
-auto Glyph_string::size() const -> int { return this->vector::size(); }
+auto Glyph_string::size() const -> int
+{
+    return static_cast<int>(this->detail::Glyph_vector::size());
+}
 
 auto Glyph_string::u32str() const -> std::u32string
 {
     auto result = std::u32string{};
     result.reserve(this->size());
-    for (Glyph g : *this)
-        result.push_back(g.symbol);
+    for (Glyph g : *this) {
+        if (is_grapheme_cluster(g.symbol))
+            result.append(grapheme_code_points(g.symbol));
+        else
+            result.push_back(g.symbol);
+    }
     return result;
 }
 
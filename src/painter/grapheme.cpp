@@ -0,0 +1,97 @@
+#include <termox/painter/grapheme.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <termox/common/u32_to_mb.hpp>
+
+namespace {
+
+/// Process wide storage of interned grapheme clusters, bounded in size.
+/** Clusters are never removed, a std::deque keeps references to them valid
+ *  as the table grows, so the keys of ids_ are views into clusters_. Once
+ *  max_grapheme_clusters are held, new clusters are not stored and fall back
+ *  to their first code point.
+ *
+ *  Lookups of clusters already interned share the lock and do not allocate,
+ *  only inserting a new cluster takes the lock exclusively. */
+class Cluster_table {
+   public:
+    [[nodiscard]] auto intern(std::u32string_view cluster) -> char32_t
+    {
+        cluster = cluster.substr(0, ox::max_grapheme_cluster_length);
+        {
+            auto const lock = std::shared_lock{mtx_};
+            if (auto const at = ids_.find(cluster); at != std::end(ids_))
+                return at->second;
+        }
+        auto const lock = std::unique_lock{mtx_};
+        // Another thread may have inserted it between the two locks.
+        if (auto const at = ids_.find(cluster); at != std::end(ids_))
+            return at->second;
+        if (clusters_.size() >= ox::max_grapheme_clusters)
+            return cluster.front();
+        auto const symbol = ox::grapheme_cluster_flag |
+                            static_cast<char32_t>(clusters_.size());
+        auto const& stored = clusters_.emplace_back(cluster);
+        ids_.emplace(stored, symbol);
+        return symbol;
+    }
+
+    [[nodiscard]] auto at(char32_t symbol) const -> std::u32string
+    {
+        auto const lock = std::shared_lock{mtx_};
+        return clusters_.at(symbol & ~ox::grapheme_cluster_flag);
+    }
+
+   private:
+    mutable std::shared_mutex mtx_;
+    std::unordered_map<std::u32string_view, char32_t> ids_;
+    std::deque<std::u32string> clusters_;
+};
+
+[[nodiscard]] auto table() -> Cluster_table&
+{
+    static auto t = Cluster_table{};
+    return t;
+}
+
+}  // namespace
+
+namespace ox::detail {
+
+auto intern_grapheme_cluster(std::u32string_view cluster) -> char32_t
+{
+    if (cluster.empty())
+        return U'\0';
+    return table().intern(cluster);
+}
+
+}  // namespace ox::detail
+
+namespace ox {
+
+auto grapheme_code_points(char32_t symbol) -> std::u32string
+{
+    if (!is_grapheme_cluster(symbol))
+        return std::u32string(1, symbol);
+    return table().at(symbol);
+}
+
+auto grapheme_to_mb(char32_t symbol) -> std::string
+{
+    if (!is_grapheme_cluster(symbol))
+        return u32_to_mb(symbol);
+    auto result = std::string{};
+    for (char32_t c : table().at(symbol))
+        result.append(u32_to_mb(c));
+    return result;
+}
+
+}  // namespace ox
@@ -1,27 +1,32 @@
 #include <termox/painter/painter.hpp>
 
+#include <termox/painter/detail/is_paintable.hpp>
 #include <termox/painter/glyph_string.hpp>
 #include <termox/system/event_loop.hpp>
 #include <termox/system/system.hpp>
 #include <termox/terminal/detail/canvas.hpp>
 #include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
 #include <termox/widget/widget.hpp>
 
 namespace ox {
 
 Painter::Painter(Widget& widg, detail::Canvas& canvas)
-    : widget_{widg}, canvas_{canvas}, brush_{widg.brush}
+    : widget_{widg},
+      canvas_{canvas},
+      brush_{widg.effective_brush()},
+      clip_{intersection(
+          intersection(widg.damage(), detail::visible_region(widg)),
+          {Point{0, 0} - widg.top_left(), canvas.area()})}
 {
     this->wallpaper_fill();
 }
 
 auto Painter::put(Glyph tile, Point p) -> Painter&
 {
-    // User code can contain invalid points.
-    if (p.x >= widget_.area().width || p.y >= widget_.area().height ||
-        p.x < 0 || p.y < 0) {
+    // User code can contain invalid points, clip_ is within the Widget.
+    if (!contains(clip_, p))
         return *this;
-    }
     this->put_global(tile, widget_.top_left() + p);
     return *this;
 }
@@ -72,17 +77,43 @@ auto Painter::vline(Glyph tile, Point a, Point b) -> Painter&
 
 auto Painter::wallpaper_fill() -> Painter&
 {
-    this->fill_global_no_brush(widget_.generate_wallpaper(), widget_.top_left(),
-                               widget_.area());
+    auto const wallpaper = widget_.generate_wallpaper();
+    auto const fill      = [&](Rect r) {
+        if (is_empty(r))
+            return;
+        this->fill_global_no_brush(wallpaper, widget_.top_left() + r.top_left,
+                                   r.area);
+    };
+    auto const covered = intersection(clip_, widget_.covered_region());
+    if (is_empty(covered)) {
+        fill(clip_);
+        return *this;
+    }
+    // The parts of clip_ above, below, left and right of covered.
+    auto const left   = clip_.top_left.x;
+    auto const top    = clip_.top_left.y;
+    auto const right  = left + clip_.area.width;
+    auto const bottom = top + clip_.area.height;
+    auto const c      = covered.top_left;
+    auto const c_end  = c + Point{covered.area.width, covered.area.height};
+    fill({clip_.top_left, {clip_.area.width, c.y - top}});
+    fill({{left, c_end.y}, {clip_.area.width, bottom - c_end.y}});
+    fill({{left, c.y}, {c.x - left, covered.area.height}});
+    fill({{c_end.x, c.y}, {right - c_end.x, covered.area.height}});
     return *this;
 }
 
+auto Painter::clip() const -> Rect { return clip_; }
+
 // GLOBAL COORDINATES - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 void Painter::put_global(Glyph tile, Point p)
 {
     tile.brush    = merge(tile.brush, brush_);
     canvas_.at(p) = tile;
+#ifdef TERMOX_PROFILER
+    ++cells_written_;
+#endif
 }
 
 void Painter::hline_global(Glyph tile, Point a, Point b)
@@ -93,6 +124,9 @@ void Painter::hline_global(Glyph tile, Point a, Point b)
 
 void Painter::hline_global_no_brush(Glyph tile, Point a, Point b)
 {
+#ifdef TERMOX_PROFILER
+    cells_written_ += b.x >= a.x ? b.x - a.x + 1 : 0;
+#endif
     for (; a.x <= b.x; ++a.x)
         canvas_.at(a) = tile;
 }
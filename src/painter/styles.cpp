@@ -0,0 +1,55 @@
+#include <termox/painter/styles.hpp>
+
+#include <string>
+#include <utility>
+
+#include <termox/painter/brush.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/system.hpp>
+#include <termox/terminal/detail/screen_buffers.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace ox {
+
+void Styles::set(std::string const& name, Brush b)
+{
+    auto& classes = state().classes;
+    if (auto const at = classes.find(name);
+        at != std::end(classes) && at->second == b) {
+        return;
+    }
+    classes[name] = b;
+    restyle_all();
+}
+
+void Styles::remove(std::string const& name)
+{
+    if (state().classes.erase(name) == 1)
+        restyle_all();
+}
+
+void Styles::set_theme(Map_t classes)
+{
+    state().classes = std::move(classes);
+    restyle_all();
+}
+
+auto Styles::get(std::string const& name) -> Brush
+{
+    auto const& classes = state().classes;
+    auto const at       = classes.find(name);
+    return at == std::end(classes) ? Brush{} : at->second;
+}
+
+auto Styles::state() -> State& { return Session::current().styles_; }
+
+void Styles::restyle_all()
+{
+    if (auto* const head = System::head(); head != nullptr)
+        head->restyle();
+    for (auto* const owner : Terminal::screen_buffers().layer_owners())
+        owner->restyle();
+}
+
+}  // namespace ox
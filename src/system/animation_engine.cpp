@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 #include <iterator>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -13,18 +15,14 @@
 #include <termox/system/system.hpp>
 #include <termox/widget/widget.hpp>
 
-namespace {
-
-auto timer_events = std::vector<ox::Timer_event>{};
-
-}
-
 namespace ox {
 
 void Animation_engine::register_widget(Widget& w, Duration_t interval)
 {
     auto const lock = this->Lockable::lock();
-    subjects_.insert(std::pair{&w, Registered_data{interval, Clock_t::now()}});
+    auto const now  = Clock_t::now();
+    subjects_.insert(
+        std::pair{&w, Registered_data{interval, now, now + interval}});
 }
 
 void Animation_engine::register_widget(Widget& w, FPS fps)
@@ -36,41 +34,103 @@ void Animation_engine::unregister_widget(Widget& w)
 {
     auto const lock = this->Lockable::lock();
     subjects_.erase(&w);
+    suspended_.erase(&w);
+    loop_.event_queue().forget_timers(w);
+}
+
+void Animation_engine::suspend_widget(Widget& w)
+{
+    auto const lock = this->Lockable::lock();
+    auto node       = subjects_.extract(&w);
+    if (!node.empty())
+        suspended_.insert(std::move(node));
+}
+
+void Animation_engine::resume_widget(Widget& w)
+{
+    auto const lock = this->Lockable::lock();
+    auto node       = suspended_.extract(&w);
+    if (node.empty())
+        return;
+    auto const now                = Clock_t::now();
+    node.mapped().last_event_time = now;
+    node.mapped().next_deadline   = now + node.mapped().interval;
+    subjects_.insert(std::move(node));
 }
 
 auto Animation_engine::is_empty() const -> bool { return subjects_.empty(); }
 
+void Animation_engine::schedule(Time_point when, std::function<void()> f)
+{
+    auto is_earliest = false;
+    {
+        auto const lock = this->Lockable::lock();
+        auto const iter = scheduled_.emplace(when, std::move(f));
+        is_earliest     = iter == std::begin(scheduled_);
+    }
+    if (is_earliest)
+        this->wake();
+}
+
+void Animation_engine::schedule_frame(std::function<void()> f)
+{
+    auto const lock = this->Lockable::lock();
+    this->schedule(std::max(Clock_t::now(), last_frame_ + frame_period),
+                   std::move(f));
+}
+
 void Animation_engine::start()
 {
+    // Coroutines may start the engine while the UI thread does the same.
+    auto const lock = this->Lockable::lock();
+    // Timer_events must not hold the Session lock while input is waiting.
+    loop_.event_queue().set_budget(frame_budget);
+    loop_.event_queue().set_backpressure(backpressure);
     loop_.run_async([this](Event_queue& q) { this->loop_function(q); });
 }
 
 void Animation_engine::stop()
 {
     loop_.exit(0);
+    this->wake();
     loop_.wait();
 }
 
 auto Animation_engine::is_running() const -> bool { return loop_.is_running(); }
 
+auto Animation_engine::shed_counts() const -> Shed_counts
+{
+    return loop_.event_queue().shed_counts();
+}
+
 void Animation_engine::loop_function(Event_queue& queue)
 {
-    // The first call to wait() returns immediately.
-    timer_.wait();
+    // The first wait returns immediately, schedule() and stop() cut it short.
+    {
+        auto lock = std::unique_lock{wake_mtx_};
+        wake_cv_.wait_until(lock, timer_.deadline(), [this] { return wake_; });
+        wake_ = false;
+    }
     timer_.begin();
+    if (!queue.begin_frame())
+        return;
     for (Timer_event& e : get_timer_events())  // This resets the Timer interval
         queue.append(std::move(e));
+    if (!due_.empty()) {
+        queue.append(Custom_event{[due = std::move(due_)] {
+            for (auto const& f : due)
+                f();
+        }});
+        due_.clear();
+    }
 }
 
 auto Animation_engine::get_timer_events() -> std::vector<Timer_event>&
 {
-    timer_events.clear();
-    if (subjects_.empty()) {
-        timer_.set_interval(default_interval);
-        return timer_events;
-    }
+    timer_events_.clear();
     auto const lock    = this->Lockable::lock();
-    auto next_interval = [&, this] {
+    auto const now     = Clock_t::now();
+    auto next_interval = subjects_.empty() ? default_interval : [this] {
         return std::min_element(std::cbegin(subjects_), std::cend(subjects_),
                                 [](auto const& a, auto const& b) {
                                     return a.second.interval <
@@ -79,20 +139,48 @@ auto Animation_engine::get_timer_events() -> std::vector<Timer_event>&
             ->second.interval;
     }();
 
-    auto const now = Clock_t::now();
     for (auto& [widget, data] : subjects_) {
-        auto const time_left = std::chrono::duration_cast<Duration_t>(
-            data.interval - (now - data.last_event_time));
-        if (time_left <= Duration_t{0}) {
-            data.last_event_time = now;
-            timer_events.push_back(Timer_event{*widget});
-        }
-        else {
-            next_interval = std::min(next_interval, time_left);
+        if (now < data.next_deadline) {
+            next_interval = std::min(next_interval, data.next_deadline - now);
+            continue;
         }
+        // Deadlines stay on the interval grid, late frames are counted as
+        // steps instead of drifting the schedule.
+        auto const steps =
+            data.interval > Duration_t::zero()
+                ? 1 + static_cast<int>((now - data.next_deadline) /
+                                       data.interval)
+                : 1;
+        timer_events_.push_back(
+            Timer_event{*widget, Frame_time{data.next_deadline, now,
+                                            now - data.last_event_time,
+                                            steps}});
+        data.last_event_time = now;
+        data.next_deadline += steps * data.interval;
+        next_interval = std::min(next_interval, data.next_deadline - now);
+    }
+
+    auto const due_end = scheduled_.upper_bound(now);
+    for (auto i = std::begin(scheduled_); i != due_end; ++i)
+        due_.push_back(std::move(i->second));
+    scheduled_.erase(std::begin(scheduled_), due_end);
+    if (!scheduled_.empty()) {
+        next_interval = std::min<Duration_t>(
+            next_interval, std::begin(scheduled_)->first - now);
     }
+
+    last_frame_ = now;
     timer_.set_interval(next_interval);
-    return timer_events;
+    return timer_events_;
+}
+
+void Animation_engine::wake()
+{
+    {
+        auto const lock = std::lock_guard{wake_mtx_};
+        wake_           = true;
+    }
+    wake_cv_.notify_one();
 }
 
 }  // namespace ox
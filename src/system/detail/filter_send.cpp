@@ -10,6 +10,7 @@
 #include <termox/system/event.hpp>
 #include <termox/system/key.hpp>
 #include <termox/system/mouse.hpp>
+#include <termox/system/profiler.hpp>
 #include <termox/terminal/terminal.hpp>
 #include <termox/widget/widget.hpp>
 
@@ -35,9 +36,12 @@ auto filter_send(ox::Paint_event const& e) -> bool
         [&e](Widget* filter) {
             if (!is_paintable(e.receiver))
                 return false;
-            auto p = Painter{e.receiver, ox::Terminal::screen_buffers.next};
+            auto& canvas =
+                ox::Terminal::screen_buffers().canvas_for(e.receiver);
+            auto p       = Painter{e.receiver, canvas};
             auto const x = filter->paint_event_filter(e.receiver, p);
             auto const y = filter->painted_filter.emit(e.receiver, p);
+            profile_cells(p);
             return x || (y ? *y : false);
         },
         e.receiver.get().get_event_filters());
@@ -12,6 +12,7 @@
 #include <termox/system/event.hpp>
 #include <termox/system/key.hpp>
 #include <termox/system/mouse.hpp>
+#include <termox/system/profiler.hpp>
 #include <termox/system/system.hpp>
 #include <termox/terminal/detail/screen_buffers.hpp>
 #include <termox/terminal/terminal.hpp>
@@ -38,9 +39,11 @@ void send(ox::Paint_event e)
 {
     if (!is_paintable(e.receiver))
         return;
-    auto p = Painter{e.receiver, ox::Terminal::screen_buffers.next};
+    auto& canvas = ox::Terminal::screen_buffers().canvas_for(e.receiver);
+    auto p       = Painter{e.receiver, canvas};
     e.receiver.get().paint_event(p);
     e.receiver.get().painted.emit(p);
+    profile_cells(p);
 }
 
 void send(ox::Key_press_event e)
@@ -159,6 +162,7 @@ void send(ox::Resize_event e)
 void send(ox::Timer_event e)
 {
     if (e.receiver.get().is_enabled()) {
+        e.receiver.get().set_frame_time(e.time);
         e.receiver.get().timer_event();
         e.receiver.get().timer.emit();
     }
@@ -166,10 +170,8 @@ void send(ox::Timer_event e)
 
 void send(ox::Dynamic_color_event const& e)
 {
-    for (auto [color, true_color] : e.color_data) {
-        ox::Terminal::update_color_stores(color, true_color);
-        ox::Terminal::repaint_color(color);
-    }
+    for (auto [color, true_color] : e.color_data)
+        ox::Terminal::update_dynamic_color(color, true_color);
 }
 
 void send(::esc::Window_resize x)
@@ -179,11 +181,11 @@ void send(::esc::Window_resize x)
         assert(h != nullptr);
         return *h;
     }();
-    auto const previous   = ox::Terminal::screen_buffers.area();
+    auto const previous   = ox::Terminal::screen_buffers().area();
     auto const is_shorter = x.new_dimensions.height < previous.height;
     if (is_shorter)  // xterm anchors from the top and scrolls.
         ox::Terminal::flag_full_repaint();
-    ox::Terminal::screen_buffers.resize(x.new_dimensions);
+    ox::Terminal::screen_buffers().resize(x.new_dimensions);
     ox::System::post_event(ox::Resize_event{head, x.new_dimensions});
 }
 
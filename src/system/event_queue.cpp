@@ -1,12 +1,18 @@
 #include <termox/system/event_queue.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
 #include <termox/system/event.hpp>
+#include <termox/system/profiler.hpp>
+#include <termox/system/session.hpp>
 #include <termox/system/system.hpp>
 #include <termox/terminal/terminal.hpp>
 #include <termox/widget/widget.hpp>
@@ -54,20 +60,218 @@ void Delete_queue::send_all()
 
 auto Delete_queue::size() const -> std::size_t { return deletes_.size(); }
 
-void Basic_queue::append(Event e) { basics_.push_back(std::move(e)); }
+static_assert(std::is_trivially_copyable_v<Compact_event>);
+static_assert(sizeof(Compact_event) < sizeof(Event));
+static_assert(sizeof(Compact_event) <=
+                  sizeof(Timer_event) + alignof(Timer_event),
+              "Compact_event should be no larger than its Timer_event.");
 
-auto Basic_queue::send_all() -> bool
+auto priority_of(Compact_event const& e) -> Event_priority
 {
-    // Allows for send(e) appending to the queue and invalidating iterators.
-    bool sent = false;
-    for (auto index = 0uL; index < basics_.size(); ++index)
-        sent = System::send_event(std::move(basics_[index])) || sent;
-    basics_.clear();
+    return std::visit(
+        [](auto const& e) {
+            using T = std::decay_t<decltype(e)>;
+            if constexpr (std::is_same_v<T, Payload_ref>)
+                return e.priority;
+            else if constexpr (std::is_same_v<T, Paint_event>)
+                return Event_priority::Paint;
+            else if constexpr (std::is_same_v<T, Timer_event>)
+                return Event_priority::Timer;
+            else if constexpr (std::is_same_v<T, Key_press_event> ||
+                               std::is_same_v<T, Key_release_event> ||
+                               std::is_same_v<T, Mouse_press_event> ||
+                               std::is_same_v<T, Mouse_release_event> ||
+                               std::is_same_v<T, Mouse_wheel_event> ||
+                               std::is_same_v<T, Mouse_move_event> ||
+                               std::is_same_v<T, ::esc::Window_resize>)
+                return Event_priority::Input;
+            else
+                return Event_priority::Layout;
+        },
+        e);
+}
+
+void Basic_queue::append(Event e)
+{
+    if (!this->admit(e))
+        return;
+    std::visit(
+        [this](auto&& e) {
+            using T = std::decay_t<decltype(e)>;
+            auto const compact = [&]() -> Compact_event {
+                if constexpr (std::is_constructible_v<Compact_event, T>)
+                    return e;
+                else {
+                    auto const priority =
+                        std::is_same_v<T, Dynamic_color_event>
+                            ? Event_priority::Dynamic_color
+                            : Event_priority::Layout;
+                    payloads_.push_back(std::forward<decltype(e)>(e));
+                    if constexpr (std::is_same_v<T, Dynamic_color_event>)
+                        pending_colors_ = payloads_.size() - 1;
+                    return Payload_ref{payloads_.size() - 1, priority};
+                }
+            }();
+            basics_.push({priority_of(compact), sequence_++}, compact);
+        },
+        std::move(e));
+}
+
+auto Basic_queue::send_all(Time_point deadline) -> bool
+{
+    auto const deferrable = [](Compact_event const& e) {
+        return priority_of(e) <= Event_priority::Timer;
+    };
+    // Allows for send(e) appending to the queue while sending.
+    bool sent            = false;
+    bool sent_deferrable = false;
+    while (!basics_.is_empty()) {
+        if (deferrable(basics_.top())) {
+            if (sent_deferrable && Clock_t::now() >= deadline)
+                break;
+            sent_deferrable = true;
+        }
+        auto compact = basics_.pop();
+        if (!this->release(compact))
+            continue;
+        auto e = std::visit(
+            [this](auto const& e) -> Event {
+                using T = std::decay_t<decltype(e)>;
+                if constexpr (std::is_same_v<T, Payload_ref>)
+                    return std::move(payloads_[e.index]);
+                else
+                    return e;
+            },
+            compact);
+        sent = System::send_event(std::move(e)) || sent;
+    }
+    if (basics_.is_empty()) {
+        payloads_.clear();
+        sequence_ = 0;
+    }
     return sent;
 }
 
 auto Basic_queue::size() const -> std::size_t { return basics_.size(); }
 
+auto Basic_queue::deferred() const -> std::size_t
+{
+    auto const lock = this->Lockable::lock();
+    return deferred_;
+}
+
+void Basic_queue::forget_timers(Widget const& w)
+{
+    auto const lock = this->Lockable::lock();
+    pending_timers_.erase(&w);
+}
+
+void Basic_queue::set_backpressure(Backpressure b)
+{
+    auto const lock = this->Lockable::lock();
+    backpressure_   = b;
+}
+
+auto Basic_queue::backpressure() const -> Backpressure
+{
+    auto const lock = this->Lockable::lock();
+    return backpressure_;
+}
+
+auto Basic_queue::shed_counts() const -> Shed_counts
+{
+    auto const lock = this->Lockable::lock();
+    return shed_;
+}
+
+void Basic_queue::count_paused_frame()
+{
+    auto const lock = this->Lockable::lock();
+    ++shed_.paused_frames;
+}
+
+auto Basic_queue::admit(Event& e) -> bool
+{
+    if (auto const* timer = std::get_if<Timer_event>(&e); timer != nullptr) {
+        auto const lock = this->Lockable::lock();
+        auto& pending   = pending_timers_[&timer->receiver.get()];
+        if (pending.count != 0 && backpressure_.coalesce_timers) {
+            auto newest = timer->time;
+            if (pending.coalesced.has_value()) {
+                newest.steps += pending.coalesced->steps;
+                newest.elapsed += pending.coalesced->elapsed;
+            }
+            pending.coalesced = newest;
+            ++shed_.timers_coalesced;
+            return false;
+        }
+        if (deferred_ >= backpressure_.capacity) {
+            if (pending.count == 0)
+                pending_timers_.erase(&timer->receiver.get());
+            ++shed_.dropped;
+            return false;
+        }
+        ++pending.count;
+        ++deferred_;
+        return true;
+    }
+    if (auto* colors = std::get_if<Dynamic_color_event>(&e);
+        colors != nullptr) {
+        auto const lock = this->Lockable::lock();
+        if (pending_colors_.has_value() && backpressure_.coalesce_colors) {
+            auto& waiting =
+                std::get<Dynamic_color_event>(payloads_[*pending_colors_])
+                    .color_data;
+            for (auto const& [color, value] : colors->color_data) {
+                auto const at = std::find_if(
+                    std::begin(waiting), std::end(waiting),
+                    [c = color](auto const& w) { return w.first == c; });
+                if (at == std::end(waiting))
+                    waiting.push_back({color, value});
+                else {
+                    at->second = value;
+                    ++shed_.colors_coalesced;
+                }
+            }
+            return false;
+        }
+        if (deferred_ >= backpressure_.capacity) {
+            ++shed_.dropped;
+            return false;
+        }
+        ++deferred_;
+        return true;
+    }
+    return true;
+}
+
+auto Basic_queue::release(Compact_event& e) -> bool
+{
+    if (priority_of(e) > Event_priority::Timer)
+        return true;
+    auto const lock = this->Lockable::lock();
+    --deferred_;
+    if (auto* timer = std::get_if<Timer_event>(&e); timer != nullptr) {
+        auto const at = pending_timers_.find(&timer->receiver.get());
+        if (at == std::end(pending_timers_))
+            return false;  // forget_timers() was called on the receiver.
+        if (auto& newest = at->second.coalesced; newest.has_value()) {
+            newest->steps += timer->time.steps;
+            newest->elapsed += timer->time.elapsed;
+            timer->time = *newest;
+            newest.reset();
+        }
+        if (--at->second.count == 0)
+            pending_timers_.erase(at);
+        return true;
+    }
+    if (auto const* ref = std::get_if<Payload_ref>(&e);
+        ref != nullptr && pending_colors_ == ref->index) {
+        pending_colors_.reset();
+    }
+    return true;
+}
+
 }  // namespace ox::detail
 
 namespace ox {
@@ -91,16 +295,51 @@ void Event_queue::send_all()
     // tree construction.
     if (System::head() == nullptr)
         return;
-    static auto mtx = std::mutex{};
-    auto const lock = std::lock_guard{mtx};
+    // Sessions on other threads process their own queues concurrently.
+    auto const lock = Session::current().lock();
     System::set_current_queue(*this);
-    bool sent = basics_.send_all();
+    auto const deadline = budget_.has_value()
+                              ? detail::Basic_queue::Clock_t::now() + *budget_
+                              : detail::Basic_queue::Time_point::max();
+    bool sent = basics_.send_all(deadline);
     sent      = paints_.send_all() || sent;
     deletes_.send_all();
     if (sent)
         Terminal::flush_screen();
 }
 
+void Event_queue::set_budget(std::optional<Budget_t> budget)
+{
+    budget_ = budget;
+}
+
+auto Event_queue::budget() const -> std::optional<Budget_t> { return budget_; }
+
+void Event_queue::set_backpressure(Backpressure b)
+{
+    basics_.set_backpressure(b);
+}
+
+auto Event_queue::backpressure() const -> Backpressure
+{
+    return basics_.backpressure();
+}
+
+auto Event_queue::shed_counts() const -> Shed_counts
+{
+    return basics_.shed_counts();
+}
+
+auto Event_queue::begin_frame() -> bool
+{
+    if (!basics_.backpressure().pause_producers || basics_.deferred() == 0)
+        return true;
+    basics_.count_paused_frame();
+    return false;
+}
+
+void Event_queue::forget_timers(Widget const& w) { basics_.forget_timers(w); }
+
 void Event_queue::add_to_a_queue(Paint_event e)
 {
     paints_.append(std::move(e));
@@ -1,6 +1,7 @@
 #include <termox/system/detail/find_widget_at.hpp>
 
 #include <termox/system/system.hpp>
+#include <termox/terminal/terminal.hpp>
 #include <termox/widget/point.hpp>
 #include <termox/widget/widget.hpp>
 
@@ -34,6 +35,11 @@ namespace ox::detail {
 
 [[nodiscard]] auto find_widget_at(Point p) -> Widget*
 {
+    if (auto* const overlay = Terminal::screen_buffers().layer_at(p);
+        overlay != nullptr) {
+        auto* const at = find_owner_of(*overlay, p);
+        return (at == nullptr) ? overlay : at;
+    }
     if (auto* head = System::head(); head == nullptr)
         return nullptr;
     else {
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include <termox/system/event.hpp>
+#include <termox/system/session.hpp>
 #include <termox/system/system.hpp>
 #include <termox/widget/focus_policy.hpp>
 #include <termox/widget/widget.hpp>
@@ -70,15 +71,11 @@ auto previous_tab_focus() -> ox::Widget*
 
 namespace ox::detail {
 
-ox::Widget* Focus::focus_widget_ = nullptr;
-bool Focus::tab_enabled_         = true;
-bool Focus::tab_suppressed_      = false;
-
-auto Focus::focus_widget() -> ox::Widget* { return focus_widget_; }
+auto Focus::focus_widget() -> ox::Widget* { return state().focus_widget; }
 
 void Focus::mouse_press(ox::Widget& clicked)
 {
-    if (&clicked == focus_widget_)
+    if (&clicked == state().focus_widget)
         return;
     if (is_click_focus_policy(clicked.focus_policy))
         Focus::set(clicked);
@@ -86,7 +83,8 @@ void Focus::mouse_press(ox::Widget& clicked)
 
 auto Focus::tab_press() -> bool
 {
-    if (tab_enabled_ && !tab_suppressed_) {
+    auto& s = state();
+    if (s.tab_enabled && !s.tab_suppressed) {
         auto* next = next_tab_focus();
         if (next == nullptr)
             Focus::clear();
@@ -94,13 +92,14 @@ auto Focus::tab_press() -> bool
             Focus::set(*next);
         return true;
     }
-    tab_suppressed_ = false;
+    s.tab_suppressed = false;
     return false;
 }
 
 auto Focus::shift_tab_press() -> bool
 {
-    if (tab_enabled_ && !tab_suppressed_) {
+    auto& s = state();
+    if (s.tab_enabled && !s.tab_suppressed) {
         auto* previous = previous_tab_focus();
         if (previous == nullptr)
             Focus::clear();
@@ -108,40 +107,44 @@ auto Focus::shift_tab_press() -> bool
             Focus::set(*previous);
         return true;
     }
-    tab_suppressed_ = false;
+    s.tab_suppressed = false;
     return false;
 }
 
 void Focus::set(ox::Widget& new_focus)
 {
-    if (std::addressof(new_focus) == focus_widget_)
+    auto& focus_widget = state().focus_widget;
+    if (std::addressof(new_focus) == focus_widget)
         return;
     if (new_focus.focus_policy == Focus_policy::None) {
         Focus::clear();
         return;
     }
-    if (focus_widget_ != nullptr)
-        System::post_event(Focus_out_event{*focus_widget_});
-    focus_widget_ = std::addressof(new_focus);
+    if (focus_widget != nullptr)
+        System::post_event(Focus_out_event{*focus_widget});
+    focus_widget = std::addressof(new_focus);
     System::post_event(Focus_in_event{new_focus});
 }
 
 void Focus::clear()
 {
-    if (focus_widget_ == nullptr)
+    auto& focus_widget = state().focus_widget;
+    if (focus_widget == nullptr)
         return;
-    System::post_event(Focus_out_event{*focus_widget_});
-    focus_widget_ = nullptr;
+    System::post_event(Focus_out_event{*focus_widget});
+    focus_widget = nullptr;
 }
 
-void Focus::clear_without_posting_event() { focus_widget_ = nullptr; }
+void Focus::clear_without_posting_event() { state().focus_widget = nullptr; }
+
+void Focus::enable_tab_focus() { state().tab_enabled = true; }
 
-void Focus::enable_tab_focus() { tab_enabled_ = true; }
+void Focus::disable_tab_focus() { state().tab_enabled = false; }
 
-void Focus::disable_tab_focus() { tab_enabled_ = false; }
+void Focus::suppress_tab() { state().tab_suppressed = true; }
 
-void Focus::suppress_tab() { tab_suppressed_ = true; }
+void Focus::unsuppress_tab() { state().tab_suppressed = false; }
 
-void Focus::unsuppress_tab() { tab_suppressed_ = false; }
+auto Focus::state() -> State& { return Session::current().focus_; }
 
 }  // namespace ox::detail
@@ -0,0 +1,330 @@
+#include <termox/system/input_recording.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+
+#include <esc/event.hpp>
+#include <esc/key.hpp>
+#include <esc/mouse.hpp>
+
+#include <termox/painter/brush.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/painter/grapheme.hpp>
+#include <termox/system/session.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+/// Identifies the file format, followed by a version byte.
+auto constexpr magic = std::string_view{"TOXI"};
+
+auto constexpr version = char{1};
+
+/// Tag byte written before each event, one per esc::Event alternative.
+enum class Tag : std::uint8_t {
+    Key_press,
+    Key_release,
+    Mouse_press,
+    Mouse_release,
+    Scroll_wheel,
+    Mouse_move,
+    Window_resize,
+};
+
+/// Append \p value to \p out as a LEB128 varint.
+void put_varint(std::string& out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void put_tag(std::string& out, Tag t)
+{
+    out.push_back(static_cast<char>(t));
+}
+
+void put_mouse(std::string& out, ::esc::Mouse const& m)
+{
+    put_varint(out, static_cast<std::uint64_t>(m.at.x));
+    put_varint(out, static_cast<std::uint64_t>(m.at.y));
+    out.push_back(static_cast<char>(m.button));
+    out.push_back(static_cast<char>(m.modifiers.shift |
+                                    (m.modifiers.ctrl << 1) |
+                                    (m.modifiers.alt << 2)));
+}
+
+void encode(std::string& out, ::esc::Key_press const& x)
+{
+    put_tag(out, Tag::Key_press);
+    put_varint(out, static_cast<std::uint32_t>(x.key));
+}
+
+void encode(std::string& out, ::esc::Key_release const& x)
+{
+    put_tag(out, Tag::Key_release);
+    put_varint(out, static_cast<std::uint32_t>(x.key));
+}
+
+void encode(std::string& out, ::esc::Mouse_press const& x)
+{
+    put_tag(out, Tag::Mouse_press);
+    put_mouse(out, x.state);
+}
+
+void encode(std::string& out, ::esc::Mouse_release const& x)
+{
+    put_tag(out, Tag::Mouse_release);
+    put_mouse(out, x.state);
+}
+
+void encode(std::string& out, ::esc::Scroll_wheel const& x)
+{
+    put_tag(out, Tag::Scroll_wheel);
+    put_mouse(out, x.state);
+}
+
+void encode(std::string& out, ::esc::Mouse_move const& x)
+{
+    put_tag(out, Tag::Mouse_move);
+    put_mouse(out, x.state);
+}
+
+void encode(std::string& out, ::esc::Window_resize const& x)
+{
+    put_tag(out, Tag::Window_resize);
+    put_varint(out, static_cast<std::uint64_t>(x.new_dimensions.width));
+    put_varint(out, static_cast<std::uint64_t>(x.new_dimensions.height));
+}
+
+/// Reads the fields written by encode() back out of a recording.
+class Decoder {
+   public:
+    explicit Decoder(std::string_view bytes) : bytes_{bytes} {}
+
+   public:
+    [[nodiscard]] auto is_done() const -> bool { return bytes_.empty(); }
+
+    [[nodiscard]] auto byte() -> std::uint8_t
+    {
+        if (bytes_.empty())
+            throw std::runtime_error{"Input_replay: Truncated recording."};
+        auto const result = static_cast<std::uint8_t>(bytes_.front());
+        bytes_.remove_prefix(1);
+        return result;
+    }
+
+    [[nodiscard]] auto varint() -> std::uint64_t
+    {
+        auto result = std::uint64_t{0};
+        for (auto shift = 0; shift < 64; shift += 7) {
+            auto const b = this->byte();
+            result |= std::uint64_t{b & 0x7Fu} << shift;
+            if ((b & 0x80) == 0)
+                return result;
+        }
+        throw std::runtime_error{"Input_replay: Malformed varint."};
+    }
+
+    [[nodiscard]] auto integer() -> int
+    {
+        return static_cast<int>(this->varint());
+    }
+
+    [[nodiscard]] auto key() -> ::esc::Key
+    {
+        return static_cast<::esc::Key>(this->varint());
+    }
+
+    [[nodiscard]] auto mouse() -> ::esc::Mouse
+    {
+        auto m            = ::esc::Mouse{};
+        m.at.x            = this->integer();
+        m.at.y            = this->integer();
+        m.button          = static_cast<::esc::Mouse::Button>(this->byte());
+        auto const mods   = this->byte();
+        m.modifiers.shift = (mods & 1) != 0;
+        m.modifiers.ctrl  = (mods & 2) != 0;
+        m.modifiers.alt   = (mods & 4) != 0;
+        return m;
+    }
+
+    [[nodiscard]] auto event() -> ::esc::Event
+    {
+        switch (static_cast<Tag>(this->byte())) {
+            case Tag::Key_press: return ::esc::Key_press{this->key()};
+            case Tag::Key_release: return ::esc::Key_release{this->key()};
+            case Tag::Mouse_press: return ::esc::Mouse_press{this->mouse()};
+            case Tag::Mouse_release: return ::esc::Mouse_release{this->mouse()};
+            case Tag::Scroll_wheel: return ::esc::Scroll_wheel{this->mouse()};
+            case Tag::Mouse_move: return ::esc::Mouse_move{this->mouse()};
+            case Tag::Window_resize: {
+                auto const width  = this->integer();
+                auto const height = this->integer();
+                return ::esc::Window_resize{{width, height}};
+            }
+        }
+        throw std::runtime_error{"Input_replay: Unknown event tag."};
+    }
+
+   private:
+    std::string_view bytes_;
+};
+
+/// Mix the object representation of \p x into the FNV-1a \p hash.
+template <typename T>
+void fnv1a(std::uint64_t& hash, T const& x)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &x, sizeof(T));
+    for (auto b : bytes) {
+        hash ^= b;
+        hash *= 0x100000001b3;
+    }
+}
+
+}  // namespace
+
+namespace ox {
+
+Input_recorder::Input_recorder(std::string const& path)
+    : session_{Session::current()},
+      file_{path, std::ios::binary | std::ios::trunc}
+{
+    if (!file_)
+        throw std::runtime_error{"Input_recorder: Could not open " + path};
+    file_.write(magic.data(), magic.size());
+    file_.put(version);
+    file_.flush();
+    session_.input_recorder_ = this;
+}
+
+Input_recorder::~Input_recorder()
+{
+    session_.input_recorder_ = nullptr;
+    file_.flush();
+}
+
+void Input_recorder::record(esc::Event const& event)
+{
+    using namespace std::chrono;
+    auto const now = Clock_t::now();
+    buffer_.clear();
+    auto const delta = duration_cast<microseconds>(now - last_).count();
+    put_varint(buffer_, static_cast<std::uint64_t>(delta));
+    std::visit([this](auto const& e) { encode(buffer_, e); }, event);
+    last_ = now;
+    ++size_;
+    // Flushed per event so a recording survives the process being killed,
+    // input arrives at human speed so this is never a hot path.
+    file_.write(buffer_.data(), buffer_.size());
+    file_.flush();
+}
+
+auto Input_recorder::size() const -> std::size_t { return size_; }
+
+Input_replay::Input_replay(std::string const& path)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file)
+        throw std::runtime_error{"Input_replay: Could not open " + path};
+    auto const contents = std::string{std::istreambuf_iterator<char>{file},
+                                      std::istreambuf_iterator<char>{}};
+    auto bytes = std::string_view{contents};
+    if (bytes.substr(0, magic.size()) != magic ||
+        bytes.size() <= magic.size() || bytes[magic.size()] != version) {
+        throw std::runtime_error{"Input_replay: Not a recording: " + path};
+    }
+    bytes.remove_prefix(magic.size() + 1);
+    auto decoder = Decoder{bytes};
+    auto offset  = std::chrono::microseconds{0};
+    while (!decoder.is_done()) {
+        offset += std::chrono::microseconds{decoder.varint()};
+        records_.push_back({offset, decoder.event()});
+    }
+}
+
+auto Input_replay::records() const -> std::vector<Input_record> const&
+{
+    return records_;
+}
+
+auto Input_replay::backend(Replay_speed speed, Area area) -> Session_backend
+{
+    speed_ = speed;
+    area_  = area;
+    return {-1, [this] { return this->read(); }, area};
+}
+
+auto Input_replay::read() -> esc::Event
+{
+    auto const now = Clock_t::now();
+    frame_times_.push_back(now - frame_start_);
+    if (next_ == records_.size()) {
+        // Snapshot now, the event returned below is only there to wake the
+        // user input loop so it can see the exit flag.
+        auto& session  = Session::current();
+        bytes_written_ = session.bytes_written();
+        screen_hash_   = ox::screen_hash(Terminal::screen_buffers().current);
+        session.exit(0);
+        return esc::Window_resize{area_};
+    }
+    auto const& record = records_[next_++];
+    if (speed_ == Replay_speed::Recorded)
+        std::this_thread::sleep_until(start_ + record.offset);
+    if (auto const* r = std::get_if<esc::Window_resize>(&record.event))
+        area_ = r->new_dimensions;
+    frame_start_ = Clock_t::now();
+    return record.event;
+}
+
+auto Input_replay::run(Session& session, Widget& head) -> Replay_report
+{
+    next_ = 0;
+    frame_times_.clear();
+    start_       = Clock_t::now();
+    frame_start_ = start_;
+    session.run(head);
+    auto report          = Replay_report{};
+    report.frame_times   = std::move(frame_times_);
+    report.bytes_written = bytes_written_;
+    report.screen_hash   = screen_hash_;
+    report.total_time    = Clock_t::now() - start_;
+    return report;
+}
+
+auto screen_hash(detail::Canvas const& screen) -> std::uint64_t
+{
+    auto hash = std::uint64_t{0xcbf29ce484222325};
+    fnv1a(hash, screen.area().width);
+    fnv1a(hash, screen.area().height);
+    for (Glyph const& g : screen) {
+        if (is_grapheme_cluster(g.symbol)) {
+            // Cluster symbols depend on interning order, hash the contents.
+            auto const points = grapheme_code_points(g.symbol);
+            fnv1a(hash, points.size());
+            for (char32_t c : points)
+                fnv1a(hash, c);
+        }
+        else
+            fnv1a(hash, g.symbol);
+        fnv1a(hash, g.brush);
+    }
+    return hash;
+}
+
+}  // namespace ox
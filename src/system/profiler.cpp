@@ -0,0 +1,261 @@
+#include <termox/system/profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <termox/painter/color.hpp>
+#include <termox/painter/detail/is_paintable.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/system/event.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/system.hpp>
+#include <termox/terminal/detail/screen_buffers.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+/// Names of the ox::Event alternatives, in variant order.
+auto constexpr event_names = std::array<std::string_view, 21>{
+    "Paint_event",
+    "Key_press_event",
+    "Key_release_event",
+    "Mouse_press_event",
+    "Mouse_release_event",
+    "Mouse_wheel_event",
+    "Mouse_move_event",
+    "Child_added_event",
+    "Child_removed_event",
+    "Child_polished_event",
+    "Delete_event",
+    "Disable_event",
+    "Enable_event",
+    "Focus_in_event",
+    "Focus_out_event",
+    "Move_event",
+    "Resize_event",
+    "Timer_event",
+    "Dynamic_color_event",
+    "Window_resize",
+    "Custom_event",
+};
+
+static_assert(std::variant_size_v<ox::Event> == event_names.size());
+
+/// Heat scale for the overlay, from cheapest to most expensive.
+auto constexpr heat_colors = std::array<ox::Color::Name, 6>{
+    ox::Color::Dark_blue, ox::Color::Blue,   ox::Color::Green,
+    ox::Color::Yellow,    ox::Color::Orange, ox::Color::Red};
+
+/// Return a small number that identifies the calling thread in a trace.
+[[nodiscard]] auto thread_number() -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+/// Write \p s as a JSON string literal, with quotes.
+void write_json_string(std::ostream& os, std::string_view s)
+{
+    os << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u00" << "0123456789abcdef"[c >> 4]
+                       << "0123456789abcdef"[c & 0xF];
+                }
+                else
+                    os << c;
+        }
+    }
+    os << '"';
+}
+
+/// Return the duration \p d in fractional units of Period_t.
+template <typename Period_t>
+[[nodiscard]] auto count_in(std::chrono::nanoseconds d) -> double
+{
+    return std::chrono::duration<double, Period_t>{d}.count();
+}
+
+}  // namespace
+
+namespace ox {
+
+auto Profiler::is_compiled_in() -> bool
+{
+#ifdef TERMOX_PROFILER
+    return true;
+#else
+    return false;
+#endif
+}
+
+auto Profiler::entries() -> std::vector<Entry>
+{
+    auto result = std::vector<Entry>{};
+    for (auto const& [key, entry] : state().entries)
+        result.push_back(entry);
+    std::sort(std::begin(result), std::end(result),
+              [](Entry const& a, Entry const& b) { return a.total > b.total; });
+    return result;
+}
+
+void Profiler::write_report(std::ostream& os)
+{
+    os << std::right << std::setw(12) << "total ms" << std::setw(12)
+       << "max ms" << std::setw(10) << "count" << std::setw(12) << "cells"
+       << "  " << std::left << std::setw(22) << "event"
+       << "widget\n";
+    os << std::fixed << std::setprecision(3);
+    for (Entry const& e : Profiler::entries()) {
+        os << std::right << std::setw(12) << count_in<std::milli>(e.total)
+           << std::setw(12) << count_in<std::milli>(e.max) << std::setw(10)
+           << e.count << std::setw(12) << e.cells << "  " << std::left
+           << std::setw(22) << e.event;
+        if (e.widget_id != -1)
+            os << e.widget_name << " #" << e.widget_id;
+        os << '\n';
+    }
+}
+
+void Profiler::write_chrome_trace(std::ostream& os)
+{
+    auto const& s = state();
+    os << "{\"traceEvents\":[";
+    auto first = true;
+    for (Span const& span : s.spans) {
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "{\"name\":";
+        write_json_string(os, event_names[span.event]);
+        os << ",\"cat\":\"event\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+           << span.thread << ",\"ts\":" << std::fixed << std::setprecision(3)
+           << count_in<std::micro>(span.begin - s.epoch)
+           << ",\"dur\":" << count_in<std::micro>(span.duration)
+           << ",\"args\":{\"widget\":";
+        auto const iter = s.entries.find(std::pair{span.widget_id, span.event});
+        if (iter != std::end(s.entries))
+            write_json_string(os, iter->second.widget_name);
+        else
+            os << "\"\"";
+        os << ",\"id\":" << span.widget_id << ",\"cells\":" << span.cells
+           << "}}";
+    }
+    os << "\n]}\n";
+}
+
+void Profiler::clear()
+{
+    auto& s = state();
+    s.entries.clear();
+    s.spans.clear();
+    s.epoch = Clock_t::now();
+}
+
+void Profiler::show_overlay(bool show)
+{
+    auto& s = state();
+    if (s.overlay == show)
+        return;
+    s.overlay = show;
+    if (show)
+        return;
+    if (Widget* const head = System::head(); head != nullptr) {
+        head->update();
+        for (Widget* const w : head->get_descendants())
+            w->update();
+    }
+}
+
+auto Profiler::is_overlay_shown() -> bool { return state().overlay; }
+
+void Profiler::record(int id,
+                      std::string const& name,
+                      std::uint8_t event,
+                      Clock_t::time_point begin,
+                      std::chrono::nanoseconds duration,
+                      std::size_t cells)
+{
+    auto& s                     = state();
+    auto const [iter, inserted] = s.entries.try_emplace(std::pair{id, event});
+    auto& entry                 = iter->second;
+    if (inserted) {
+        entry.widget_id = id;
+        entry.event     = event_names[event];
+    }
+    entry.widget_name = name;
+    ++entry.count;
+    entry.total += duration;
+    entry.max = std::max(entry.max, duration);
+    entry.cells += cells;
+    if (s.spans.size() < max_spans)
+        s.spans.push_back({id, event, thread_number(), begin, duration, cells});
+}
+
+void Profiler::paint_overlay()
+{
+    Widget* const head = System::head();
+    if (head == nullptr)
+        return;
+    auto constexpr paint = detail::Variant_index<Paint_event, Event>::value;
+
+    auto paint_time = std::map<int, std::chrono::nanoseconds>{};
+    auto max_time   = std::chrono::nanoseconds{1};
+    for (auto const& [key, entry] : state().entries) {
+        if (key.second != paint)
+            continue;
+        auto& total = paint_time[key.first];
+        total += entry.total;
+        max_time = std::max(max_time, total);
+    }
+
+    auto widgets = head->get_descendants();
+    widgets.insert(std::begin(widgets), head);  // Parents before children.
+    auto& buffers     = Terminal::screen_buffers();
+    auto const screen = buffers.area();
+    for (Widget* const w : widgets) {
+        auto const iter = paint_time.find(w->unique_id());
+        if (iter == std::end(paint_time) || !detail::is_paintable(*w))
+            continue;
+        auto const level = static_cast<std::size_t>(
+            iter->second * (heat_colors.size() - 1) / max_time);
+        auto const color = Color{heat_colors[level]};
+        auto const visible = detail::visible_region(*w);
+        auto const shown   = intersection(
+            {w->top_left() + visible.top_left, visible.area}, {{0, 0}, screen});
+        auto const x_end = shown.top_left.x + shown.area.width;
+        auto const y_end = shown.top_left.y + shown.area.height;
+        for (auto y = shown.top_left.y; y < y_end; ++y) {
+            for (auto x = shown.top_left.x; x < x_end; ++x) {
+                // A copy of what will be on screen, next is only merged now.
+                auto glyph = buffers.next.at({x, y});
+                if (glyph.symbol == U'\0')  // Not repainted this frame.
+                    glyph = buffers.current.at({x, y});
+                glyph.brush.background  = color;
+                buffers.next.at({x, y}) = glyph;
+            }
+        }
+    }
+}
+
+auto Profiler::state() -> State& { return Session::current().profiler_; }
+
+}  // namespace ox
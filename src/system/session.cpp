@@ -0,0 +1,123 @@
+#include <termox/system/session.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <esc/esc.hpp>
+
+#include <termox/system/input_recording.hpp>
+#include <termox/system/system.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace ox {
+
+Session::Session(Session_backend backend)
+    : backend_{std::move(backend)},
+      current_queue_{user_input_loop_.event_queue()}
+{}
+
+auto Session::run(Widget& head) -> int
+{
+    auto const scope = Session_scope{this};
+    Terminal::initialize();
+    System::set_head(&head);
+    auto const result = System::run();
+    head_ = nullptr;
+    Terminal::uninitialize();
+    return result;
+}
+
+void Session::exit(int exit_code) { user_input_loop_.exit(exit_code); }
+
+auto Session::wait() -> int
+{
+    if (!fut_.valid())
+        return -1;
+    return fut_.get();
+}
+
+auto Session::is_default() const -> bool
+{
+    return this == &Session::default_session();
+}
+
+auto Session::bytes_written() const -> std::size_t { return bytes_written_; }
+
+auto Session::current() -> Session&
+{
+    auto* const session = Session_scope::get();
+    return session == nullptr ? Session::default_session() : *session;
+}
+
+auto Session::default_session() -> Session&
+{
+    static auto session = Session{};
+    return session;
+}
+
+auto Session::is_stdio() const -> bool
+{
+    return backend_.output_fd == STDOUT_FILENO;
+}
+
+auto Session::is_headless() const -> bool { return backend_.output_fd == -1; }
+
+void Session::write(std::string_view bytes)
+{
+    bytes_written_ += bytes.size();
+    if (this->is_headless())
+        return;
+    if (this->is_stdio())
+        esc::write(bytes);
+    else
+        output_.append(bytes);
+}
+
+void Session::flush()
+{
+    if (this->is_stdio()) {
+        esc::flush();
+        return;
+    }
+    auto remaining = std::string_view{output_};
+    while (!remaining.empty()) {
+        auto const n =
+            ::write(backend_.output_fd, remaining.data(), remaining.size());
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            break;  // The other end has gone away, drop the output.
+        }
+        remaining.remove_prefix(static_cast<std::size_t>(n));
+    }
+    output_.clear();
+}
+
+auto Session::area() const -> Area
+{
+    if (this->is_stdio())
+        return esc::terminal_area();
+    if (this->is_headless())
+        return backend_.headless_area;
+    auto size = ::winsize{};
+    if (::ioctl(backend_.output_fd, TIOCGWINSZ, &size) != 0)
+        return {0, 0};
+    return {size.ws_col, size.ws_row};
+}
+
+auto Session::read() -> esc::Event
+{
+    auto event = backend_.read ? backend_.read() : esc::read();
+    if (auto* const recorder = input_recorder_.load(); recorder != nullptr)
+        recorder->record(event);
+    return event;
+}
+
+}  // namespace ox
@@ -3,31 +3,36 @@
 #include <signals_light/signal.hpp>
 
 #include <termox/system/key.hpp>
+#include <termox/system/session.hpp>
 
 namespace ox {
 
 auto Shortcuts::add_shortcut(Key k) -> sl::Signal<void()>&
 {
-    if (shortcuts_.count(k) == 0)
-        shortcuts_[k] = sl::Signal<void()>{};
-    return shortcuts_.at(k);
+    auto& shortcuts = state().shortcuts;
+    if (shortcuts.count(k) == 0)
+        shortcuts[k] = sl::Signal<void()>{};
+    return shortcuts.at(k);
 }
 
-void Shortcuts::remove_shortcut(Key k) { shortcuts_.erase(k); }
+void Shortcuts::remove_shortcut(Key k) { state().shortcuts.erase(k); }
 
-void Shortcuts::clear() { shortcuts_.clear(); }
+void Shortcuts::clear() { state().shortcuts.clear(); }
 
 auto Shortcuts::send_key(Key k) -> bool
 {
-    if (enabled_ && shortcuts_.count(k) == 1) {
-        shortcuts_[k]();
+    auto& s = state();
+    if (s.enabled && s.shortcuts.count(k) == 1) {
+        s.shortcuts[k]();
         return true;
     }
     return false;
 }
 
-void Shortcuts::disable_all() { enabled_ = false; }
+void Shortcuts::disable_all() { state().enabled = false; }
 
-void Shortcuts::enable_all() { enabled_ = true; }
+void Shortcuts::enable_all() { state().enabled = true; }
+
+auto Shortcuts::state() -> State& { return Session::current().shortcuts_; }
 
 }  // namespace ox
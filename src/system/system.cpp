@@ -17,12 +17,15 @@
 #include <termox/system/event.hpp>
 #include <termox/system/event_loop.hpp>
 #include <termox/system/event_queue.hpp>
+#include <termox/system/profiler.hpp>
+#include <termox/system/session.hpp>
 #include <termox/system/system.hpp>
 #include <termox/terminal/key_mode.hpp>
 #include <termox/terminal/mouse_mode.hpp>
 #include <termox/terminal/signals.hpp>
 #include <termox/terminal/terminal.hpp>
 #include <termox/widget/area.hpp>
+#include <termox/widget/rect.hpp>
 #include <termox/widget/widget.hpp>
 
 namespace ox {
@@ -46,17 +49,35 @@ void System::disable_tab_focus() { detail::Focus::disable_tab_focus(); }
 
 void System::set_head(Widget* new_head)
 {
-    if (auto* const head = head_.load(); head != nullptr)
+    auto& current = Session::current().head_;
+    if (auto* const head = current.load(); head != nullptr)
         head->disable();
     if (new_head != nullptr) {
         new_head->enable(true);
         System::post_event(Resize_event{*new_head, Terminal::area()});
         detail::Focus::set(*new_head);
     }
-    head_ = new_head;
+    current = new_head;
 }
 
-auto System::head() -> Widget* { return head_.load(); }
+auto System::head() -> Widget* { return Session::current().head_.load(); }
+
+void System::show_overlay(Widget& w, Rect region, int z)
+{
+    Terminal::screen_buffers().show_layer(w, z, region);
+    w.enable();
+    System::post_event(Move_event{w, region.top_left});
+    System::post_event(Resize_event{w, region.area});
+    w.update();
+    for (Widget* const d : w.get_descendants())
+        d->update();
+}
+
+void System::hide_overlay(Widget& w)
+{
+    Terminal::screen_buffers().hide_layer(w);
+    w.disable();
+}
 
 auto System::run(Widget& head) -> int
 {
@@ -66,12 +87,13 @@ auto System::run(Widget& head) -> int
 
 auto System::run() -> int
 {
-    auto* const head = head_.load();
+    auto& session    = Session::current();
+    auto* const head = session.head_.load();
     if (head == nullptr)
         return -1;
-    auto const result = user_input_loop_.run();
+    auto const result = session.user_input_loop_.run();
     // user_input_loop_ is already stopped if you are here.
-    animation_engine_.stop();
+    session.animation_engine_.stop();
     Terminal::stop_dynamic_color_engine();
     return result;
 }
@@ -82,12 +104,16 @@ auto System::send_event(Event e) -> bool
         std::visit([](auto const& e) { return detail::send_shortcut(e); }, e);
     if (!std::visit([](auto const& e) { return detail::is_sendable(e); }, e))
         return false;
-    if (!handled) {
-        handled =
-            std::visit([](auto const& e) { return detail::filter_send(e); }, e);
-    }
-    if (!handled)
-        std::visit([](auto e) { detail::send(std::move(e)); }, std::move(e));
+    detail::profile(e, [&] {
+        if (!handled) {
+            handled = std::visit(
+                [](auto const& e) { return detail::filter_send(e); }, e);
+        }
+        if (!handled) {
+            std::visit([](auto e) { detail::send(std::move(e)); },
+                       std::move(e));
+        }
+    });
     return true;
 }
 
@@ -95,46 +121,75 @@ auto System::send_event(Paint_event e) -> bool
 {
     if (!detail::is_sendable(e))
         return false;
-    auto const handled = detail::filter_send(e);
-    if (!handled)
-        detail::send(std::move(e));
+    auto& receiver = e.receiver.get();
+    detail::profile(e, [&] {
+        if (!detail::filter_send(e))
+            detail::send(std::move(e));
+    });
+    receiver.clear_damage();
     return true;
 }
 
 auto System::send_event(Delete_event e) -> bool
 {
-    auto const handled = detail::filter_send(e);
-    if (!handled)
-        detail::send(std::move(e));
+    detail::profile(e, [&] {
+        if (!detail::filter_send(e))
+            detail::send(std::move(e));
+    });
     return true;
 }
 
-void System::post_event(Event e) { current_queue_.get().append(std::move(e)); }
+void System::post_event(Event e)
+{
+    Session::current().current_queue_.get().append(std::move(e));
+}
 
 void System::exit()
 {
-    user_input_loop_.exit(0);
+    Session::current().user_input_loop_.exit(0);
     Terminal::uninitialize();
     std::_Exit(0);
 }
 
 void System::enable_animation(Widget& w, Animation_engine::Duration_t interval)
 {
-    if (!animation_engine_.is_running())
-        animation_engine_.start();
-    animation_engine_.register_widget(w, interval);
+    auto& engine = Session::current().animation_engine_;
+    if (!engine.is_running())
+        engine.start();
+    engine.register_widget(w, interval);
 }
 
 void System::enable_animation(Widget& w, FPS fps)
 {
-    if (!animation_engine_.is_running())
-        animation_engine_.start();
-    animation_engine_.register_widget(w, fps);
+    auto& engine = Session::current().animation_engine_;
+    if (!engine.is_running())
+        engine.start();
+    engine.register_widget(w, fps);
 }
 
 void System::disable_animation(Widget& w)
 {
-    animation_engine_.unregister_widget(w);
+    Session::current().animation_engine_.unregister_widget(w);
+}
+
+void System::suspend_animation(Widget& w)
+{
+    Session::current().animation_engine_.suspend_widget(w);
+}
+
+void System::resume_animation(Widget& w)
+{
+    Session::current().animation_engine_.resume_widget(w);
+}
+
+auto System::animation_shed_counts() -> Shed_counts
+{
+    return Session::current().animation_engine_.shed_counts();
+}
+
+auto System::animation_engine() -> Animation_engine&
+{
+    return Session::current().animation_engine_;
 }
 
 void System::set_cursor(Cursor cursor, Point offset)
@@ -148,13 +203,16 @@ void System::set_cursor(Cursor cursor, Point offset)
     }
 }
 
-void System::set_current_queue(Event_queue& queue) { current_queue_ = queue; }
-
-sl::Slot<void()> System::quit = [] { System::exit(); };
+void System::set_current_queue(Event_queue& queue)
+{
+    Session::current().current_queue_ = queue;
+}
 
-detail::User_input_event_loop System::user_input_loop_;
-Animation_engine System::animation_engine_;
-std::reference_wrapper<Event_queue> System::current_queue_ =
-    user_input_loop_.event_queue();
+sl::Slot<void()> System::quit = [] {
+    if (auto& session = Session::current(); session.is_default())
+        System::exit();
+    else
+        session.exit(0);
+};
 
 }  // namespace ox
@@ -97,6 +97,55 @@ void Canvas::swap(Canvas& x)
     this->area_   = std::move(x_area);
 }
 
+Color_occupancy::Color_occupancy(int height)
+    : height_{height}, counts_(256 * height, 0)
+{
+    totals_.fill(0);
+}
+
+void Color_occupancy::rebuild(Canvas const& canvas)
+{
+    height_ = canvas.area().height;
+    counts_.assign(256 * height_, 0);
+    totals_.fill(0);
+    auto const width = canvas.area().width;
+    auto iter        = std::cbegin(canvas);
+    for (auto y = 0; y < height_; ++y) {
+        for (auto x = 0; x < width; ++x, ++iter)
+            this->add(y, iter->brush, 1);
+    }
+}
+
+void Color_occupancy::replace(int y, Glyph previous, Glyph next)
+{
+    if (previous.brush.background == next.brush.background &&
+        previous.brush.foreground == next.brush.foreground) {
+        return;
+    }
+    this->add(y, previous.brush, -1);
+    this->add(y, next.brush, 1);
+}
+
+auto Color_occupancy::count(Color c, int y) const -> int
+{
+    assert(y < height_);
+    return counts_[c.value * height_ + y];
+}
+
+auto Color_occupancy::total(Color c) const -> int { return totals_[c.value]; }
+
+auto Color_occupancy::height() const -> int { return height_; }
+
+void Color_occupancy::add(int y, Brush b, int amount)
+{
+    counts_[b.background.value * height_ + y] += amount;
+    totals_[b.background.value] += amount;
+    if (b.foreground != b.background) {
+        counts_[b.foreground.value * height_ + y] += amount;
+        totals_[b.foreground.value] += amount;
+    }
+}
+
 void merge(Canvas const& next, Canvas& current)
 {
     assert(next.area() == current.area());
@@ -108,6 +157,24 @@ void merge(Canvas const& next, Canvas& current)
     }
 }
 
+void merge(Canvas const& next, Canvas& current, Color_occupancy& occupancy)
+{
+    assert(next.area() == current.area());
+    assert(occupancy.height() == current.area().height);
+    auto const width  = next.area().width;
+    auto const height = next.area().height;
+    auto next_iter    = std::cbegin(next);
+    auto current_iter = std::begin(current);
+    for (auto y = 0; y < height; ++y) {
+        for (auto x = 0; x < width; ++x, ++next_iter, ++current_iter) {
+            if (next_iter->symbol != U'\0' && *next_iter != *current_iter) {
+                occupancy.replace(y, *current_iter, *next_iter);
+                *current_iter = *next_iter;
+            }
+        }
+    }
+}
+
 void merge_and_diff(Canvas const& next, Canvas& current, Canvas::Diff& diff_out)
 {
     assert(next.area() == current.area());
@@ -137,6 +204,53 @@ void generate_color_diff(Color color,
     }
 }
 
+void merge_and_diff(Canvas const& next,
+                    Canvas& current,
+                    Canvas::Diff& diff_out,
+                    Color_occupancy& occupancy)
+{
+    assert(next.area() == current.area());
+    assert(occupancy.height() == current.area().height);
+    diff_out.clear();
+    auto const width  = next.area().width;
+    auto const height = next.area().height;
+    auto next_iter    = std::cbegin(next);
+    auto current_iter = std::begin(current);
+    for (auto y = 0; y < height; ++y) {
+        for (auto x = 0; x < width; ++x, ++next_iter, ++current_iter) {
+            if (next_iter->symbol != U'\0' && *next_iter != *current_iter) {
+                diff_out.push_back({{x, y}, *next_iter});
+                occupancy.replace(y, *current_iter, *next_iter);
+                *current_iter = *next_iter;
+            }
+        }
+    }
+}
+
+void generate_color_diff(Color color,
+                         Canvas const& canvas,
+                         Color_occupancy const& occupancy,
+                         Canvas::Diff& diff_out)
+{
+    assert(occupancy.height() == canvas.area().height);
+    diff_out.clear();
+    if (occupancy.total(color) == 0)
+        return;
+    auto const width = canvas.area().width;
+    for (auto y = 0; y < occupancy.height(); ++y) {
+        auto remaining = occupancy.count(color, y);
+        auto iter      = std::next(std::cbegin(canvas), y * width);
+        for (auto x = 0; remaining != 0; ++x, ++iter) {
+            assert(x < width);
+            auto const g = *iter;
+            if (g.brush.foreground == color || g.brush.background == color) {
+                diff_out.push_back({{x, y}, g});
+                --remaining;
+            }
+        }
+    }
+}
+
 void generate_full_diff(Canvas const& canvas, Canvas::Diff& diff_out)
 {
     diff_out.clear();
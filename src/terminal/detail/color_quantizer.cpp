@@ -0,0 +1,226 @@
+#include <termox/terminal/detail/color_quantizer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <termox/painter/color.hpp>
+#include <termox/widget/point.hpp>
+
+namespace {
+
+/// 5 bits per channel, 32x32x32 table.
+auto constexpr lut_bits = 5;
+auto constexpr lut_size = 1 << (3 * lut_bits);
+
+using Lookup_table = std::array<std::uint8_t, lut_size>;
+
+struct Lab {
+    float l, a, b;
+};
+
+/// Convert an sRGB color to CIE Lab, D65 white point.
+[[nodiscard]] auto to_lab(float r, float g, float b) -> Lab
+{
+    auto const linear = [](float c) {
+        c /= 255.f;
+        return c <= 0.04045f ? c / 12.92f
+                             : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    };
+    r = linear(r);
+    g = linear(g);
+    b = linear(b);
+    auto const x = (r * 0.4124f + g * 0.3576f + b * 0.1805f) / 0.95047f;
+    auto const y = (r * 0.2126f + g * 0.7152f + b * 0.0722f);
+    auto const z = (r * 0.0193f + g * 0.1192f + b * 0.9505f) / 1.08883f;
+    auto const f = [](float t) {
+        return t > 0.008856f ? std::cbrt(t) : (7.787f * t + 16.f / 116.f);
+    };
+    return {116.f * f(y) - 16.f, 500.f * (f(x) - f(y)), 200.f * (f(y) - f(z))};
+}
+
+[[nodiscard]] auto distance(Lab x, Lab y) -> float
+{
+    auto const dl = x.l - y.l;
+    auto const da = x.a - y.a;
+    auto const db = x.b - y.b;
+    return dl * dl + da * da + db * db;
+}
+
+/// Return the RGB value of xterm palette index \p i, default system colors.
+[[nodiscard]] auto xterm_rgb(int i) -> std::array<int, 3>
+{
+    constexpr auto system = std::array<std::uint32_t, 16>{
+        0x000000, 0xcd0000, 0x00cd00, 0xcdcd00, 0x0000ee, 0xcd00cd,
+        0x00cdcd, 0xe5e5e5, 0x7f7f7f, 0xff0000, 0x00ff00, 0xffff00,
+        0x5c5cff, 0xff00ff, 0x00ffff, 0xffffff};
+    if (i < 16) {
+        auto const hex = system[i];
+        return {int(hex >> 16), int((hex >> 8) & 0xFF), int(hex & 0xFF)};
+    }
+    if (i < 232) {
+        constexpr auto levels = std::array<int, 6>{0, 95, 135, 175, 215, 255};
+        i -= 16;
+        return {levels[i / 36], levels[(i / 6) % 6], levels[i % 6]};
+    }
+    auto const gray = 8 + (i - 232) * 10;
+    return {gray, gray, gray};
+}
+
+/// Build a table mapping each 5 bit per channel cell to the nearest index.
+/** Candidate indices are in the range [first, last), less those in \p
+ *  excluded. \p excluded is ignored if it would leave no candidates. */
+[[nodiscard]] auto build_table(int first,
+                               int last,
+                               ox::detail::Palette_mask const& excluded = {})
+    -> Lookup_table
+{
+    auto indices = std::vector<int>{};
+    for (auto i = first; i < last; ++i) {
+        if (!excluded.test(i))
+            indices.push_back(i);
+    }
+    if (indices.empty()) {
+        for (auto i = first; i < last; ++i)
+            indices.push_back(i);
+    }
+    auto candidates = std::array<Lab, 256>{};
+    for (auto const i : indices) {
+        auto const [r, g, b] = xterm_rgb(i);
+        candidates[i]        = to_lab(r, g, b);
+    }
+    // Spread cell values over [0, 255] so pure black and white are exact.
+    auto constexpr max_cell = (1 << lut_bits) - 1;
+    auto const value        = [](int cell) { return cell * 255.f / max_cell; };
+    auto table              = Lookup_table{};
+    for (auto i = 0; i < lut_size; ++i) {
+        auto const r   = value(i >> (2 * lut_bits));
+        auto const g   = value((i >> lut_bits) & max_cell);
+        auto const b   = value(i & max_cell);
+        auto const lab = to_lab(r, g, b);
+        auto nearest   = indices.front();
+        auto best      = distance(lab, candidates[nearest]);
+        for (auto const c : indices) {
+            if (auto const d = distance(lab, candidates[c]); d < best) {
+                best    = d;
+                nearest = c;
+            }
+        }
+        table[i] = static_cast<std::uint8_t>(nearest);
+    }
+    return table;
+}
+
+/// Return the cached table for a terminal with \p color_count colors.
+[[nodiscard]] auto table_for(std::uint16_t color_count,
+                             ox::detail::Palette_mask const& excluded)
+    -> Lookup_table const&
+{
+    if (excluded.any()) {
+        // Only changes with the Palette, so the last one is all that is kept.
+        thread_local auto last_count    = std::uint16_t{0};
+        thread_local auto last_excluded = ox::detail::Palette_mask{};
+        thread_local auto last_table    = Lookup_table{};
+        if (color_count != last_count || excluded != last_excluded) {
+            if (color_count >= 256)
+                last_table = build_table(16, 256, excluded);
+            else if (color_count >= 16)
+                last_table = build_table(0, 16, excluded);
+            else
+                last_table = build_table(0, 8, excluded);
+            last_count    = color_count;
+            last_excluded = excluded;
+        }
+        return last_table;
+    }
+    if (color_count >= 256) {
+        static auto const xterm256 = build_table(16, 256);
+        return xterm256;
+    }
+    if (color_count >= 16) {
+        static auto const system16 = build_table(0, 16);
+        return system16;
+    }
+    static auto const system8 = build_table(0, 8);
+    return system8;
+}
+
+[[nodiscard]] auto lookup(Lookup_table const& table, int r, int g, int b)
+    -> ox::Color_index
+{
+    auto constexpr shift = 8 - lut_bits;
+    auto const index =
+        ((r >> shift) << (2 * lut_bits)) | ((g >> shift) << lut_bits) |
+        (b >> shift);
+    return {table[index]};
+}
+
+}  // namespace
+
+namespace ox::detail {
+
+auto quantize(True_color tc,
+              std::uint16_t color_count,
+              Palette_mask const& excluded) -> Color_index
+{
+    return lookup(table_for(color_count, excluded), tc.red, tc.green,
+                  tc.blue);
+}
+
+auto quantize_dithered(True_color tc,
+                       std::uint16_t color_count,
+                       Point p,
+                       Palette_mask const& excluded) -> Color_index
+{
+    constexpr auto bayer = std::array<int, 16>{0,  8,  2,  10, 12, 4,  14, 6,
+                                               3,  11, 1,  9,  15, 7,  13, 5};
+    // Roughly the distance between neighboring palette colors.
+    auto const spread    = color_count >= 256 ? 40 : 128;
+    auto const threshold = bayer[(p.y & 3) * 4 + (p.x & 3)];
+    auto const offset    = (threshold * 2 - 15) * spread / 32;
+    auto const clamp     = [](int x) { return std::clamp(x, 0, 255); };
+    return lookup(table_for(color_count, excluded), clamp(tc.red + offset),
+                  clamp(tc.green + offset), clamp(tc.blue + offset));
+}
+
+auto nearest_palette_colors(Palette const& palette) -> std::vector<Color>
+{
+    auto candidates = std::vector<std::pair<Color, Lab>>{};
+    for (auto const& def : palette) {
+        if (auto const* i = std::get_if<Color_index>(&def.value)) {
+            auto const [r, g, b] = xterm_rgb(i->value);
+            candidates.push_back({def.color, to_lab(r, g, b)});
+        }
+        else if (auto const* tc = std::get_if<True_color>(&def.value)) {
+            candidates.push_back(
+                {def.color, to_lab(tc->red, tc->green, tc->blue)});
+        }
+    }
+    auto result = std::vector<Color>{};
+    result.reserve(256);
+    for (auto i = 0; i < 256; ++i) {
+        if (candidates.empty()) {
+            result.push_back(Color{static_cast<Color::Value_t>(i)});
+            continue;
+        }
+        auto const [r, g, b] = xterm_rgb(i);
+        auto const lab       = to_lab(r, g, b);
+        auto nearest         = candidates.front().first;
+        auto best            = distance(lab, candidates.front().second);
+        for (auto const& [color, candidate] : candidates) {
+            if (auto const d = distance(lab, candidate); d < best) {
+                best    = d;
+                nearest = color;
+            }
+        }
+        result.push_back(nearest);
+    }
+    return result;
+}
+
+}  // namespace ox::detail
@@ -1,31 +1,53 @@
 #include <termox/terminal/detail/screen_buffers.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+#include <termox/painter/glyph.hpp>
 #include <termox/terminal/detail/canvas.hpp>
 #include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
+#include <termox/widget/widget.hpp>
 
 namespace ox::detail {
 
-Screen_buffers::Screen_buffers(ox::Area a) : current{a}, next{a} {}
+Screen_buffers::Screen_buffers(ox::Area a)
+    : current{a}, next{a}, occupancy_{a.height}, base_{a}
+{
+    occupancy_.rebuild(current);
+}
 
 void Screen_buffers::resize(ox::Area a)
 {
     current.resize(a);
     next.resize(a);
+    occupancy_.rebuild(current);
+    base_.resize(a);
+    for (Layer& l : layers_)
+        l.canvas.resize(a);
+    if (!layers_.empty())
+        stale_.push_back({{0, 0}, a});
 }
 
 auto Screen_buffers::area() const -> Area { return current.area(); }
 
-void Screen_buffers::merge() { ::ox::detail::merge(next, current); }
+void Screen_buffers::merge()
+{
+    ::ox::detail::merge(next, current, occupancy_);
+}
 
 auto Screen_buffers::merge_and_diff() -> Canvas::Diff const&
 {
-    ::ox::detail::merge_and_diff(next, current, diff_);
+    ::ox::detail::merge_and_diff(next, current, diff_, occupancy_);
     return diff_;
 }
 
 auto Screen_buffers::generate_color_diff(Color c) -> Canvas::Diff const&
 {
-    ::ox::detail::generate_color_diff(c, current, diff_);
+    ::ox::detail::generate_color_diff(c, current, occupancy_, diff_);
     return diff_;
 }
 
@@ -35,4 +57,126 @@ auto Screen_buffers::current_screen_as_diff() -> Canvas::Diff const&
     return diff_;
 }
 
+void Screen_buffers::show_layer(Widget& owner, int z, Rect region)
+{
+    // Start keeping the base layer, it is what is on screen.
+    if (layers_.empty() && stale_.empty()) {
+        base_.resize(current.area());
+        std::copy(std::cbegin(current), std::cend(current), std::begin(base_));
+    }
+    auto const iter =
+        std::find_if(std::begin(layers_), std::end(layers_),
+                     [&](Layer const& l) { return l.owner == &owner; });
+    if (iter != std::end(layers_)) {
+        stale_.push_back(iter->region);
+        iter->z        = z;
+        iter->region   = region;
+        iter->is_dirty = true;
+    }
+    else
+        layers_.push_back({&owner, z, region, Canvas{current.area()}});
+    std::stable_sort(std::begin(layers_), std::end(layers_),
+                     [](Layer const& a, Layer const& b) { return a.z < b.z; });
+}
+
+void Screen_buffers::hide_layer(Widget const& owner)
+{
+    auto const iter =
+        std::find_if(std::begin(layers_), std::end(layers_),
+                     [&](Layer const& l) { return l.owner == &owner; });
+    if (iter == std::end(layers_))
+        return;
+    stale_.push_back(iter->region);
+    layers_.erase(iter);
+}
+
+auto Screen_buffers::canvas_for(Widget const& w) -> Canvas&
+{
+    if (layers_.empty())
+        return next;
+    for (Widget const* x = &w; x != nullptr; x = x->parent()) {
+        for (Layer& l : layers_) {
+            if (l.owner == x) {
+                l.is_dirty = true;
+                return l.canvas;
+            }
+        }
+    }
+    return next;
+}
+
+auto Screen_buffers::layer_at(Point p) const -> Widget*
+{
+    for (auto i = std::crbegin(layers_); i != std::crend(layers_); ++i) {
+        if (contains(i->region, p))
+            return i->owner;
+    }
+    return nullptr;
+}
+
+auto Screen_buffers::layer_owners() const -> std::vector<Widget*>
+{
+    auto owners = std::vector<Widget*>{};
+    owners.reserve(layers_.size());
+    for (auto const& layer : layers_)
+        owners.push_back(layer.owner);
+    return owners;
+}
+
+void Screen_buffers::compose()
+{
+    if (layers_.empty() && stale_.empty())
+        return;
+    auto const area = next.area();
+
+    // Keep base_ up to date, base changes beneath a layer are not shown.
+    for (auto y = 0; y < area.height; ++y) {
+        for (auto x = 0; x < area.width; ++x) {
+            auto& glyph = next.at({x, y});
+            if (glyph.symbol == U'\0')
+                continue;
+            base_.at({x, y}) = glyph;
+            if (auto const top = this->layer_glyph_at({x, y}); top)
+                glyph = *top;
+        }
+    }
+
+    for (Layer& l : layers_) {
+        if (l.is_dirty)
+            stale_.push_back(l.region);
+        l.is_dirty = false;
+    }
+    for (Rect const r : stale_) {
+        auto const visible = intersection(r, {{0, 0}, area});
+        auto const x_end   = visible.top_left.x + visible.area.width;
+        auto const y_end   = visible.top_left.y + visible.area.height;
+        for (auto y = visible.top_left.y; y < y_end; ++y) {
+            for (auto x = visible.top_left.x; x < x_end; ++x)
+                next.at({x, y}) = this->composite_at({x, y});
+        }
+    }
+    stale_.clear();
+}
+
+auto Screen_buffers::last_diff() const -> Canvas::Diff const& { return diff_; }
+
+auto Screen_buffers::composite_at(Point p) const -> Glyph
+{
+    if (auto const top = this->layer_glyph_at(p); top)
+        return *top;
+    return base_.at(p);
+}
+
+auto Screen_buffers::layer_glyph_at(Point p) const -> std::optional<Glyph>
+{
+    for (auto i = std::crbegin(layers_); i != std::crend(layers_); ++i) {
+        if (!contains(i->region, p))
+            continue;
+        auto const glyph = i->canvas.at(p);
+        if (glyph.symbol != U'\0')
+            return glyph;
+    }
+    return std::nullopt;
+}
+
 }  // namespace ox::detail
@@ -43,6 +43,8 @@ auto Dynamic_color_engine::is_empty() const -> bool
 
 void Dynamic_color_engine::start()
 {
+    loop_.event_queue().set_budget(frame_budget);
+    loop_.event_queue().set_backpressure(backpressure);
     loop_.run_async([this](Event_queue& q) { this->loop_function(q); });
 }
 
@@ -52,6 +54,11 @@ void Dynamic_color_engine::stop()
     loop_.wait();
 }
 
+auto Dynamic_color_engine::shed_counts() const -> Shed_counts
+{
+    return loop_.event_queue().shed_counts();
+}
+
 auto Dynamic_color_engine::get_dynamic_color_event() -> Dynamic_color_event
 {
     auto processed = Dynamic_color_event::Processed_colors{};
@@ -61,7 +68,7 @@ auto Dynamic_color_engine::get_dynamic_color_event() -> Dynamic_color_event
     }
     {
         auto const lock    = this->Lockable::lock();
-        auto next_interval = [&, this] {
+        auto next_interval = [&, this]() -> Duration_t {
             return std::min_element(std::cbegin(data_), std::cend(data_),
                                     [](auto const& a, auto const& b) {
                                         return a.dynamic.interval <
@@ -91,6 +98,8 @@ void Dynamic_color_engine::loop_function(Event_queue& queue)
     // The first call to this returns immediately.
     timer_.wait();
     timer_.begin();
+    if (!queue.begin_frame())
+        return;
     // This resets the Timer interval.
     queue.append(this->get_dynamic_color_event());
 }
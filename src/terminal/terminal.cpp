@@ -1,7 +1,10 @@
 #include <termox/terminal/terminal.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <csignal>
+#include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <map>
@@ -12,14 +15,19 @@
 
 #include <esc/esc.hpp>
 
-#include <termox/common/u32_to_mb.hpp>
 #include <termox/painter/color.hpp>
 #include <termox/painter/detail/is_paintable.hpp>
+#include <termox/painter/grapheme.hpp>
 #include <termox/painter/palette/dawn_bringer16.hpp>
+#include <termox/painter/trait.hpp>
 #include <termox/system/detail/find_widget_at.hpp>
 #include <termox/system/event.hpp>
+#include <termox/system/profiler.hpp>
+#include <termox/system/session.hpp>
 #include <termox/system/system.hpp>
 #include <termox/terminal/detail/canvas.hpp>
+#include <termox/terminal/detail/color_tables.hpp>
+#include <termox/terminal/detail/color_quantizer.hpp>
 #include <termox/widget/widget.hpp>
 
 extern "C" void uninit_and_exit(int /* sig*/)
@@ -30,18 +38,39 @@ extern "C" void uninit_and_exit(int /* sig*/)
 
 namespace {
 
-using Color_store = std::map<ox::Color, std::string>;
+/// The first Color_index that can be reserved, counting down to 16.
+auto constexpr first_palette_slot = 255;
 
-auto fg_store = Color_store{};
-
-auto bg_store = Color_store{};
+/// Return the dithered palette index for \p c at \p p, if it should be used.
+/** Returns std::nullopt if \p dithering is off, the terminal has true color,
+ *  or \p c is not defined by a True_color. */
+[[nodiscard]] auto dithered_index(ox::detail::Color_tables const& colors,
+                                  bool dithering,
+                                  ox::Color c,
+                                  ox::Point p) -> std::optional<ox::Color_index>
+{
+    if (!dithering || esc::has_true_color())
+        return std::nullopt;
+    auto const iter = colors.true_colors.find(c);
+    if (iter == std::cend(colors.true_colors))
+        return std::nullopt;
+    return ox::detail::quantize_dithered(
+        iter->second, esc::color_palette_size(), p, colors.reserved_slots);
+}
 
 /// Return the terminal escape sequence for the given Color \p c as foreground.
 /** Returns the terminal default foreground color sequence if \p c is not in the
- *  currently set palette. */
-[[nodiscard]] auto get_fg_sequence(ox::Color c) -> std::string
+ *  currently set palette. \p p is the screen position, used for dithering. */
+[[nodiscard]] auto get_fg_sequence(ox::detail::Color_tables const& colors,
+                                   bool dithering,
+                                   ox::Color c,
+                                   ox::Point p) -> std::string
 {
-    if (auto const iter = fg_store.find(c); iter != std::cend(fg_store))
+    if (auto const index = dithered_index(colors, dithering, c, p);
+        index.has_value()) {
+        return esc::escape(foreground(*index));
+    }
+    if (auto const iter = colors.fg.find(c); iter != std::cend(colors.fg))
         return iter->second;
     else
         return esc::escape(foreground(esc::Default_color{}));
@@ -49,28 +78,174 @@ auto bg_store = Color_store{};
 
 /// Return the terminal escape sequence for the given Color \p c as background.
 /** Returns the terminal default background color sequence if \p c is not in the
- *  currently set palette. */
-[[nodiscard]] auto get_bg_sequence(ox::Color c) -> std::string
+ *  currently set palette. \p p is the screen position, used for dithering. */
+[[nodiscard]] auto get_bg_sequence(ox::detail::Color_tables const& colors,
+                                   bool dithering,
+                                   ox::Color c,
+                                   ox::Point p) -> std::string
 {
-    if (auto const iter = bg_store.find(c); iter != std::cend(bg_store))
+    if (auto const index = dithered_index(colors, dithering, c, p);
+        index.has_value()) {
+        return esc::escape(background(*index));
+    }
+    if (auto const iter = colors.bg.find(c); iter != std::cend(colors.bg))
         return iter->second;
     else
         return esc::escape(background(esc::Default_color{}));
 }
 
+/// Return true if \p b uses a Color that is dithered per cell.
+/** Cells of a run must be written with the same escape sequences. */
+[[nodiscard]] auto is_dithered(ox::detail::Color_tables const& colors,
+                               bool dithering,
+                               ox::Brush b) -> bool
+{
+    if (!dithering || esc::has_true_color())
+        return false;
+    auto const& tc = colors.true_colors;
+    return tc.count(b.foreground) != 0 || tc.count(b.background) != 0;
+}
+
+/// Return true if \p g can be written by erasing with its background color.
+/** A blank is a space without Traits, over any background. Erased cells are
+ *  filled with the current background color, so the Brush of \p g must be
+ *  set first. */
+[[nodiscard]] auto is_blank(ox::Glyph g) -> bool
+{
+    return g.symbol == U' ' && g.brush.traits == ox::Traits{};
+}
+
+/// Return true if \p g is left as is by a clear of the screen.
+/** The screen is cleared over Color::Background. */
+[[nodiscard]] auto is_cleared_blank(ox::Glyph g) -> bool
+{
+    return is_blank(g) && g.brush.background == ox::Color::Background;
+}
+
+/// Return the length of the run of identical Glyphs starting at diff[i].
+/** A run is a sequence of horizontally adjacent cells within a single row. */
+[[nodiscard]] auto run_length(ox::detail::Canvas::Diff const& diff,
+                              std::size_t i) -> int
+{
+    auto const [first, glyph] = diff[i];
+    auto length               = 1;
+    for (auto j = i + 1; j < diff.size(); ++j, ++length) {
+        auto const [point, g] = diff[j];
+        if (point.y != first.y || point.x != first.x + length || g != glyph)
+            break;
+    }
+    return length;
+}
+
+/// Return the CSI sequence with the single parameter \p n and \p final.
+[[nodiscard]] auto csi(int n, char final) -> std::string
+{
+    return "\033[" + std::to_string(n) + final;
+}
+
+/// Append the Traits and Colors of \p b, as seen at \p p, to \p sequence.
+void append_brush(std::string& sequence,
+                  ox::detail::Color_tables const& colors,
+                  bool dithering,
+                  ox::Brush b,
+                  ox::Point p)
+{
+    if (::esc::traits() != b.traits)
+        sequence.append(esc::escape(b.traits));
+    sequence.append(get_fg_sequence(colors, dithering, b.foreground, p));
+    sequence.append(get_bg_sequence(colors, dithering, b.background, p));
+}
+
+/// Append \p length blanks starting at \p p, by erasing if it is shorter.
+/** Uses EL if the run reaches the end of the row, otherwise ECH. Neither
+ *  moves the cursor. */
+void append_blanks(std::string& sequence, ox::Point p, int length, int width)
+{
+    auto const erase =
+        p.x + length == width ? std::string{"\033[K"} : csi(length, 'X');
+    if (erase.size() < static_cast<std::size_t>(length))
+        sequence.append(erase);
+    else
+        sequence.append(static_cast<std::size_t>(length), ' ');
+}
+
+/// Append \p count copies of \p symbol, using REP if it is shorter.
+/** REP repeats the last written character, so \p symbol must be written once
+ *  by the caller before this. REP would only repeat the last code point of a
+ *  grapheme cluster, so \p is_cluster symbols are always written out. */
+void append_repeats(std::string& sequence,
+                    std::string const& symbol,
+                    bool is_cluster,
+                    int count)
+{
+    if (count <= 0)
+        return;
+    auto const rep = csi(count, 'b');
+    if (!is_cluster &&
+        rep.size() < symbol.size() * static_cast<std::size_t>(count))
+        sequence.append(rep);
+    else {
+        for (auto i = 0; i < count; ++i)
+            sequence.append(symbol);
+    }
+}
+
 /// Convert a Canvas::Diff into a terminal escape sequence.
-[[nodiscard]] auto to_escape_sequence(ox::detail::Canvas::Diff const& diff)
-    -> std::string
+/** If \p compress is true, runs of identical Glyphs are written once and
+ *  repeated with REP, blank runs are erased with ECH or EL, and a Diff that
+ *  covers the entire \p screen is started with a clear of the screen, after
+ *  which blanks over Color::Background are skipped. Erasing relies on the
+ *  terminal filling erased cells with the current background color, BCE. */
+[[nodiscard]] auto to_escape_sequence(ox::detail::Canvas::Diff const& diff,
+                                      ox::detail::Color_tables const& colors,
+                                      bool dithering,
+                                      bool compress,
+                                      ox::Area screen) -> std::string
 {
+    using esc::escape;
     auto sequence = std::string{};
-    for (auto [point, glyph] : diff) {
-        using esc::escape;
+    if (!compress) {
+        for (auto [point, glyph] : diff) {
+            sequence.append(escape(esc::Cursor_position{point}));
+            append_brush(sequence, colors, dithering, glyph.brush, point);
+            sequence.append(ox::grapheme_to_mb(glyph.symbol));
+        }
+        return sequence;
+    }
+
+    auto const cells = static_cast<std::size_t>(screen.width) *
+                       static_cast<std::size_t>(screen.height);
+    auto const is_cleared =
+        cells != 0 && diff.size() == cells &&
+        !is_dithered(colors, dithering, ox::Brush{bg(ox::Color::Background)}) &&
+        std::any_of(std::cbegin(diff), std::cend(diff),
+                    [](auto const& cell) {
+                        return is_cleared_blank(cell.second);
+                    });
+    if (is_cleared) {
+        sequence.append(get_bg_sequence(colors, dithering,
+                                        ox::Color::Background, {0, 0}));
+        sequence.append("\033[2J");
+    }
+
+    for (auto i = std::size_t{0}; i < diff.size();) {
+        auto const [point, glyph] = diff[i];
+        auto const length = is_dithered(colors, dithering, glyph.brush)
+                                ? 1
+                                : run_length(diff, i);
+        i += static_cast<std::size_t>(length);
+        if (is_cleared && is_cleared_blank(glyph))
+            continue;
         sequence.append(escape(esc::Cursor_position{point}));
-        if (::esc::traits() != glyph.brush.traits)
-            sequence.append(escape(glyph.brush.traits));
-        sequence.append(get_fg_sequence(glyph.brush.foreground));
-        sequence.append(get_bg_sequence(glyph.brush.background));
-        sequence.append(ox::u32_to_mb(glyph.symbol));
+        append_brush(sequence, colors, dithering, glyph.brush, point);
+        if (is_blank(glyph))
+            append_blanks(sequence, point, length, screen.width);
+        else {
+            auto const symbol = ox::grapheme_to_mb(glyph.symbol);
+            sequence.append(symbol);
+            append_repeats(sequence, symbol,
+                           ox::is_grapheme_cluster(glyph.symbol), length - 1);
+        }
     }
     return sequence;
 }
@@ -87,16 +262,42 @@ struct Color_sequences {
 }
 
 /// Return the terminal escape sequence to set the fg/bg to True_color \p x.
-[[nodiscard]] auto color_sequences(ox::True_color x) -> Color_sequences
+/** If the terminal does not support true color, \p x is quantized to the
+ *  nearest color in the terminal's palette that is not one of \p reserved. */
+[[nodiscard]] auto color_sequences(ox::True_color x,
+                                   ox::detail::Palette_mask const& reserved)
+    -> Color_sequences
 {
+    if (!esc::has_true_color()) {
+        return color_sequences(
+            ox::detail::quantize(x, esc::color_palette_size(), reserved));
+    }
     return {esc::escape(foreground(x)), esc::escape(background(x))};
 }
 
-/// Return the terminal escape sequence to set the fg/bg to \p x.
-/** This calls on x.get_value() to get the initial color value to set. */
-[[nodiscard]] auto color_sequences(ox::Dynamic_color x) -> Color_sequences
+/// Return the OSC 4 sequence that redefines palette index \p x as \p tc.
+[[nodiscard]] auto palette_redefinition(ox::Color_index x, ox::True_color tc)
+    -> std::string
+{
+    auto constexpr hex = "0123456789abcdef";
+    auto const to_hex  = [&](std::uint8_t v) -> std::string {
+        return {hex[v >> 4], hex[v & 0xF]};
+    };
+    return "\033]4;" + std::to_string(x.value) + ";rgb:" + to_hex(tc.red) +
+           '/' + to_hex(tc.green) + '/' + to_hex(tc.blue) + "\033\\";
+}
+
+/// Return the OSC 104 sequence that resets every reserved palette index.
+/** Returns an empty string if there are no reserved indices. */
+[[nodiscard]] auto palette_slots_reset(
+    std::map<ox::Color, ox::Color_index> const& palette_slots) -> std::string
 {
-    return color_sequences(x.get_value());
+    if (palette_slots.empty())
+        return "";
+    auto sequence = std::string{"\033]104"};
+    for (auto const& [color, index] : palette_slots)
+        sequence.append(';' + std::to_string(index.value));
+    return sequence.append("\033\\");
 }
 
 /// Turn an esc:: mouse event into a pair of Receiver and local Mouse object.
@@ -180,72 +381,217 @@ template <typename T>
 
 namespace ox {
 
+auto Terminal::palette_changed() -> sl::Signal<void(Palette const&)>&
+{
+    return Session::current().palette_changed_;
+}
+
+auto Terminal::screen_buffers() -> detail::Screen_buffers&
+{
+    return Session::current().screen_buffers_;
+}
+
 void Terminal::initialize(Mouse_mode mouse_mode,
                           Key_mode key_mode,
                           Signals signals)
 {
-    if (is_initialized_)
+    auto& session = Session::current();
+    if (session.is_initialized_)
         return;
-    ::esc::initialize_interactive_terminal(mouse_mode, key_mode, signals);
-    if (handle_sigint_)
-        std::signal(SIGINT, &uninit_and_exit);
+    if (session.is_stdio()) {
+        ::esc::initialize_interactive_terminal(mouse_mode, key_mode, signals);
+        if (handle_sigint_)
+            std::signal(SIGINT, &uninit_and_exit);
+    }
     Terminal::set_palette(dawn_bringer16::palette);
-    screen_buffers.resize(Terminal::area());
-    is_initialized_ = true;
+    session.screen_buffers_.resize(Terminal::area());
+    session.is_initialized_ = true;
 }
 
 void Terminal::uninitialize()
 {
-    if (!is_initialized_)
+    auto& session = Session::current();
+    if (!session.is_initialized_)
         return;
-    ::esc::uninitialize_terminal();
-    is_initialized_ = false;
+    session.write(palette_slots_reset(session.colors_.palette_slots));
+    session.flush();
+    session.colors_.palette_slots.clear();
+    session.colors_.reserved_slots.reset();
+    if (session.is_stdio())
+        ::esc::uninitialize_terminal();
+    session.is_initialized_ = false;
 }
 
-auto Terminal::area() -> Area { return ::esc::terminal_area(); }
+auto Terminal::area() -> Area { return Session::current().area(); }
 
 void Terminal::refresh()
 {
-    if (full_repaint_) {
-        screen_buffers.merge();
-        esc::write(to_escape_sequence(screen_buffers.current_screen_as_diff()));
-        full_repaint_ = false;
+    auto& session  = Session::current();
+    auto& buffers  = session.screen_buffers_;
+    auto const& cs = session.colors_;
+    buffers.compose();
+    detail::profile_overlay();  // After compose(), so layers never see it.
+    if (session.full_repaint_) {
+        buffers.merge();
+        session.write(to_escape_sequence(buffers.current_screen_as_diff(), cs,
+                                         session.dithering_,
+                                         session.run_compression_,
+                                         buffers.area()));
+        session.full_repaint_ = false;
     }
-    else
-        esc::write(to_escape_sequence(screen_buffers.merge_and_diff()));
-    esc::flush();
-    screen_buffers.next.reset();
+    else {
+        session.write(to_escape_sequence(buffers.merge_and_diff(), cs,
+                                         session.dithering_,
+                                         session.run_compression_,
+                                         buffers.area()));
+    }
+    session.flush();
+    buffers.next.reset();
 }
 
 void Terminal::update_color_stores(Color c, True_color tc)
 {
-    fg_store[c] = esc::escape(foreground(tc));
-    bg_store[c] = esc::escape(background(tc));
+    auto& colors  = Session::current().colors_;
+    auto [fg, bg] = color_sequences(tc, colors.reserved_slots);
+    colors.fg[c]  = std::move(fg);
+    colors.bg[c]  = std::move(bg);
+    colors.true_colors.insert_or_assign(c, tc);
 }
 
 void Terminal::repaint_color(Color c)
 {
-    esc::write(to_escape_sequence(screen_buffers.generate_color_diff(c)));
-    esc::flush();
+    auto& session = Session::current();
+    auto& buffers = session.screen_buffers_;
+    session.write(to_escape_sequence(buffers.generate_color_diff(c),
+                                     session.colors_, session.dithering_,
+                                     session.run_compression_,
+                                     buffers.area()));
+    session.flush();
+}
+
+void Terminal::update_dynamic_color(Color c, True_color tc)
+{
+    auto& session = Session::current();
+    auto& colors  = session.colors_;
+    if (auto const iter = colors.palette_slots.find(c);
+        iter != std::cend(colors.palette_slots)) {
+        session.write(palette_redefinition(iter->second, tc));
+        session.flush();
+    }
+    else {
+        // Quantized colors often map to the same palette index between ticks.
+        auto const previous_fg = colors.fg[c];
+        auto const previous_bg = colors.bg[c];
+        Terminal::update_color_stores(c, tc);
+        if (session.dithering_ || colors.fg[c] != previous_fg ||
+            colors.bg[c] != previous_bg) {
+            Terminal::repaint_color(c);
+        }
+    }
+}
+
+void Terminal::set_dithering(bool enable)
+{
+    auto& dithering = Session::current().dithering_;
+    if (dithering == enable)
+        return;
+    dithering = enable;
+    Terminal::flag_full_repaint();
+}
+
+auto Terminal::is_dithering() -> bool { return Session::current().dithering_; }
+
+void Terminal::set_run_compression(bool enable)
+{
+    Session::current().run_compression_ = enable;
+}
+
+auto Terminal::is_run_compression() -> bool
+{
+    return Session::current().run_compression_;
+}
+
+void Terminal::set_dynamic_color_mode(Dynamic_color_mode mode)
+{
+    auto& session               = Session::current();
+    session.dynamic_color_mode_ = mode;
+    Terminal::set_palette(session.palette_);
+}
+
+auto Terminal::dynamic_color_mode() -> Dynamic_color_mode
+{
+    return Session::current().dynamic_color_mode_;
+}
+
+auto Terminal::dynamic_color_shed_counts() -> Shed_counts
+{
+    return Session::current().dynamic_color_engine_.shed_counts();
 }
 
 void Terminal::set_palette(Palette colors)
 {
-    dynamic_color_engine_.clear();
-    palette_ = std::move(colors);
-    for (auto const& [color, color_type] : palette_) {
-        auto [fg, bg] = std::visit(
-            [&](auto const& x) { return color_sequences(x); }, color_type);
-        fg_store[color] = fg;
-        bg_store[color] = bg;
+    auto& session = Session::current();
+    auto& tables  = session.colors_;
+    session.dynamic_color_engine_.clear();
+    session.write(palette_slots_reset(tables.palette_slots));
+    tables.palette_slots.clear();
+    tables.reserved_slots.reset();
+    tables.true_colors.clear();
+    session.palette_ = std::move(colors);
+
+    // Slots are reserved first, so that nothing is quantized onto one, and
+    // skip any index that the Palette uses as a Color_index.
+    if (session.dynamic_color_mode_ == Dynamic_color_mode::Palette &&
+        Terminal::color_count() > first_palette_slot) {
+        auto in_use = detail::Palette_mask{};
+        for (auto const& [color, color_type] : session.palette_) {
+            if (auto const* i = std::get_if<Color_index>(&color_type))
+                in_use.set(i->value);
+        }
+        auto next_slot = first_palette_slot;
+        for (auto const& [color, color_type] : session.palette_) {
+            if (!std::holds_alternative<Dynamic_color>(color_type))
+                continue;
+            while (next_slot > 15 && in_use.test(next_slot))
+                --next_slot;
+            if (next_slot <= 15)
+                break;
+            tables.palette_slots[color] = Color_index{
+                static_cast<decltype(Color_index::value)>(next_slot)};
+            tables.reserved_slots.set(next_slot--);
+        }
+    }
+
+    for (auto const& [color, color_type] : session.palette_) {
         if (std::holds_alternative<Dynamic_color>(color_type)) {
-            dynamic_color_engine_.start();  // no-op if already running
-            dynamic_color_engine_.register_color(
-                color, std::get<Dynamic_color>(color_type));
+            auto const& dynamic = std::get<Dynamic_color>(color_type);
+            if (auto const slot = tables.palette_slots.find(color);
+                slot != std::cend(tables.palette_slots)) {
+                session.write(
+                    palette_redefinition(slot->second, dynamic.get_value()));
+                auto [fg, bg]    = color_sequences(slot->second);
+                tables.fg[color] = fg;
+                tables.bg[color] = bg;
+            }
+            else
+                Terminal::update_color_stores(color, dynamic.get_value());
+            // no-op if already running
+            session.dynamic_color_engine_.start();
+            session.dynamic_color_engine_.register_color(color, dynamic);
+        }
+        else if (std::holds_alternative<True_color>(color_type)) {
+            Terminal::update_color_stores(color,
+                                          std::get<True_color>(color_type));
+        }
+        else {
+            auto const index = std::get<Color_index>(color_type);
+            auto [fg, bg]    = color_sequences(index);
+            tables.fg[color] = fg;
+            tables.bg[color] = bg;
         }
     }
     Terminal::flag_full_repaint();
-    palette_changed(palette_);
+    session.palette_changed_(session.palette_);
 }
 
 auto Terminal::palette_append(Color_definition::Value_t value) -> Color
@@ -262,18 +608,27 @@ auto Terminal::palette_append(Color_definition::Value_t value) -> Color
     return pal.back().color;
 }
 
-auto Terminal::current_palette() -> Palette const& { return palette_; }
+auto Terminal::current_palette() -> Palette const&
+{
+    return Session::current().palette_;
+}
 
 void Terminal::show_cursor(bool show)
 {
-    ::esc::set(show ? ::esc::Cursor::Show : ::esc::Cursor::Hide);
-    ::esc::flush();
+    auto& session     = Session::current();
+    auto const cursor = show ? ::esc::Cursor::Show : ::esc::Cursor::Hide;
+    if (session.is_stdio())
+        ::esc::set(cursor);
+    else
+        session.write(::esc::escape(cursor));
+    session.flush();
 }
 
 void Terminal::move_cursor(Point point)
 {
-    ::esc::write(::esc::escape(::esc::Cursor_position{point}));
-    ::esc::flush();
+    auto& session = Session::current();
+    session.write(::esc::escape(::esc::Cursor_position{point}));
+    session.flush();
 }
 
 auto Terminal::color_count() -> std::uint16_t
@@ -286,10 +641,10 @@ auto Terminal::has_true_color() -> bool { return ::esc::has_true_color(); }
 auto Terminal::read_input() -> Event
 {
     return std::visit([](auto const& event) { return transform(event); },
-                      ::esc::read());
+                      Session::current().read());
 }
 
-void Terminal::flag_full_repaint() { full_repaint_ = true; }
+void Terminal::flag_full_repaint() { Session::current().full_repaint_ = true; }
 
 void Terminal::flush_screen()
 {
@@ -303,7 +658,10 @@ void Terminal::flush_screen()
     }
 }
 
-void Terminal::stop_dynamic_color_engine() { dynamic_color_engine_.stop(); }
+void Terminal::stop_dynamic_color_engine()
+{
+    Session::current().dynamic_color_engine_.stop();
+}
 
 void Terminal::handle_signint(bool const x) { handle_sigint_ = x; }
 
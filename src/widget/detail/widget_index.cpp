@@ -0,0 +1,142 @@
+#include <termox/widget/detail/widget_index.hpp>
+
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include <termox/system/session.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+/// Return the demangled name of \p t, or the implementation name if unable.
+[[nodiscard]] auto demangle(std::type_index t) -> std::string
+{
+#if defined(__GNUG__)
+    auto status = 0;
+    auto const name =
+        std::unique_ptr<char, void (*)(void*)>{
+            abi::__cxa_demangle(t.name(), nullptr, nullptr, &status),
+            std::free};
+    if (status == 0 && name != nullptr)
+        return name.get();
+#endif
+    return t.name();
+}
+
+/// Strip namespaces, enclosing classes and template arguments from \p name.
+[[nodiscard]] auto unqualified(std::string name) -> std::string
+{
+    auto const template_begin = name.find('<');
+    if (template_begin != std::string::npos)
+        name.erase(template_begin);
+    auto const scope = name.rfind("::");
+    if (scope != std::string::npos)
+        name.erase(0, scope + 2);
+    return name;
+}
+
+}  // namespace
+
+namespace ox::detail {
+
+void Widget_index::add(Widget& w, std::string const& name)
+{
+    if (!name.empty())
+        state().by_name[name].insert(&w);
+}
+
+void Widget_index::rename(Widget& w,
+                          std::string const& old_name,
+                          std::string const& new_name)
+{
+    if (old_name == new_name)
+        return;
+    auto& by_name = state().by_name;
+    if (!old_name.empty()) {
+        auto const at = by_name.find(old_name);
+        if (at != std::end(by_name)) {
+            at->second.erase(&w);
+            if (at->second.empty())
+                by_name.erase(at);
+        }
+    }
+    if (!new_name.empty())
+        by_name[new_name].insert(&w);
+}
+
+void Widget_index::add_type(Widget& w)
+{
+    auto const type = std::type_index{typeid(w)};
+    auto& s         = state();
+    if (s.type_of.count(&w) != 0)
+        return;
+    s.type_of.emplace(&w, type);
+    s.by_type[type].insert(&w);
+}
+
+void Widget_index::remove(Widget& w, std::string const& name)
+{
+    auto& s = state();
+    if (!name.empty()) {
+        auto const at = s.by_name.find(name);
+        if (at != std::end(s.by_name)) {
+            at->second.erase(&w);
+            if (at->second.empty())
+                s.by_name.erase(at);
+        }
+    }
+    auto const type = s.type_of.find(&w);
+    if (type == std::end(s.type_of))
+        return;
+    auto const at = s.by_type.find(type->second);
+    if (at != std::end(s.by_type))
+        at->second.erase(&w);
+    s.type_of.erase(type);
+}
+
+auto Widget_index::with_name(std::string const& name) -> std::vector<Widget*>
+{
+    auto const& by_name = state().by_name;
+    auto const at       = by_name.find(name);
+    if (at == std::end(by_name))
+        return {};
+    return {std::begin(at->second), std::end(at->second)};
+}
+
+auto Widget_index::with_type(std::string_view name) -> std::vector<Widget*>
+{
+    auto result = std::vector<Widget*>{};
+    for (auto const& [type, widgets] : state().by_type) {
+        if (type_name(type) == name) {
+            result.insert(std::end(result), std::begin(widgets),
+                          std::end(widgets));
+        }
+    }
+    return result;
+}
+
+auto Widget_index::type_name(std::type_index t) -> std::string const&
+{
+    auto& names = state().type_names;
+    auto at     = names.find(t);
+    if (at == std::end(names))
+        at = names.emplace(t, unqualified(demangle(t))).first;
+    return at->second;
+}
+
+auto Widget_index::state() -> State&
+{
+    return Session::current().widget_index_;
+}
+
+}  // namespace ox::detail
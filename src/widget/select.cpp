@@ -0,0 +1,106 @@
+#include <termox/widget/select.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+#include <termox/widget/detail/widget_index.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+/// A single type and/or name selector, empty members match anything.
+struct Compound {
+    std::string type;
+    std::string name;
+};
+
+[[nodiscard]] auto is_space(char c) -> bool
+{
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/// Split \p selector into Compounds, throws std::invalid_argument if invalid.
+[[nodiscard]] auto parse(std::string_view selector) -> std::vector<Compound>
+{
+    auto result = std::vector<Compound>{};
+    auto begin  = std::begin(selector);
+    auto end    = std::end(selector);
+    while (true) {
+        begin = std::find_if_not(begin, end, is_space);
+        if (begin == end)
+            break;
+        auto const token_end = std::find_if(begin, end, is_space);
+        auto const hash      = std::find(begin, token_end, '#');
+        auto compound        = Compound{std::string(begin, hash), ""};
+        if (hash != token_end) {
+            compound.name = std::string(std::next(hash), token_end);
+            if (compound.name.empty() ||
+                compound.name.find('#') != std::string::npos) {
+                throw std::invalid_argument{"select: Invalid Widget name."};
+            }
+        }
+        result.push_back(std::move(compound));
+        begin = token_end;
+    }
+    if (result.empty())
+        throw std::invalid_argument{"select: Empty selector."};
+    return result;
+}
+
+[[nodiscard]] auto matches(ox::Widget const& w, Compound const& c) -> bool
+{
+    if (!c.name.empty() && w.name() != c.name)
+        return false;
+    if (!c.type.empty() &&
+        ox::detail::Widget_index::type_name(typeid(w)) != c.type) {
+        return false;
+    }
+    return true;
+}
+
+/// Return true if \p w is below \p root and its ancestors match \p compounds.
+/** The last Compound is assumed to already match \p w. Ancestors are matched
+ *  from the nearest, and may include \p root itself. */
+[[nodiscard]] auto is_selected(ox::Widget const& w,
+                               ox::Widget const& root,
+                               std::vector<Compound> const& compounds) -> bool
+{
+    auto remaining = compounds.size() - 1;
+    for (auto* p = w.parent(); p != nullptr; p = p->parent()) {
+        if (remaining != 0 && matches(*p, compounds[remaining - 1]))
+            --remaining;
+        if (p == &root)
+            return remaining == 0;
+    }
+    return false;
+}
+
+}  // namespace
+
+namespace ox {
+
+auto select(Widget const& root, std::string_view selector)
+    -> std::vector<Widget*>
+{
+    auto const compounds = parse(selector);
+    auto const& last     = compounds.back();
+    auto candidates      = last.name.empty()
+                               ? detail::Widget_index::with_type(last.type)
+                               : detail::Widget_index::with_name(last.name);
+    auto const not_selected = [&](Widget* w) {
+        return !matches(*w, last) || !is_selected(*w, root, compounds);
+    };
+    candidates.erase(std::remove_if(std::begin(candidates),
+                                    std::end(candidates), not_selected),
+                     std::end(candidates));
+    return candidates;
+}
+
+}  // namespace ox
@@ -11,9 +11,12 @@
 
 #include <termox/painter/brush.hpp>
 #include <termox/painter/glyph.hpp>
+#include <termox/painter/styles.hpp>
 #include <termox/system/event.hpp>
 #include <termox/system/system.hpp>
 #include <termox/terminal/terminal.hpp>
+#include <termox/widget/detail/widget_index.hpp>
+#include <termox/widget/rect.hpp>
 
 namespace {
 
@@ -59,6 +62,7 @@ Widget::Widget(std::string name,
         [this] { ::post_child_polished(*this); });
     height_policy.policy_updated.connect(
         [this] { ::post_child_polished(*this); });
+    detail::Widget_index::add(*this, name_);
 }
 
 Widget::Widget(Parameters p)
@@ -72,7 +76,13 @@ Widget::Widget(Parameters p)
              std::move(p.cursor)}
 {}
 
-void Widget::set_name(std::string name) { name_ = std::move(name); }
+Widget::~Widget() { detail::Widget_index::remove(*this, name_); }
+
+void Widget::set_name(std::string name)
+{
+    detail::Widget_index::rename(*this, name_, name);
+    name_ = std::move(name);
+}
 
 auto Widget::name() const -> std::string const& { return name_; }
 
@@ -107,10 +117,36 @@ auto Widget::top_left() const -> Point { return top_left_position_; }
 
 auto Widget::area() const -> Area { return area_; }
 
-void Widget::update() { System::post_event(Paint_event{*this}); }
+void Widget::update()
+{
+    full_damage_ = true;
+    System::post_event(Paint_event{*this});
+}
+
+void Widget::update(Rect damage)
+{
+    damage = intersection(damage, {{0, 0}, area_});
+    if (is_empty(damage))
+        return;
+    if (!full_damage_)
+        damage_ = bounding(damage_, damage);
+    System::post_event(Paint_event{*this});
+}
+
+auto Widget::damage() const -> Rect
+{
+    auto const all = Rect{{0, 0}, area_};
+    if (full_damage_ || is_empty(damage_))
+        return all;
+    return intersection(damage_, all);
+}
 
 auto Widget::is_layout_type() const -> bool { return false; }
 
+auto Widget::clips_children() const -> bool { return false; }
+
+auto Widget::covered_region() const -> Rect { return {}; }
+
 void Widget::install_event_filter(Widget& filter)
 {
     if (&filter == this)
@@ -136,7 +172,7 @@ auto Widget::get_event_filters() const -> std::set<Widget*> const&
     return event_filters_;
 }
 
-void Widget::enable_animation(std::chrono::milliseconds interval)
+void Widget::enable_animation(std::chrono::nanoseconds interval)
 {
     if (is_animated_)
         return;
@@ -162,6 +198,8 @@ void Widget::disable_animation()
 
 auto Widget::is_animated() const -> bool { return is_animated_; }
 
+auto Widget::frame_time() const -> Frame_time const& { return frame_time_; }
+
 auto Widget::get_descendants() const -> std::vector<Widget*>
 {
     auto descendants = std::vector<Widget*>{};
@@ -185,11 +223,26 @@ auto Widget::paints_wallpaper_with_brush() const -> bool
     return brush_paints_wallpaper_;
 }
 
+void Widget::set_style_class(std::string name)
+{
+    if (name == style_class_)
+        return;
+    style_class_ = std::move(name);
+    this->restyle();
+}
+
+auto Widget::style_class() const -> std::string const& { return style_class_; }
+
+auto Widget::effective_brush() const -> Brush
+{
+    return merge(brush, this->style());
+}
+
 auto Widget::generate_wallpaper() const -> Glyph
 {
     auto bg_glyph = wallpaper_;
     if (this->paints_wallpaper_with_brush())
-        bg_glyph.brush = merge(bg_glyph.brush, this->brush);
+        bg_glyph.brush = merge(bg_glyph.brush, this->effective_brush());
     return bg_glyph;
 }
 
@@ -310,7 +363,54 @@ void Widget::set_top_left(Point p) { top_left_position_ = p; }
 
 void Widget::set_area(Area a) { area_ = a; }
 
-void Widget::set_parent(Widget* parent) { parent_ = parent; }
+void Widget::set_frame_time(Frame_time t) { frame_time_ = t; }
+
+void Widget::clear_damage()
+{
+    damage_      = {};
+    full_damage_ = false;
+}
+
+void Widget::set_parent(Widget* parent)
+{
+    parent_ = parent;
+    if (parent != nullptr)
+        detail::Widget_index::add_type(*this);
+    this->invalidate_style();
+}
+
+void Widget::restyle()
+{
+    auto const was_resolved = is_style_resolved_;
+    auto const previous     = merge(brush, style_);
+    is_style_resolved_      = false;
+    if (was_resolved && !(this->effective_brush() == previous))
+        this->update();
+    for (auto& child : children_)
+        child->restyle();
+}
+
+auto Widget::style() const -> Brush
+{
+    if (!is_style_resolved_) {
+        auto const inherited =
+            parent_ == nullptr ? Brush{} : parent_->style();
+        style_ = style_class_.empty()
+                     ? inherited
+                     : merge(Styles::get(style_class_), inherited);
+        is_style_resolved_ = true;
+    }
+    return style_;
+}
+
+void Widget::invalidate_style()
+{
+    if (!is_style_resolved_)
+        return;
+    is_style_resolved_ = false;
+    for (auto& child : children_)
+        child->invalidate_style();
+}
 
 auto widget(std::string name,
             Focus_policy focus_policy,
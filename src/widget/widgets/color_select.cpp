@@ -20,7 +20,7 @@ Color_tile::Color_tile(Parameters p) : Color_tile{p.color, p.display} {}
 Color_select::Color_select(Color_tile::Display display) : display_{display}
 {
     this->set_palette(Terminal::current_palette());
-    Terminal::palette_changed.connect(
+    Terminal::palette_changed().connect(
         [this](auto const& pal) { this->set_palette(pal); });
 }
 
@@ -0,0 +1,261 @@
+#include <termox/widget/widgets/detail/vt_parser.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include <termox/widget/widgets/detail/vt_screen.hpp>
+
+namespace {
+
+using ox::detail::Vt_parser;
+using State = Vt_parser::State;
+
+enum class Action : std::uint8_t {
+    None,
+    Print,
+    Utf8,
+    Execute,
+    Clear,
+    Collect,
+    Marker,
+    Param,
+    Esc_dispatch,
+    Csi_dispatch,
+};
+
+auto constexpr state_count = 9;
+
+/// Action in the high nibble and next State in the low nibble.
+using Transition = std::uint8_t;
+
+using Table = std::array<std::array<Transition, 256>, state_count>;
+
+[[nodiscard]] constexpr auto transition(Action a, State s) -> Transition
+{
+    return static_cast<Transition>((static_cast<int>(a) << 4) |
+                                   static_cast<int>(s));
+}
+
+[[nodiscard]] constexpr auto action_of(Transition t) -> Action
+{
+    return static_cast<Action>(t >> 4);
+}
+
+[[nodiscard]] constexpr auto state_of(Transition t) -> State
+{
+    return static_cast<State>(t & 0x0F);
+}
+
+/// Set the Transition for bytes [first, last] in \p row.
+constexpr void set(std::array<Transition, 256>& row,
+                   int first,
+                   int last,
+                   Action a,
+                   State s)
+{
+    for (auto i = first; i <= last; ++i)
+        row[i] = transition(a, s);
+}
+
+/// C0 controls are executed in place, except for those handled by anywhere.
+constexpr void set_execute(std::array<Transition, 256>& row, State s)
+{
+    set(row, 0x00, 0x17, Action::Execute, s);
+    set(row, 0x19, 0x19, Action::Execute, s);
+    set(row, 0x1C, 0x1F, Action::Execute, s);
+}
+
+/// Build the transition table, indexed by [state][byte].
+/** Bytes 0x80 and above are UTF-8, so there are no C1 controls. */
+[[nodiscard]] constexpr auto build_table() -> Table
+{
+    auto table = Table{};
+    for (auto s = 0; s < state_count; ++s) {
+        auto const state = static_cast<State>(s);
+        auto& row        = table[s];
+        set(row, 0x00, 0xFF, Action::None, state);
+        if (state != State::Osc_string && state != State::String_ignore)
+            set_execute(row, state);
+    }
+
+    {
+        auto& row = table[static_cast<int>(State::Ground)];
+        set(row, 0x20, 0x7E, Action::Print, State::Ground);
+        set(row, 0x80, 0xFF, Action::Utf8, State::Ground);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Escape)];
+        set(row, 0x20, 0x2F, Action::Collect, State::Escape_intermediate);
+        set(row, 0x30, 0x7E, Action::Esc_dispatch, State::Ground);
+        set(row, '[', '[', Action::Clear, State::Csi_entry);
+        set(row, ']', ']', Action::None, State::Osc_string);
+        set(row, 'P', 'P', Action::None, State::String_ignore);
+        set(row, 'X', 'X', Action::None, State::String_ignore);
+        set(row, '^', '_', Action::None, State::String_ignore);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Escape_intermediate)];
+        set(row, 0x20, 0x2F, Action::Collect, State::Escape_intermediate);
+        set(row, 0x30, 0x7E, Action::Esc_dispatch, State::Ground);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Csi_entry)];
+        set(row, 0x20, 0x2F, Action::Collect, State::Csi_intermediate);
+        set(row, 0x30, 0x39, Action::Param, State::Csi_param);
+        set(row, ':', ':', Action::None, State::Csi_ignore);
+        set(row, ';', ';', Action::Param, State::Csi_param);
+        set(row, 0x3C, 0x3F, Action::Marker, State::Csi_param);
+        set(row, 0x40, 0x7E, Action::Csi_dispatch, State::Ground);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Csi_param)];
+        set(row, 0x20, 0x2F, Action::Collect, State::Csi_intermediate);
+        set(row, 0x30, 0x39, Action::Param, State::Csi_param);
+        set(row, ':', ':', Action::None, State::Csi_ignore);
+        set(row, ';', ';', Action::Param, State::Csi_param);
+        set(row, 0x3C, 0x3F, Action::None, State::Csi_ignore);
+        set(row, 0x40, 0x7E, Action::Csi_dispatch, State::Ground);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Csi_intermediate)];
+        set(row, 0x20, 0x2F, Action::Collect, State::Csi_intermediate);
+        set(row, 0x30, 0x3F, Action::None, State::Csi_ignore);
+        set(row, 0x40, 0x7E, Action::Csi_dispatch, State::Ground);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Csi_ignore)];
+        set(row, 0x40, 0x7E, Action::None, State::Ground);
+    }
+    {
+        auto& row = table[static_cast<int>(State::Osc_string)];
+        set(row, 0x07, 0x07, Action::None, State::Ground);  // BEL terminator
+    }
+
+    // Anywhere transitions, these override every state.
+    for (auto& row : table) {
+        set(row, 0x18, 0x18, Action::Execute, State::Ground);
+        set(row, 0x1A, 0x1A, Action::Execute, State::Ground);
+        set(row, 0x1B, 0x1B, Action::Clear, State::Escape);
+    }
+    return table;
+}
+
+auto constexpr table = build_table();
+
+/// Return true if \p c can be printed directly in the Ground state.
+[[nodiscard]] auto is_printable_ascii(char c) -> bool
+{
+    return c >= 0x20 && c < 0x7F;
+}
+
+}  // namespace
+
+namespace ox::detail {
+
+void Vt_parser::parse(std::string_view bytes, Vt_screen& screen)
+{
+    auto const* iter      = bytes.data();
+    auto const* const end = iter + bytes.size();
+    while (iter != end) {
+        if (state_ == State::Ground && utf8_remaining_ == 0) {
+            auto const* run = iter;
+            while (run != end && ::is_printable_ascii(*run))
+                ++run;
+            if (run != iter) {
+                screen.print(std::string_view{iter, std::size_t(run - iter)});
+                iter = run;
+                continue;
+            }
+        }
+        auto const byte = static_cast<std::uint8_t>(*iter++);
+        if (utf8_remaining_ != 0 && byte < 0x80) {
+            screen.print(U'\uFFFD');
+            utf8_remaining_ = 0;
+        }
+        auto const t = table[static_cast<int>(state_)][byte];
+        switch (action_of(t)) {
+            case Action::None: break;
+            case Action::Print:
+                screen.print(static_cast<char32_t>(byte));
+                break;
+            case Action::Utf8: this->decode_utf8(byte, screen); break;
+            case Action::Execute:
+                screen.execute(static_cast<char>(byte));
+                break;
+            case Action::Clear:
+                sequence_.params.fill(0);
+                sequence_.param_count    = 0;
+                sequence_.private_marker = '\0';
+                sequence_.intermediate   = '\0';
+                break;
+            case Action::Collect:
+                sequence_.intermediate = static_cast<char>(byte);
+                break;
+            case Action::Marker:
+                sequence_.private_marker = static_cast<char>(byte);
+                break;
+            case Action::Param:
+                if (sequence_.param_count == 0)
+                    sequence_.param_count = 1;
+                if (byte == ';')
+                    ++sequence_.param_count;
+                else if (sequence_.param_count <= Vt_sequence::max_params) {
+                    auto& p = sequence_.params[sequence_.param_count - 1];
+                    p       = std::min(p * 10 + (byte - '0'), 9'999);
+                }
+                break;
+            case Action::Esc_dispatch:
+                screen.esc_dispatch(static_cast<char>(byte),
+                                    sequence_.intermediate);
+                break;
+            case Action::Csi_dispatch:
+                screen.csi_dispatch(static_cast<char>(byte), sequence_);
+                break;
+        }
+        state_ = state_of(t);
+    }
+}
+
+void Vt_parser::reset()
+{
+    state_          = State::Ground;
+    utf8_remaining_ = 0;
+}
+
+auto Vt_parser::state() const -> State { return state_; }
+
+void Vt_parser::decode_utf8(std::uint8_t byte, Vt_screen& screen)
+{
+    if (byte < 0xC0) {  // Continuation byte.
+        if (utf8_remaining_ == 0) {
+            screen.print(U'\uFFFD');
+            return;
+        }
+        codepoint_ = (codepoint_ << 6) | (byte & 0x3F);
+        if (--utf8_remaining_ == 0)
+            screen.print(codepoint_);
+        return;
+    }
+    if (utf8_remaining_ != 0)
+        screen.print(U'\uFFFD');
+    if (byte < 0xE0) {
+        codepoint_      = byte & 0x1F;
+        utf8_remaining_ = 1;
+    }
+    else if (byte < 0xF0) {
+        codepoint_      = byte & 0x0F;
+        utf8_remaining_ = 2;
+    }
+    else if (byte < 0xF8) {
+        codepoint_      = byte & 0x07;
+        utf8_remaining_ = 3;
+    }
+    else {
+        screen.print(U'\uFFFD');
+        utf8_remaining_ = 0;
+    }
+}
+
+}  // namespace ox::detail
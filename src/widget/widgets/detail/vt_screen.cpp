@@ -0,0 +1,668 @@
+#include <termox/widget/widgets/detail/vt_screen.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <termox/painter/brush.hpp>
+#include <termox/painter/color.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/painter/trait.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/terminal/detail/color_quantizer.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/widgets/detail/vt_parser.hpp>
+
+namespace {
+
+/// Return \p a with each dimension at least one, so the cursor has a cell.
+[[nodiscard]] auto at_least_one(ox::Area a) -> ox::Area
+{
+    return {std::max(a.width, 1), std::max(a.height, 1)};
+}
+
+/// Return the DEC Special Graphics symbol for \p c, or \p c if not mapped.
+[[nodiscard]] auto dec_graphic(char32_t c) -> char32_t
+{
+    auto constexpr symbols =
+        std::u32string_view{U"◆▒␉␌␍␊°±␤␋┘┐┌└┼⎺⎻─⎼⎽├┤┴┬│≤≥π≠£·"};
+    if (c == U'_')
+        return U' ';
+    if (c < U'`' || c > U'~')
+        return c;
+    return symbols[c - U'`'];
+}
+
+/// Read the extended color following an SGR 38 or 48 at index \p i.
+/** Advances \p i past the parameters used. Returns an xterm palette index,
+ *  RGB values are quantized to the xterm 256 color palette. */
+[[nodiscard]] auto extended_color(ox::detail::Vt_sequence const& seq, int& i)
+    -> std::optional<int>
+{
+    auto const kind = seq.get(i + 1, 0);
+    if (kind == 5 && i + 2 < seq.size()) {
+        i += 2;
+        return std::clamp(seq.params[i], 0, 255);
+    }
+    if (kind == 2 && i + 4 < seq.size()) {
+        auto const channel = [&](int n) -> std::uint32_t {
+            return std::clamp(seq.params[i + n], 0, 255);
+        };
+        auto const rgb = (channel(2) << 16) | (channel(3) << 8) | channel(4);
+        i += 4;
+        return ox::detail::quantize(ox::RGB{rgb}, 256).value;
+    }
+    i = seq.size();  // Malformed, the remaining parameters can't be trusted.
+    return std::nullopt;
+}
+
+/// Return the identity table, each xterm index is used as a Color value.
+[[nodiscard]] auto default_colors() -> std::vector<ox::Color>
+{
+    auto result = std::vector<ox::Color>{};
+    result.reserve(256);
+    for (auto i = 0; i < 256; ++i)
+        result.push_back(ox::Color{static_cast<ox::Color::Value_t>(i)});
+    return result;
+}
+
+}  // namespace
+
+namespace ox::detail {
+
+Vt_screen::Vt_screen(Area a)
+    : primary_{Canvas{at_least_one(a)}},
+      alternate_{Canvas{at_least_one(a)}},
+      scroll_top_{0},
+      scroll_bottom_{at_least_one(a).height - 1},
+      colors_{default_colors()},
+      damaged_rows_(at_least_one(a).height, 1)
+{
+    std::fill(std::begin(primary_.cells), std::end(primary_.cells),
+              this->blank());
+    std::fill(std::begin(alternate_.cells), std::end(alternate_.cells),
+              this->blank());
+}
+
+void Vt_screen::print(char32_t c)
+{
+    if (dec_graphics_)
+        c = dec_graphic(c);
+    this->wrap_if_pending();
+    this->row(cursor_.y)[cursor_.x] = Glyph{c, brush_};
+    last_printed_                   = c;
+    this->damage(cursor_.y);
+    if (cursor_.x + 1 < this->area().width)
+        ++cursor_.x;
+    else
+        pending_wrap_ = autowrap_;
+}
+
+void Vt_screen::print(std::string_view ascii)
+{
+    if (ascii.empty())
+        return;
+    if (dec_graphics_) {
+        for (char c : ascii)
+            this->print(static_cast<char32_t>(c));
+        return;
+    }
+    last_printed_    = static_cast<char32_t>(ascii.back());
+    auto const width = this->area().width;
+    while (!ascii.empty()) {
+        this->wrap_if_pending();
+        auto* const cells = this->row(cursor_.y);
+        auto const count  = static_cast<int>(std::min(
+            static_cast<std::size_t>(width - cursor_.x), ascii.size()));
+        for (auto i = 0; i < count; ++i)
+            cells[cursor_.x + i] = Glyph{ascii[i], brush_};
+        this->damage(cursor_.y);
+        ascii.remove_prefix(count);
+        cursor_.x += count;
+        if (cursor_.x == width) {
+            cursor_.x = width - 1;
+            if (autowrap_)
+                pending_wrap_ = true;
+            else if (!ascii.empty()) {
+                cells[cursor_.x] = Glyph{ascii.back(), brush_};
+                ascii            = {};
+            }
+        }
+    }
+}
+
+void Vt_screen::execute(char c)
+{
+    switch (c) {
+        case '\b': this->move_to({cursor_.x - 1, cursor_.y}); break;
+        case '\t':
+            this->move_to({(cursor_.x / 8 + 1) * 8, cursor_.y});
+            break;
+        case '\n':
+        case '\v':
+        case '\f':
+            pending_wrap_ = false;
+            this->index();
+            break;
+        case '\r': this->move_to({0, cursor_.y}); break;
+        default: break;  // BEL, shift in/out and the rest are ignored.
+    }
+}
+
+void Vt_screen::esc_dispatch(char final, char intermediate)
+{
+    if (intermediate == '(') {  // Designate G0 character set.
+        dec_graphics_ = (final == '0');
+        return;
+    }
+    if (intermediate != '\0')
+        return;
+    switch (final) {
+        case '7': this->save_cursor(); break;
+        case '8': this->restore_cursor(); break;
+        case 'D':
+            pending_wrap_ = false;
+            this->index();
+            break;
+        case 'E':
+            this->move_to({0, cursor_.y});
+            this->index();
+            break;
+        case 'M':
+            pending_wrap_ = false;
+            this->reverse_index();
+            break;
+        case 'c': this->reset(); break;
+        default: break;
+    }
+}
+
+void Vt_screen::csi_dispatch(char final, Vt_sequence const& seq)
+{
+    if (seq.private_marker == '?') {
+        if (final == 'h' || final == 'l') {
+            for (auto i = 0; i < seq.size(); ++i)
+                this->set_private_mode(seq.params[i], final == 'h');
+        }
+        return;
+    }
+    if (seq.private_marker != '\0' || seq.intermediate != '\0')
+        return;
+    auto const n = seq.get(0, 1);
+    auto const a = this->area();
+    auto const x = cursor_.x;
+    auto const y = cursor_.y;
+    switch (final) {
+        case '@': this->insert_cells(n); break;
+        case 'A': this->move_to({x, y - n}); break;
+        case 'B':
+        case 'e': this->move_to({x, y + n}); break;
+        case 'C':
+        case 'a': this->move_to({x + n, y}); break;
+        case 'D': this->move_to({x - n, y}); break;
+        case 'E': this->move_to({0, y + n}); break;
+        case 'F': this->move_to({0, y - n}); break;
+        case 'G':
+        case '`': this->move_to({n - 1, y}); break;
+        case 'H':
+        case 'f': this->move_to({seq.get(1, 1) - 1, n - 1}); break;
+        case 'd': this->move_to({x, n - 1}); break;
+        case 'J': this->erase_in_display(seq.get(0, 0)); break;
+        case 'K': this->erase_in_line(seq.get(0, 0)); break;
+        case 'L':
+            if (y >= scroll_top_ && y <= scroll_bottom_) {
+                this->scroll_down(y, scroll_bottom_, n);
+                this->move_to({0, y});
+            }
+            break;
+        case 'M':
+            if (y >= scroll_top_ && y <= scroll_bottom_) {
+                this->scroll_up(y, scroll_bottom_, n);
+                this->move_to({0, y});
+            }
+            break;
+        case 'P': this->delete_cells(n); break;
+        case 'X':
+            pending_wrap_ = false;
+            this->erase(y, x, std::min(x + n, a.width));
+            break;
+        case 'S': this->scroll_up(scroll_top_, scroll_bottom_, n); break;
+        case 'T': this->scroll_down(scroll_top_, scroll_bottom_, n); break;
+        case 'b':
+            for (auto i = std::min(n, a.width * a.height); i != 0; --i)
+                this->print(last_printed_);
+            break;
+        case 'm': this->set_graphic_rendition(seq); break;
+        case 'r': {
+            auto const top    = seq.get(0, 1) - 1;
+            auto const bottom = std::min(seq.get(1, a.height), a.height) - 1;
+            if (top < bottom) {
+                scroll_top_    = top;
+                scroll_bottom_ = bottom;
+            }
+            this->move_to({0, 0});
+        } break;
+        case 's': this->save_cursor(); break;
+        case 'u': this->restore_cursor(); break;
+        case 'n':
+            if (seq.get(0, 0) == 5)
+                responses_.append("\033[0n");
+            else if (seq.get(0, 0) == 6) {
+                responses_.append("\033[")
+                    .append(std::to_string(y + 1))
+                    .append(";")
+                    .append(std::to_string(x + 1))
+                    .append("R");
+            }
+            break;
+        case 'c':
+            if (seq.get(0, 0) == 0)
+                responses_.append("\033[?1;2c");
+            break;
+        default: break;
+    }
+}
+
+void Vt_screen::set_colors(std::vector<Color> colors)
+{
+    if (colors.size() < 256)
+        throw std::invalid_argument{"Vt_screen::set_colors: Needs 256 Colors."};
+    colors_ = std::move(colors);
+}
+
+void Vt_screen::resize(Area a)
+{
+    a = at_least_one(a);
+    if (a == this->area())
+        return;
+    // Keep the cursor's row on screen by scrolling the rows above it off.
+    if (auto const excess = cursor_.y - (a.height - 1); excess > 0) {
+        this->scroll_up(0, this->area().height - 1, excess);
+        cursor_.y -= excess;
+    }
+    resize_page(primary_, a);
+    resize_page(alternate_, a);
+    scroll_top_    = 0;
+    scroll_bottom_ = a.height - 1;
+
+    saved_.position.x = std::min(saved_.position.x, a.width - 1);
+    saved_.position.y = std::min(saved_.position.y, a.height - 1);
+    this->move_to(cursor_);
+    damaged_rows_.resize(a.height);
+    this->damage_all();
+}
+
+auto Vt_screen::area() const -> Area { return this->page().cells.area(); }
+
+auto Vt_screen::at(Point p) const -> Glyph { return this->row(p.y)[p.x]; }
+
+auto Vt_screen::cursor() const -> Point { return cursor_; }
+
+auto Vt_screen::is_cursor_visible() const -> bool { return cursor_visible_; }
+
+auto Vt_screen::is_application_cursor_keys() const -> bool
+{
+    return app_cursor_keys_;
+}
+
+auto Vt_screen::is_damaged() const -> bool { return damaged_; }
+
+auto Vt_screen::is_damaged(int y) const -> bool
+{
+    return damaged_rows_[y] != 0;
+}
+
+void Vt_screen::clear_damage()
+{
+    std::fill(std::begin(damaged_rows_), std::end(damaged_rows_), 0);
+    damaged_ = false;
+}
+
+auto Vt_screen::responses() const -> std::string_view { return responses_; }
+
+void Vt_screen::clear_responses() { responses_.clear(); }
+
+void Vt_screen::reset()
+{
+    this->use_alternate_page(false);
+    brush_           = Brush{};
+    saved_           = Saved_cursor{};
+    scroll_top_      = 0;
+    scroll_bottom_   = this->area().height - 1;
+    last_printed_    = U' ';
+    autowrap_        = true;
+    cursor_visible_  = true;
+    app_cursor_keys_ = false;
+    dec_graphics_    = false;
+    this->erase_in_display(2);
+    this->move_to({0, 0});
+}
+
+auto Vt_screen::page() -> Page&
+{
+    return on_alternate_ ? alternate_ : primary_;
+}
+
+auto Vt_screen::page() const -> Page const&
+{
+    return on_alternate_ ? alternate_ : primary_;
+}
+
+auto Vt_screen::row(int y) -> Glyph*
+{
+    auto& p = this->page();
+    return &*std::next(std::begin(p.cells),
+                       physical_row(p, y) * p.cells.area().width);
+}
+
+auto Vt_screen::row(int y) const -> Glyph const*
+{
+    auto const& p = this->page();
+    return &*std::next(std::cbegin(p.cells),
+                       physical_row(p, y) * p.cells.area().width);
+}
+
+auto Vt_screen::blank() const -> Glyph
+{
+    auto g             = Glyph{U' '};
+    g.brush.background = brush_.background;
+    return g;
+}
+
+void Vt_screen::damage(int y)
+{
+    damaged_rows_[y] = 1;
+    damaged_         = true;
+}
+
+void Vt_screen::damage_all()
+{
+    std::fill(std::begin(damaged_rows_), std::end(damaged_rows_), 1);
+    damaged_ = true;
+}
+
+void Vt_screen::wrap_if_pending()
+{
+    if (!pending_wrap_)
+        return;
+    pending_wrap_ = false;
+    cursor_.x     = 0;
+    this->index();
+}
+
+void Vt_screen::move_to(Point p)
+{
+    auto const a  = this->area();
+    cursor_.x     = std::clamp(p.x, 0, a.width - 1);
+    cursor_.y     = std::clamp(p.y, 0, a.height - 1);
+    pending_wrap_ = false;
+}
+
+void Vt_screen::index()
+{
+    if (cursor_.y == scroll_bottom_)
+        this->scroll_up(scroll_top_, scroll_bottom_, 1);
+    else if (cursor_.y + 1 < this->area().height)
+        ++cursor_.y;
+}
+
+void Vt_screen::reverse_index()
+{
+    if (cursor_.y == scroll_top_)
+        this->scroll_down(scroll_top_, scroll_bottom_, 1);
+    else if (cursor_.y > 0)
+        --cursor_.y;
+}
+
+void Vt_screen::scroll_up(int top, int bottom, int n)
+{
+    n = std::min(n, bottom - top + 1);
+    if (n <= 0)
+        return;
+    auto const a = this->area();
+    if (top == 0 && bottom == a.height - 1) {
+        auto& p   = this->page();
+        p.top_row = (p.top_row + n) % a.height;
+        for (auto y = a.height - n; y < a.height; ++y)
+            this->erase(y, 0, a.width);
+        this->damage_all();
+        return;
+    }
+    for (auto y = top; y + n <= bottom; ++y)
+        std::copy_n(this->row(y + n), a.width, this->row(y));
+    for (auto y = bottom - n + 1; y <= bottom; ++y)
+        this->erase(y, 0, a.width);
+    for (auto y = top; y <= bottom; ++y)
+        this->damage(y);
+}
+
+void Vt_screen::scroll_down(int top, int bottom, int n)
+{
+    n = std::min(n, bottom - top + 1);
+    if (n <= 0)
+        return;
+    auto const a = this->area();
+    if (top == 0 && bottom == a.height - 1) {
+        auto& p   = this->page();
+        p.top_row = (p.top_row + a.height - n) % a.height;
+        for (auto y = 0; y < n; ++y)
+            this->erase(y, 0, a.width);
+        this->damage_all();
+        return;
+    }
+    for (auto y = bottom; y - n >= top; --y)
+        std::copy_n(this->row(y - n), a.width, this->row(y));
+    for (auto y = top; y < top + n; ++y)
+        this->erase(y, 0, a.width);
+    for (auto y = top; y <= bottom; ++y)
+        this->damage(y);
+}
+
+void Vt_screen::erase(int y, int first, int last)
+{
+    if (first >= last)
+        return;
+    auto* const cells = this->row(y);
+    std::fill(cells + first, cells + last, this->blank());
+    this->damage(y);
+}
+
+void Vt_screen::insert_cells(int n)
+{
+    auto const width  = this->area().width;
+    auto const x      = cursor_.x;
+    auto* const cells = this->row(cursor_.y);
+    n                 = std::min(n, width - x);
+    std::copy_backward(cells + x, cells + width - n, cells + width);
+    std::fill(cells + x, cells + x + n, this->blank());
+    pending_wrap_ = false;
+    this->damage(cursor_.y);
+}
+
+void Vt_screen::delete_cells(int n)
+{
+    auto const width  = this->area().width;
+    auto const x      = cursor_.x;
+    auto* const cells = this->row(cursor_.y);
+    n                 = std::min(n, width - x);
+    std::copy(cells + x + n, cells + width, cells + x);
+    std::fill(cells + width - n, cells + width, this->blank());
+    pending_wrap_ = false;
+    this->damage(cursor_.y);
+}
+
+void Vt_screen::erase_in_display(int mode)
+{
+    auto const a = this->area();
+    switch (mode) {
+        case 0:
+            this->erase_in_line(0);
+            for (auto y = cursor_.y + 1; y < a.height; ++y)
+                this->erase(y, 0, a.width);
+            break;
+        case 1:
+            for (auto y = 0; y < cursor_.y; ++y)
+                this->erase(y, 0, a.width);
+            this->erase_in_line(1);
+            break;
+        case 2:
+        case 3:
+            for (auto y = 0; y < a.height; ++y)
+                this->erase(y, 0, a.width);
+            break;
+        default: break;
+    }
+}
+
+void Vt_screen::erase_in_line(int mode)
+{
+    auto const width = this->area().width;
+    switch (mode) {
+        case 0: this->erase(cursor_.y, cursor_.x, width); break;
+        case 1: this->erase(cursor_.y, 0, cursor_.x + 1); break;
+        case 2: this->erase(cursor_.y, 0, width); break;
+        default: break;
+    }
+}
+
+void Vt_screen::set_private_mode(int mode, bool enable)
+{
+    switch (mode) {
+        case 1: app_cursor_keys_ = enable; break;
+        case 7:
+            autowrap_     = enable;
+            pending_wrap_ = false;
+            break;
+        case 25: cursor_visible_ = enable; break;
+        case 47:
+        case 1047: this->use_alternate_page(enable); break;
+        case 1048: enable ? this->save_cursor() : this->restore_cursor(); break;
+        case 1049:
+            if (enable) {
+                this->save_cursor();
+                this->use_alternate_page(true);
+            }
+            else {
+                this->use_alternate_page(false);
+                this->restore_cursor();
+            }
+            break;
+        default: break;
+    }
+}
+
+void Vt_screen::set_graphic_rendition(Vt_sequence const& seq)
+{
+    if (seq.size() == 0) {
+        brush_ = Brush{};
+        return;
+    }
+    for (auto i = 0; i < seq.size(); ++i) {
+        auto const p = seq.params[i];
+        switch (p) {
+            case 0: brush_ = Brush{}; break;
+            case 1: brush_.traits.insert(Trait::Bold); break;
+            case 2: brush_.traits.insert(Trait::Dim); break;
+            case 3: brush_.traits.insert(Trait::Italic); break;
+            case 4: brush_.traits.insert(Trait::Underline); break;
+            case 5:
+            case 6: brush_.traits.insert(Trait::Blink); break;
+            case 7: brush_.traits.insert(Trait::Inverse); break;
+            case 8: brush_.traits.insert(Trait::Invisible); break;
+            case 9: brush_.traits.insert(Trait::Crossed_out); break;
+            case 21: brush_.traits.insert(Trait::Double_underline); break;
+            case 22:
+                brush_.traits.remove(Trait::Bold);
+                brush_.traits.remove(Trait::Dim);
+                break;
+            case 23: brush_.traits.remove(Trait::Italic); break;
+            case 24:
+                brush_.traits.remove(Trait::Underline);
+                brush_.traits.remove(Trait::Double_underline);
+                break;
+            case 25: brush_.traits.remove(Trait::Blink); break;
+            case 27: brush_.traits.remove(Trait::Inverse); break;
+            case 28: brush_.traits.remove(Trait::Invisible); break;
+            case 29: brush_.traits.remove(Trait::Crossed_out); break;
+            case 38:
+                if (auto const c = extended_color(seq, i); c.has_value())
+                    brush_.foreground = colors_[*c];
+                break;
+            case 39: brush_.foreground = Color::Foreground; break;
+            case 48:
+                if (auto const c = extended_color(seq, i); c.has_value())
+                    brush_.background = colors_[*c];
+                break;
+            case 49: brush_.background = Color::Background; break;
+            default:
+                if (p >= 30 && p <= 37)
+                    brush_.foreground = colors_[p - 30];
+                else if (p >= 40 && p <= 47)
+                    brush_.background = colors_[p - 40];
+                else if (p >= 90 && p <= 97)
+                    brush_.foreground = colors_[p - 90 + 8];
+                else if (p >= 100 && p <= 107)
+                    brush_.background = colors_[p - 100 + 8];
+                break;
+        }
+    }
+}
+
+void Vt_screen::save_cursor()
+{
+    saved_ = {cursor_, brush_, dec_graphics_, pending_wrap_};
+}
+
+void Vt_screen::restore_cursor()
+{
+    this->move_to(saved_.position);
+    brush_        = saved_.brush;
+    dec_graphics_ = saved_.dec_graphics;
+    pending_wrap_ = saved_.pending_wrap;
+}
+
+void Vt_screen::use_alternate_page(bool enable)
+{
+    if (enable == on_alternate_)
+        return;
+    on_alternate_ = enable;
+    if (enable)
+        this->erase_in_display(2);
+    this->damage_all();
+}
+
+auto Vt_screen::physical_row(Page const& page, int y) -> int
+{
+    auto const row    = y + page.top_row;
+    auto const height = page.cells.area().height;
+    return row < height ? row : row - height;
+}
+
+void Vt_screen::linearize(Page& page)
+{
+    auto const width = page.cells.area().width;
+    auto const begin = std::begin(page.cells);
+    std::rotate(begin, std::next(begin, page.top_row * width),
+                std::end(page.cells));
+    page.top_row = 0;
+}
+
+void Vt_screen::resize_page(Page& page, Area a)
+{
+    linearize(page);
+    page.cells.resize(a);
+    // Canvas::resize leaves new cells as null Glyphs.
+    for (auto& g : page.cells) {
+        if (g.symbol == U'\0')
+            g = Glyph{U' '};
+    }
+}
+
+}  // namespace ox::detail
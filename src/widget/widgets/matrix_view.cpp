@@ -3,8 +3,11 @@
 #include <memory>
 #include <utility>
 
+#include <termox/painter/glyph.hpp>
 #include <termox/painter/glyph_matrix.hpp>
 #include <termox/painter/painter.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
 #include <termox/widget/widget.hpp>
 
 namespace ox {
@@ -13,15 +16,20 @@ Matrix_view::Matrix_view(Glyph_matrix matrix_) : matrix{std::move(matrix_)} {}
 
 Matrix_view::Matrix_view(Parameters p) : Matrix_view{std::move(p.matrix)} {}
 
-auto Matrix_view::paint_event(Painter& p) -> bool
+void Matrix_view::set_cell(Point p, Glyph g)
 {
-    auto const w = (matrix.width() > this->area().width) ? this->area().width
-                                                         : matrix.width();
-    auto const h = (matrix.height() > this->area().height) ? this->area().height
-                                                           : matrix.height();
+    matrix.at(p) = g;
+    this->update({p, {1, 1}});
+}
 
-    for (auto y = 0; y < h; ++y) {
-        for (auto x = 0; x < w; ++x)
+auto Matrix_view::paint_event(Painter& p) -> bool
+{
+    auto const region =
+        intersection(p.clip(), {{0, 0}, {matrix.width(), matrix.height()}});
+    auto const x_end = region.top_left.x + region.area.width;
+    auto const y_end = region.top_left.y + region.area.height;
+    for (auto y = region.top_left.y; y < y_end; ++y) {
+        for (auto x = region.top_left.x; x < x_end; ++x)
             p.put(matrix({x, y}), {x, y});
     }
     return Widget::paint_event(p);
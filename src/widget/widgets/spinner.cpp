@@ -73,9 +73,9 @@ auto Spinner::paint_event(Painter& p) -> bool
 
 auto Spinner::timer_event() -> bool
 {
-    ++index_;
-    if (index_ >= frames_.size())
-        index_ = 0;
+    // Skip the frames that were missed, to stay in time with the clock.
+    if (frames_.size() != 0)
+        index_ = (index_ + this->frame_time().steps) % frames_.size();
     this->update();
     return Widget::timer_event();
 }
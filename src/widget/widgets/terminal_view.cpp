@@ -0,0 +1,378 @@
+#include <termox/widget/widgets/terminal_view.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <termox/common/u32_to_mb.hpp>
+#include <termox/painter/color.hpp>
+#include <termox/painter/painter.hpp>
+#include <termox/system/key.hpp>
+#include <termox/terminal/detail/color_quantizer.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/detail/link_lifetimes.hpp>
+#include <termox/widget/focus_policy.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
+
+extern char** environ;
+
+namespace {
+
+/// Tell the pty, and through SIGWINCH the child, the size of its screen.
+void set_window_size(int fd, ox::Area a)
+{
+    auto ws   = ::winsize{};
+    ws.ws_col = static_cast<unsigned short>(a.width);
+    ws.ws_row = static_cast<unsigned short>(a.height);
+    ::ioctl(fd, TIOCSWINSZ, &ws);
+}
+
+/// Return the current environment with TERM set to what Vt_screen emulates.
+[[nodiscard]] auto child_environment() -> std::vector<std::string>
+{
+    auto result = std::vector<std::string>{"TERM=xterm-256color"};
+    for (auto** var = environ; *var != nullptr; ++var) {
+        if (std::strncmp(*var, "TERM=", 5) != 0)
+            result.emplace_back(*var);
+    }
+    return result;
+}
+
+/// Return a null terminated array of pointers into \p strings.
+[[nodiscard]] auto to_argv(std::vector<std::string>& strings)
+    -> std::vector<char*>
+{
+    auto result = std::vector<char*>{};
+    result.reserve(strings.size() + 1);
+    for (auto& s : strings)
+        result.push_back(s.data());
+    result.push_back(nullptr);
+    return result;
+}
+
+/// Owns a file descriptor, closing it on destruction unless released.
+class Unique_fd {
+   public:
+    explicit Unique_fd(int fd) : fd_{fd} {}
+
+    Unique_fd(Unique_fd const&) = delete;
+    Unique_fd& operator=(Unique_fd const&) = delete;
+
+    ~Unique_fd()
+    {
+        if (fd_ != -1)
+            ::close(fd_);
+    }
+
+   public:
+    [[nodiscard]] auto get() const -> int { return fd_; }
+
+    /// Give up ownership of the descriptor and return it.
+    [[nodiscard]] auto release() -> int { return std::exchange(fd_, -1); }
+
+   private:
+    int fd_;
+};
+
+/// Return true if \p pid exits and is reaped within \p grace.
+[[nodiscard]] auto wait_for_exit(::pid_t pid, std::chrono::milliseconds grace)
+    -> bool
+{
+    auto const deadline = std::chrono::steady_clock::now() + grace;
+    while (true) {
+        auto const result = ::waitpid(pid, nullptr, WNOHANG);
+        if (result == pid || (result == -1 && errno != EINTR))
+            return true;
+        if (std::chrono::steady_clock::now() >= deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+}
+
+/// Return the escape sequence for a cursor key, \p app is the DECCKM mode.
+[[nodiscard]] auto cursor_key(char final, bool app) -> std::string
+{
+    return std::string{app ? "\033O" : "\033["} + final;
+}
+
+}  // namespace
+
+namespace ox {
+
+Terminal_view::Terminal_view(std::vector<std::string> command,
+                             FPS refresh_rate)
+    : screen_{Area{80, 24}}, read_buffer_(64 * 1'024)
+{
+    this->focus_policy = Focus_policy::Strong;
+    if (command.empty())
+        throw std::runtime_error{"Terminal_view: Empty command."};
+
+    screen_.set_colors(
+        detail::nearest_palette_colors(Terminal::current_palette()));
+    Terminal::palette_changed().connect(slot::link_lifetimes(
+        [this](Palette const& palette) {
+            auto colors     = detail::nearest_palette_colors(palette);
+            auto const lock = this->Lockable::lock();
+            screen_.set_colors(std::move(colors));
+        },
+        *this));
+
+    // Both ends are closed if anything below throws. Both are close on exec,
+    // so processes forked elsewhere in the program don't hold the pty open.
+    // posix_openpt() does not take O_CLOEXEC portably, so fcntl() is used.
+    auto master = Unique_fd{::posix_openpt(O_RDWR | O_NOCTTY)};
+    if (master.get() == -1 || ::fcntl(master.get(), F_SETFD, FD_CLOEXEC) != 0 ||
+        ::grantpt(master.get()) != 0 || ::unlockpt(master.get()) != 0) {
+        throw std::runtime_error{"Terminal_view: Could not open a pty."};
+    }
+    set_window_size(master.get(), screen_.area());
+
+    // The slave is opened before fork() so the pty never looks hung up to
+    // drain() before the child has started.
+    auto const* const slave_name = ::ptsname(master.get());
+    auto const slave =
+        Unique_fd{slave_name == nullptr
+                      ? -1
+                      : ::open(slave_name, O_RDWR | O_NOCTTY | O_CLOEXEC)};
+    if (slave.get() == -1)
+        throw std::runtime_error{"Terminal_view: Could not open pty slave."};
+
+    // Allocate before fork(), the child only makes async-signal-safe calls.
+    auto env  = child_environment();
+    auto argv = to_argv(command);
+    auto envp = to_argv(env);
+
+    pid_ = ::fork();
+    if (pid_ == -1)
+        throw std::runtime_error{"Terminal_view: Could not fork."};
+    if (pid_ == 0) {  // Never returns, so no destructors run in the child.
+        ::setsid();
+        ::ioctl(slave.get(), TIOCSCTTY, 0);
+        ::dup2(slave.get(), STDIN_FILENO);
+        ::dup2(slave.get(), STDOUT_FILENO);
+        ::dup2(slave.get(), STDERR_FILENO);
+        if (slave.get() > STDERR_FILENO)
+            ::close(slave.get());
+        ::close(master.get());
+        environ = envp.data();
+        ::execvp(argv[0], argv.data());
+        ::_exit(127);
+    }
+    master_fd_ = master.release();
+    ::fcntl(master_fd_, F_SETFL, ::fcntl(master_fd_, F_GETFL) | O_NONBLOCK);
+    this->enable_animation(refresh_rate);
+}
+
+Terminal_view::Terminal_view(Parameters p)
+    : Terminal_view{std::move(p.command), p.refresh_rate}
+{}
+
+Terminal_view::~Terminal_view()
+{
+    this->disable_animation();
+    auto const lock = this->Lockable::lock();
+    if (master_fd_ != -1)
+        ::close(master_fd_);
+    if (pid_ != -1) {
+        // Give the child a moment to handle the hang up before killing it.
+        ::kill(pid_, SIGHUP);
+        if (!wait_for_exit(pid_, std::chrono::milliseconds{100})) {
+            ::kill(pid_, SIGKILL);
+            ::waitpid(pid_, nullptr, 0);
+        }
+    }
+}
+
+void Terminal_view::send(std::string_view bytes)
+{
+    auto const lock = this->Lockable::lock();
+    this->write_to_child(bytes);
+}
+
+void Terminal_view::feed(std::string_view bytes)
+{
+    auto const lock = this->Lockable::lock();
+    parser_.parse(bytes, screen_);
+    this->update_damaged_rows();
+}
+
+auto Terminal_view::is_running() const -> bool
+{
+    auto const lock = this->Lockable::lock();
+    return pid_ != -1;
+}
+
+auto Terminal_view::paint_event(Painter& p) -> bool
+{
+    auto const lock = this->Lockable::lock();
+    auto const region = intersection(p.clip(), {{0, 0}, screen_.area()});
+    auto const x_end = region.top_left.x + region.area.width;
+    auto const y_end = region.top_left.y + region.area.height;
+    for (auto y = region.top_left.y; y < y_end; ++y) {
+        for (auto x = region.top_left.x; x < x_end; ++x)
+            p.put(screen_.at({x, y}), {x, y});
+    }
+    screen_.clear_damage();
+    this->cursor.set_position(screen_.cursor());
+    this->cursor.enable(screen_.is_cursor_visible());
+    return Widget::paint_event(p);
+}
+
+auto Terminal_view::timer_event() -> bool
+{
+    auto exit_status = std::optional<int>{};
+    {
+        auto const lock = this->Lockable::lock();
+        if (master_fd_ == -1)
+            return Widget::timer_event();
+        this->drain();
+        exit_status = this->reap();
+        if (auto const r = screen_.responses(); !r.empty()) {
+            this->write_to_child(r);
+            screen_.clear_responses();
+        }
+        app_cursor_keys_ = screen_.is_application_cursor_keys();
+        this->update_damaged_rows();
+    }
+    if (exit_status.has_value()) {
+        this->disable_animation();
+        exited.emit(*exit_status);
+    }
+    return Widget::timer_event();
+}
+
+auto Terminal_view::resize_event(Area new_size, Area old_size) -> bool
+{
+    {
+        auto const lock = this->Lockable::lock();
+        screen_.resize(new_size);
+        if (master_fd_ != -1)
+            set_window_size(master_fd_, screen_.area());
+    }
+    return Widget::resize_event(new_size, old_size);
+}
+
+auto Terminal_view::key_press_event(Key k) -> bool
+{
+    auto const app = app_cursor_keys_.load();
+    switch (k) {
+        case Key::Arrow_up: this->send(cursor_key('A', app)); break;
+        case Key::Arrow_down: this->send(cursor_key('B', app)); break;
+        case Key::Arrow_right: this->send(cursor_key('C', app)); break;
+        case Key::Arrow_left: this->send(cursor_key('D', app)); break;
+        case Key::Home: this->send(cursor_key('H', app)); break;
+        case Key::End: this->send(cursor_key('F', app)); break;
+        case Key::Delete: this->send("\033[3~"); break;
+        case Key::Back_tab: this->send("\033[Z"); break;
+        case Key::Enter: this->send("\r"); break;
+        case Key::Tab: this->send("\t"); break;
+        case Key::Escape: this->send("\033"); break;
+        case Key::Backspace_1: this->send("\b"); break;
+        case Key::Backspace:
+        case Key::Backspace_2: this->send("\x7f"); break;
+        default:
+            if (auto const c = key_to_char32(k); c != U'\0')
+                this->send(u32_to_mb(c));
+            else if (static_cast<char32_t>(k) < U' ')  // Control characters.
+                this->send(std::string(1, static_cast<char>(k)));
+            break;
+    }
+    return Widget::key_press_event(k);
+}
+
+void Terminal_view::update_damaged_rows()
+{
+    if (!screen_.is_damaged())
+        return;
+    auto const height = std::min(screen_.area().height, this->area().height);
+    auto first        = height;
+    auto last         = -1;
+    for (auto y = 0; y < height; ++y) {
+        if (screen_.is_damaged(y)) {
+            first = std::min(first, y);
+            last  = y;
+        }
+    }
+    if (last != -1)
+        this->update({{0, first}, {this->area().width, last - first + 1}});
+}
+
+auto Terminal_view::read_pty() -> bool
+{
+    auto const count =
+        ::read(master_fd_, read_buffer_.data(), read_buffer_.size());
+    if (count > 0)
+        parser_.parse({read_buffer_.data(), std::size_t(count)}, screen_);
+    // EAGAIN when empty, EIO once every writer has closed.
+    return count > 0 || (count == -1 && errno == EINTR);
+}
+
+void Terminal_view::drain()
+{
+    // Bounded, so a flood of output can't hold the lock indefinitely.
+    for (auto i = 0; i < 64; ++i) {
+        if (!this->read_pty())
+            return;
+    }
+}
+
+auto Terminal_view::reap() -> std::optional<int>
+{
+    auto status       = 0;
+    auto const result = ::waitpid(pid_, &status, WNOHANG);
+    if (result == 0 || (result == -1 && errno == EINTR))
+        return std::nullopt;
+    // The child's last output may still be buffered after the bounded drain().
+    while (this->read_pty())
+        continue;
+    ::close(master_fd_);
+    master_fd_ = -1;
+    pid_       = -1;
+    if (result == -1)
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+void Terminal_view::write_to_child(std::string_view bytes)
+{
+    while (!bytes.empty() && master_fd_ != -1) {
+        auto const count = ::write(master_fd_, bytes.data(), bytes.size());
+        if (count > 0)
+            bytes.remove_prefix(count);
+        else if (count == -1 && errno != EINTR)
+            return;  // Child is not reading, drop the rest.
+    }
+}
+
+auto terminal_view(std::vector<std::string> command, FPS refresh_rate)
+    -> std::unique_ptr<Terminal_view>
+{
+    return std::make_unique<Terminal_view>(std::move(command), refresh_rate);
+}
+
+auto terminal_view(Terminal_view::Parameters p)
+    -> std::unique_ptr<Terminal_view>
+{
+    return std::make_unique<Terminal_view>(std::move(p));
+}
+
+}  // namespace ox
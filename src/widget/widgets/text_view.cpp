@@ -72,7 +72,7 @@ void Text_view::insert(Glyph_string text, int index)
         glyph.brush.traits |= this->insert_brush.traits;
     contents_.insert(std::begin(contents_) + index, std::begin(text),
                      std::end(text));
-    this->update();
+    this->update_from(index);
     contents_modified(contents_);
 }
 
@@ -80,8 +80,9 @@ void Text_view::append(Glyph_string text)
 {
     for (auto& glyph : text)
         glyph.brush.traits |= this->insert_brush.traits;
+    auto const index = contents_.size();
     contents_.append(text);
-    this->update();
+    this->update_from(index);
     contents_modified(contents_);
 }
 
@@ -94,7 +95,7 @@ void Text_view::erase(int index, int length)
     if (length == Glyph_string::npos)
         end = std::end(contents_);
     contents_.erase(std::begin(contents_) + index, end);
-    this->update();
+    this->update_from(index);
     contents_modified(contents_);
 }
 
@@ -103,7 +104,7 @@ void Text_view::pop_back()
     if (contents_.empty())
         return;
     contents_.pop_back();
-    this->update();
+    this->update_from(contents_.size());
     contents_modified(contents_);
 }
 
@@ -210,7 +211,8 @@ void Text_view::update()
 
 auto Text_view::paint_event(Painter& p) -> bool
 {
-    auto line_n = 0;
+    auto const clip = p.clip();
+    auto line_n     = clip.top_left.y;
     auto paint  = [&p, &line_n, this](Line_info const& line) {
         auto const sub_begin = std::begin(this->contents_) + line.start_index;
         auto const sub_end   = sub_begin + line.length;
@@ -226,15 +228,16 @@ auto Text_view::paint_event(Painter& p) -> bool
         }
         p.put(Glyph_string(sub_begin, sub_end), {start, line_n++});
     };
-    auto const begin = std::next(std::cbegin(display_state_), this->top_line());
+    auto const first = this->top_line() + clip.top_left.y;
+    auto const begin = std::next(std::cbegin(display_state_), first);
     auto const end   = [&] {
-        auto const end_index = this->top_line() + this->area().height;
+        auto const end_index = first + clip.area.height;
         if ((int)display_state_.size() > end_index)
-            return std::next(begin, this->area().height);
+            return std::next(begin, clip.area.height);
         else
             return std::cend(display_state_);
     }();
-    if (this->top_line() < (int)display_state_.size())
+    if (first < (int)display_state_.size())
         std::for_each(begin, end, paint);
     return Widget::paint_event(p);
 }
@@ -333,6 +336,27 @@ void Text_view::update_display(int from_line)
     line_count_changed(display_state_.size());
 }
 
+void Text_view::update_from(int index)
+{
+    auto const previous_top = top_line_;
+    auto const previous     = display_state_;
+    this->update_display();
+    if (top_line_ != previous_top) {
+        Widget::update();
+        return;
+    }
+    auto const changed = std::mismatch(
+        std::cbegin(previous), std::cend(previous), std::cbegin(display_state_),
+        std::cend(display_state_), [](Line_info a, Line_info b) {
+            return a.start_index == b.start_index && a.length == b.length;
+        });
+    auto const line = std::min(
+        this->line_at(index),
+        (int)std::distance(std::cbegin(previous), changed.first));
+    auto const y = std::max(line - this->top_line(), 0);
+    Widget::update({{0, y}, {this->area().width, this->area().height - y}});
+}
+
 auto text_view(Glyph_string text, Align alignment, Wrap wrap)
     -> std::unique_ptr<Text_view>
 {
@@ -0,0 +1,110 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/glyph_string.hpp>
+#include <termox/painter/grapheme.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/widgets/button.hpp>
+#include <termox/widget/widgets/label.hpp>
+
+// Replaces the global operator new of the unit test executable, so that the
+// heap allocations made by a block of code can be counted.
+
+namespace {
+
+auto allocations = std::atomic<std::size_t>{0};
+
+/// Return the number of calls to operator new made by \p f.
+template <typename F>
+[[nodiscard]] auto count_allocations(F&& f) -> std::size_t
+{
+    auto const before = allocations.load();
+    f();
+    return allocations.load() - before;
+}
+
+/// Button and Label text from the demos, each under 16 glyphs.
+auto const labels = std::vector<std::u32string>{
+    U"- Color -", U"Status", U"Pin Count", U"Clear", U"< Back", U"Add Widget",
+    U"Load", U"Save", U"Use HSL", U"Step>", U"Filename", U"Clone Tool",
+    U"More Options", U"Back", U"- Traits -"};
+
+/// Return the allocations made constructing a Widget_t with \p text.
+template <typename Widget_t>
+[[nodiscard]] auto widget_allocations(std::u32string const& text)
+    -> std::size_t
+{
+    return count_allocations(
+        [&] { auto const w = Widget_t{ox::Glyph_string{text}}; });
+}
+
+}  // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+    ++allocations;
+    if (auto* const p = std::malloc(size == 0 ? 1 : size); p != nullptr)
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+TEST_CASE("Short Glyph_strings do not allocate", "[allocation]")
+{
+    for (auto const& text : labels) {
+        auto const count = count_allocations([&] {
+            auto const gs = ox::Glyph_string{text, ox::Trait::Bold};
+            auto copy     = gs;
+            copy.append(U'!');
+            copy = gs;
+        });
+        CHECK(count == 0);
+    }
+    auto const long_text = std::u32string(40, U'x');
+    auto const long_gs   = ox::Glyph_string{long_text};
+    CHECK(count_allocations([&] { auto const copy = long_gs; }) == 1);
+}
+
+TEST_CASE("Interning a known grapheme cluster does not allocate",
+          "[allocation]")
+{
+    // Family emoji, too long for the small string buffer.
+    auto const cluster =
+        std::u32string{U"\U0001F468\u200D\U0001F469\u200D\U0001F467"};
+    auto const symbol  = ox::detail::intern_grapheme_cluster(cluster);
+    auto interned      = char32_t{0};
+    CHECK(count_allocations([&] {
+              interned = ox::detail::intern_grapheme_cluster(cluster);
+          }) == 0);
+    CHECK(interned == symbol);
+}
+
+TEST_CASE("Short labels save an allocation per Widget", "[allocation]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto long_labels = labels;
+    for (auto& text : long_labels)
+        text.append(16, U'.');
+
+    // The first Widget of a Session allocates its lazily created state.
+    (void)widget_allocations<ox::Button>(labels.front());
+
+    // Each Button and HLabel holds one copy of its text.
+    for (auto i = std::size_t{0}; i < labels.size(); ++i) {
+        CHECK(widget_allocations<ox::Button>(long_labels[i]) ==
+              widget_allocations<ox::Button>(labels[i]) + 1);
+        CHECK(widget_allocations<ox::HLabel>(long_labels[i]) ==
+              widget_allocations<ox::HLabel>(labels[i]) + 1);
+    }
+}
@@ -78,3 +78,60 @@ TEST_CASE("Canvas: Everything", "[Canvas]")
     CHECK(diff.at(2).first == ox::Point{3, 16});
     CHECK(diff.at(2).second == ox::Glyph{U'x', bg(ox::Color::Blue)});
 }
+
+TEST_CASE("Canvas: Color_occupancy", "[Canvas]")
+{
+    auto const area = ox::Area{30, 12};
+    auto current    = ox::detail::Canvas{area};
+    auto next       = ox::detail::Canvas{area};
+    auto occupancy  = ox::detail::Color_occupancy{};
+    occupancy.rebuild(current);
+    CHECK(occupancy.height() == 12);
+    CHECK(occupancy.total(ox::Color::Background) == 30 * 12);
+
+    auto const blue   = ox::Color::Blue;
+    auto const orange = ox::Color::Orange;
+
+    next.at({0, 0})  = ox::Glyph{U'a', bg(blue)};
+    next.at({29, 0}) = ox::Glyph{U'b', fg(blue), bg(blue)};
+    next.at({4, 7})  = ox::Glyph{U'c', fg(orange), bg(blue)};
+    next.at({9, 11}) = ox::Glyph{U'd', fg(orange)};
+
+    auto diff = ox::detail::Canvas::Diff{};
+    merge_and_diff(next, current, diff, occupancy);
+    REQUIRE(diff.size() == 4);
+
+    CHECK(occupancy.count(blue, 0) == 2);
+    CHECK(occupancy.count(blue, 7) == 1);
+    CHECK(occupancy.count(blue, 11) == 0);
+    CHECK(occupancy.total(blue) == 3);
+    CHECK(occupancy.count(orange, 7) == 1);
+    CHECK(occupancy.count(orange, 11) == 1);
+    CHECK(occupancy.total(orange) == 2);
+
+    auto expected = ox::detail::Canvas::Diff{};
+    generate_color_diff(blue, current, expected);
+    generate_color_diff(blue, current, occupancy, diff);
+    CHECK(diff == expected);
+    REQUIRE(diff.size() == 3);
+
+    // Overwrite and confirm counts follow the replaced Glyphs.
+    next.reset();
+    next.at({0, 0}) = ox::Glyph{U'e', fg(orange)};
+    next.at({4, 7}) = ox::Glyph{U'f'};
+    merge(next, current, occupancy);
+    CHECK(occupancy.count(blue, 0) == 1);
+    CHECK(occupancy.count(blue, 7) == 0);
+    CHECK(occupancy.total(blue) == 1);
+    CHECK(occupancy.total(orange) == 2);
+
+    generate_color_diff(orange, current, expected);
+    generate_color_diff(orange, current, occupancy, diff);
+    CHECK(diff == expected);
+
+    current.resize({10, 10});
+    occupancy.rebuild(current);
+    CHECK(occupancy.height() == 10);
+    CHECK(occupancy.total(blue) == 0);
+    CHECK(occupancy.total(orange) == 1);
+}
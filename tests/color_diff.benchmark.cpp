@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <termox/painter/color.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/widget/area.hpp>
+
+// Compares full Canvas scans against Color_occupancy lookups for Color
+// targeted repaints, with several dynamic colors active at once. Five dynamic
+// colors at 30Hz is 150 color diffs per second, this runs that for 10 seconds.
+
+namespace {
+
+using Clock_t = std::chrono::steady_clock;
+
+auto constexpr area             = ox::Area{300, 100};
+auto constexpr dynamic_count    = 5;
+auto constexpr ticks            = 30 * 10;
+auto constexpr dynamic_base     = ox::Color::Value_t{100};
+auto constexpr changes_per_tick = 200;
+
+/// Return a Glyph with a dynamic color in roughly 1 of \p rarity cells.
+template <typename Gen>
+auto random_glyph(Gen& gen, int rarity) -> ox::Glyph
+{
+    auto cell    = std::uniform_int_distribution<int>{0, rarity - 1};
+    auto dynamic = std::uniform_int_distribution<int>{0, dynamic_count - 1};
+    auto g       = ox::Glyph{U'x'};
+    if (cell(gen) == 0)
+        g.brush.background = ox::Color(dynamic_base + dynamic(gen));
+    if (cell(gen) == 0)
+        g.brush.foreground = ox::Color(dynamic_base + dynamic(gen));
+    return g;
+}
+
+/// Run the dynamic color ticks, with some painting between each tick.
+/** Returns the total time spent generating color diffs. */
+template <typename Color_diff_fn, typename Merge_fn>
+auto run(int rarity, Color_diff_fn&& color_diff, Merge_fn&& merge_fn)
+    -> Clock_t::duration
+{
+    auto gen     = std::mt19937{42};
+    auto current = ox::detail::Canvas{area};
+    auto next    = ox::detail::Canvas{area};
+    for (auto& g : next)
+        g = random_glyph(gen, rarity);
+    merge_fn(next, current);
+
+    auto x             = std::uniform_int_distribution<int>{0, area.width - 1};
+    auto y             = std::uniform_int_distribution<int>{0, area.height - 1};
+    auto diff          = ox::detail::Canvas::Diff{};
+    auto cells_visited = std::size_t{0};
+    auto elapsed       = Clock_t::duration::zero();
+    for (auto i = 0; i < ticks; ++i) {
+        next.reset();
+        for (auto j = 0; j < changes_per_tick; ++j)
+            next.at({x(gen), y(gen)}) = random_glyph(gen, rarity);
+        merge_fn(next, current);
+
+        auto const begin = Clock_t::now();
+        for (auto c = 0; c < dynamic_count; ++c) {
+            color_diff(ox::Color(dynamic_base + c), current, diff);
+            cells_visited += diff.size();
+        }
+        elapsed += Clock_t::now() - begin;
+    }
+    std::cout << "    cells repainted: " << cells_visited << '\n';
+    return elapsed;
+}
+
+void report(char const* name, Clock_t::duration d)
+{
+    using namespace std::chrono;
+    std::cout << "    " << name << ": "
+              << duration_cast<microseconds>(d).count() / 1'000. << "ms\n";
+}
+
+}  // namespace
+
+int main()
+{
+    for (int rarity : {2, 20, 200, 2'000}) {
+        std::cout << "Dynamic colors in ~1/" << rarity << " of cells\n";
+
+        auto const scan = run(
+            rarity,
+            [](ox::Color c, auto const& canvas, auto& diff) {
+                ox::detail::generate_color_diff(c, canvas, diff);
+            },
+            [](auto const& next, auto& current) {
+                ox::detail::merge(next, current);
+            });
+        report("full scan", scan);
+
+        auto occupancy    = ox::detail::Color_occupancy{};
+        auto const lookup = run(
+            rarity,
+            [&](ox::Color c, auto const& canvas, auto& diff) {
+                ox::detail::generate_color_diff(c, canvas, occupancy, diff);
+            },
+            [&](auto const& next, auto& current) {
+                if (occupancy.height() != current.area().height)
+                    occupancy.rebuild(current);
+                ox::detail::merge(next, current, occupancy);
+            });
+        report("occupancy", lookup);
+    }
+}
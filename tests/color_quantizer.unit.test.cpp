@@ -0,0 +1,82 @@
+#include <set>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/color.hpp>
+#include <termox/painter/palette/basic.hpp>
+#include <termox/terminal/detail/color_quantizer.hpp>
+
+using ox::detail::nearest_palette_colors;
+using ox::detail::quantize;
+using ox::detail::quantize_dithered;
+
+TEST_CASE("quantize to xterm 256 colors", "[Color_quantizer]")
+{
+    CHECK(quantize(ox::RGB{0x000000}, 256).value == 16);
+    CHECK(quantize(ox::RGB{0xffffff}, 256).value == 231);
+    CHECK(quantize(ox::RGB{0xff0000}, 256).value == 196);
+    CHECK(quantize(ox::RGB{0x00ff00}, 256).value == 46);
+    CHECK(quantize(ox::RGB{0x0000ff}, 256).value == 21);
+    CHECK(quantize(ox::RGB{0x767676}, 256).value == 243);
+    CHECK(quantize(ox::RGB{0x5f87af}, 256).value == 67);
+}
+
+TEST_CASE("quantize to system colors", "[Color_quantizer]")
+{
+    CHECK(quantize(ox::RGB{0x000000}, 16).value == 0);
+    CHECK(quantize(ox::RGB{0xffffff}, 16).value == 15);
+    CHECK(quantize(ox::RGB{0xff0000}, 16).value == 9);
+    CHECK(quantize(ox::RGB{0xb00000}, 8).value == 1);
+    CHECK(quantize(ox::RGB{0xffffff}, 8).value == 7);
+}
+
+TEST_CASE("quantize_dithered spreads between neighbors", "[Color_quantizer]")
+{
+    // Between two grayscale ramp entries.
+    auto const tc = ox::True_color{ox::RGB{0x7b7b7b}};
+    auto indices  = std::set<int>{};
+    for (auto y = 0; y < 4; ++y) {
+        for (auto x = 0; x < 4; ++x)
+            indices.insert(quantize_dithered(tc, 256, {x, y}).value);
+    }
+    CHECK(indices.size() > 1);
+    CHECK(quantize_dithered(tc, 256, {1, 2}).value ==
+          quantize_dithered(tc, 256, {5, 6}).value);
+}
+
+TEST_CASE("quantize skips excluded indices", "[Color_quantizer]")
+{
+    auto const gray = ox::True_color{ox::RGB{0xeeeeee}};
+    REQUIRE(quantize(gray, 256).value == 255);
+
+    // The top of the grayscale ramp, as reserved for Dynamic_colors.
+    auto excluded = ox::detail::Palette_mask{};
+    for (auto i = 250; i < 256; ++i)
+        excluded.set(i);
+    CHECK(quantize(gray, 256, excluded).value < 250);
+    for (auto y = 0; y < 4; ++y) {
+        for (auto x = 0; x < 4; ++x)
+            CHECK(quantize_dithered(gray, 256, {x, y}, excluded).value < 250);
+    }
+    CHECK(quantize(gray, 256).value == 255);
+}
+
+TEST_CASE("nearest_palette_colors maps xterm indices", "[Color_quantizer]")
+{
+    auto const colors = nearest_palette_colors(ox::basic::palette);
+    REQUIRE(colors.size() == 256);
+    CHECK(colors[1] == ox::basic::Maroon);
+    CHECK(colors[12] == ox::basic::Blue);
+    CHECK(colors[196] == ox::basic::Red);
+    CHECK(colors[231] == ox::basic::White);
+    CHECK(colors[232] == ox::basic::Black);
+
+    auto const true_colors = nearest_palette_colors(
+        {{ox::Color{3}, ox::True_color{ox::RGB{0x101010}}},
+         {ox::Color{7}, ox::True_color{ox::RGB{0xf0f0f0}}}});
+    CHECK(true_colors[16] == ox::Color{3});
+    CHECK(true_colors[15] == ox::Color{7});
+
+    auto const identity = nearest_palette_colors({});
+    CHECK(identity[200] == ox::Color{200});
+}
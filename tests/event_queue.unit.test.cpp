@@ -0,0 +1,199 @@
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <esc/event.hpp>
+
+#include <termox/painter/color.hpp>
+#include <termox/system/event.hpp>
+#include <termox/system/event_queue.hpp>
+#include <termox/system/key.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+auto constexpr area = ox::Area{10, 20};
+
+}  // namespace
+
+TEST_CASE("priority_of ranks input above layout above timers",
+          "[Event_queue]")
+{
+    using ox::detail::Event_priority;
+    using ox::detail::priority_of;
+    auto w = ox::Widget{};
+    CHECK(priority_of(ox::Key_press_event{w, ox::Key::Enter}) ==
+          Event_priority::Input);
+    CHECK(priority_of(esc::Window_resize{area}) == Event_priority::Input);
+    CHECK(priority_of(ox::Move_event{w, {1, 1}}) == Event_priority::Layout);
+    CHECK(priority_of(ox::Focus_in_event{w}) == Event_priority::Layout);
+    CHECK(priority_of(ox::Timer_event{w}) == Event_priority::Timer);
+    CHECK(priority_of(ox::detail::Payload_ref{
+              0, Event_priority::Dynamic_color}) ==
+          Event_priority::Dynamic_color);
+    CHECK(Event_priority::Input > Event_priority::Layout);
+    CHECK(Event_priority::Layout > Event_priority::Timer);
+    CHECK(Event_priority::Timer > Event_priority::Dynamic_color);
+    CHECK(Event_priority::Dynamic_color > Event_priority::Paint);
+}
+
+TEST_CASE("Events are sent by priority, in order within a priority",
+          "[Event_queue]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+    auto sent        = std::vector<std::string>{};
+    head.timer.connect([&] { sent.push_back("timer"); });
+    head.key_pressed.connect([&](ox::Key) { sent.push_back("key"); });
+    head.moved.connect([&](ox::Point p, ox::Point) {
+        sent.push_back("move " + std::to_string(p.x));
+    });
+
+    check = [&] {
+        auto queue = ox::Event_queue{};
+        queue.append(ox::Timer_event{head});
+        queue.append(ox::Move_event{head, {1, 0}});
+        queue.append(ox::Move_event{head, {2, 0}});
+        queue.append(ox::Key_press_event{head, ox::Key::Enter});
+        queue.send_all();
+        CHECK(sent == std::vector<std::string>{"key", "move 1", "move 2",
+                                               "timer"});
+    };
+    session.run(head);
+}
+
+TEST_CASE("A spent budget defers timers but never input", "[Event_queue]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+    auto timers      = 0;
+    auto keys        = 0;
+    head.timer.connect([&] { ++timers; });
+    head.key_pressed.connect([&](ox::Key) { ++keys; });
+
+    check = [&] {
+        auto queue = ox::Event_queue{};
+        queue.set_budget(ox::Event_queue::Budget_t{0});
+        queue.append(ox::Timer_event{head});
+        queue.append(ox::Timer_event{head});
+        queue.append(ox::Key_press_event{head, ox::Key::Enter});
+        queue.append(ox::Key_press_event{head, ox::Key::Enter});
+
+        queue.send_all();
+        CHECK(keys == 2);
+        CHECK(timers == 1);
+
+        queue.send_all();
+        CHECK(timers == 2);
+    };
+    session.run(head);
+}
+
+TEST_CASE("Backpressure coalesces and drops deferrable events",
+          "[Event_queue]")
+{
+    auto w1    = ox::Widget{};
+    auto w2    = ox::Widget{};
+    auto w3    = ox::Widget{};
+    auto queue = ox::Event_queue{};
+    queue.set_backpressure({3, true, true, false});
+
+    queue.append(ox::Timer_event{w1});
+    queue.append(ox::Timer_event{w1});
+    queue.append(ox::Timer_event{w2});
+    queue.append(ox::Dynamic_color_event{{{ox::Color{1}, ox::RGB{0x000001}},
+                                          {ox::Color{2}, ox::RGB{0x000002}}}});
+    queue.append(ox::Dynamic_color_event{{{ox::Color{1}, ox::RGB{0x000003}},
+                                          {ox::Color{3}, ox::RGB{0x000004}}}});
+    queue.append(ox::Timer_event{w3});
+
+    auto const counts = queue.shed_counts();
+    CHECK(counts.timers_coalesced == 1);
+    CHECK(counts.colors_coalesced == 1);
+    CHECK(counts.dropped == 1);
+    CHECK(counts.paused_frames == 0);
+}
+
+TEST_CASE("begin_frame pauses producers while events wait", "[Event_queue]")
+{
+    auto w     = ox::Widget{};
+    auto queue = ox::Event_queue{};
+    CHECK(queue.begin_frame());
+    queue.append(ox::Timer_event{w});
+    CHECK(queue.begin_frame());
+
+    queue.set_backpressure({64, true, true, true});
+    CHECK(!queue.begin_frame());
+    CHECK(queue.shed_counts().paused_frames == 1);
+}
+
+TEST_CASE("forget_timers drops waiting Timer_events", "[Event_queue]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+    auto timers      = 0;
+    head.timer.connect([&] { ++timers; });
+
+    check = [&] {
+        auto queue = ox::Event_queue{};
+        queue.append(ox::Timer_event{head});
+        queue.forget_timers(head);
+        queue.send_all();
+        CHECK(timers == 0);
+
+        queue.append(ox::Timer_event{head});
+        queue.send_all();
+        CHECK(timers == 1);
+    };
+    session.run(head);
+}
+
+TEST_CASE("Coalesced Timer_events send the newest Frame_time",
+          "[Event_queue]")
+{
+    using namespace std::chrono_literals;
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+    auto sent        = ox::Frame_time{};
+    head.timer.connect([&] { sent = head.frame_time(); });
+
+    check = [&] {
+        auto queue = ox::Event_queue{};
+        queue.set_backpressure({64, true, true, false});
+        auto first    = ox::Frame_time{};
+        first.steps   = 2;
+        first.elapsed = 20ms;
+        auto second   = first;
+        second.scheduled += 20ms;
+        second.actual += 25ms;
+        auto third = second;
+        third.scheduled += 20ms;
+        third.actual += 20ms;
+        queue.append(ox::Timer_event{head, first});
+        queue.append(ox::Timer_event{head, second});
+        queue.append(ox::Timer_event{head, third});
+        queue.send_all();
+        CHECK(sent.steps == 6);
+        CHECK(sent.elapsed == 60ms);
+        CHECK(sent.scheduled == third.scheduled);
+        CHECK(sent.actual == third.actual);
+    };
+    session.run(head);
+}
@@ -0,0 +1,121 @@
+#include <functional>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/bordered.hpp>
+#include <termox/widget/framed.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+auto constexpr area = ox::Area{8, 4};
+
+/// Return the symbol at \p p on the screen.
+[[nodiscard]] auto symbol_at(ox::Point p) -> char32_t
+{
+    return ox::Terminal::screen_buffers().current.at(p).symbol;
+}
+
+/// Widget that counts its Paint_events.
+class Counted : public ox::Widget {
+   public:
+    int paints = 0;
+
+   protected:
+    auto paint_event(ox::Painter& p) -> bool override
+    {
+        ++paints;
+        return Widget::paint_event(p);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Framed insets wrapped and paints the Border", "[Framed]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto const b     = ox::border::squared();
+    auto head        = ox::Framed<ox::Widget>{b};
+    REQUIRE(head.wrapped.parent() == &head);
+
+    check = [&] {
+        CHECK(head.wrapped.top_left() == ox::Point{1, 1});
+        CHECK(head.wrapped.area() == ox::Area{6, 2});
+        CHECK(symbol_at({0, 0}) == b.nw_corner.symbol);
+        CHECK(symbol_at({7, 3}) == b.se_corner.symbol);
+        CHECK(symbol_at({3, 0}) == b.north->symbol);
+        CHECK(symbol_at({0, 2}) == b.west->symbol);
+    };
+    session.run(head);
+}
+
+TEST_CASE("Framed without walls gives wrapped the full area", "[Framed]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Framed<ox::Widget>{ox::border::none()};
+
+    check = [&] {
+        CHECK(head.wrapped.top_left() == ox::Point{0, 0});
+        CHECK(head.wrapped.area() == area);
+    };
+    session.run(head);
+}
+
+TEST_CASE("Framed::set_border emits border_set", "[Framed]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Framed<ox::Widget>{};
+    auto count       = 0;
+    head.border_set.connect([&] { ++count; });
+    head.set_border(ox::border::doubled());
+    CHECK(count == 1);
+    CHECK(head.border().nw_corner == ox::border::doubled().nw_corner);
+}
+
+TEST_CASE("Framed::update repaints only the Border", "[Framed]")
+{
+    auto steps       = std::vector<std::function<void()>>{};
+    auto session     = ox::Session{ox::test::frames(steps, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto const b     = ox::border::squared();
+    auto head        = ox::Framed<Counted>{b};
+    head.wrapped.set_wallpaper(U'w');
+    auto paints = 0;
+
+    steps = {[&] {
+                 paints = head.wrapped.paints;
+                 CHECK(paints > 0);
+                 CHECK(head.covered_region().top_left == ox::Point{1, 1});
+                 CHECK(head.covered_region().area == ox::Area{6, 2});
+                 head.update();
+             },
+             [&] {
+                 CHECK(head.wrapped.paints == paints);
+                 CHECK(symbol_at({0, 0}) == b.nw_corner.symbol);
+                 CHECK(symbol_at({3, 1}) == U'w');
+             }};
+    session.run(head);
+}
+
+TEST_CASE("Framed Layouts are covered by the Border", "[Framed]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Framed<ox::layout::Vertical<>>{};
+    CHECK(is_empty(head.covered_region()));
+}
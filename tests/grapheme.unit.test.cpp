@@ -0,0 +1,58 @@
+#include <termox/painter/grapheme.hpp>
+
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/glyph.hpp>
+#include <termox/painter/glyph_string.hpp>
+
+TEST_CASE("Grapheme boundaries", "[Grapheme]")
+{
+    using ox::next_grapheme_boundary;
+    CHECK(next_grapheme_boundary(U"ab", 0) == 1);
+    CHECK(next_grapheme_boundary(U"e\u0301x", 0) == 2);
+    CHECK(next_grapheme_boundary(U"\r\nx", 0) == 2);
+    CHECK(next_grapheme_boundary(U"\u0301", 0) == 1);
+
+    // Woman with a skin tone modifier, ZWJ, laptop.
+    auto const emoji = std::u32string{U"\U0001F469\U0001F3FD\u200D\U0001F4BB"};
+    CHECK(next_grapheme_boundary(emoji, 0) == emoji.size());
+
+    // Two flags.
+    auto const flags =
+        std::u32string{U"\U0001F1EF\U0001F1F5\U0001F1FA\U0001F1F8"};
+    CHECK(next_grapheme_boundary(flags, 0) == 2);
+    CHECK(next_grapheme_boundary(flags, 2) == 4);
+}
+
+TEST_CASE("Interned clusters are shared and round trip", "[Grapheme]")
+{
+    CHECK(ox::intern_grapheme(U"a") == U'a');
+    CHECK(!ox::is_grapheme_cluster(U'a'));
+
+    auto const e_acute = ox::intern_grapheme(U"e\u0301");
+    CHECK(ox::is_grapheme_cluster(e_acute));
+    CHECK(ox::intern_grapheme(U"e\u0301") == e_acute);
+    CHECK(ox::intern_grapheme(U"a\u0301") != e_acute);
+    CHECK(ox::grapheme_code_points(e_acute) == U"e\u0301");
+
+    auto const marks =
+        std::u32string(ox::max_grapheme_cluster_length, U'\u0301');
+    auto const long_cluster = ox::intern_grapheme(U"o" + marks);
+    CHECK(ox::grapheme_code_points(long_cluster).size() ==
+          ox::max_grapheme_cluster_length);
+    CHECK(ox::intern_grapheme(U"o" + marks + U"\u0301") == long_cluster);
+    CHECK(sizeof(ox::Glyph) == 8);
+}
+
+TEST_CASE("Glyph_string segments graphemes", "[Grapheme]")
+{
+    auto const text = ox::Glyph_string{U"Cafe\u0301 \U0001F1EF\U0001F1F5!"};
+    REQUIRE(text.size() == 7);
+    CHECK(ox::is_grapheme_cluster(text[3].symbol));
+    CHECK(ox::is_grapheme_cluster(text[5].symbol));
+    CHECK(text[6].symbol == U'!');
+    CHECK(text.u32str() == U"Cafe\u0301 \U0001F1EF\U0001F1F5!");
+    CHECK(text == ox::Glyph_string{U"Cafe\u0301 \U0001F1EF\U0001F1F5!"});
+}
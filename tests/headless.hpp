@@ -0,0 +1,52 @@
+#ifndef TERMOX_TESTS_HEADLESS_HPP
+#define TERMOX_TESTS_HEADLESS_HPP
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <esc/event.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/widget/area.hpp>
+
+// Session_backends for unit tests that run a Session without a terminal.
+// The backend's read function is called once per frame, after the queued
+// Events have been processed and the screen has been flushed.
+
+namespace ox::test {
+
+/// Headless terminal of Area \p a that calls \p check after the first frame.
+/** The Session exits after \p check returns. \p check is held by reference,
+ *  so it can be assigned after the Session is constructed. */
+[[nodiscard]] inline auto first_frame(std::function<void()> const& check,
+                                      Area a) -> Session_backend
+{
+    return {-1,
+            [&check, a]() -> esc::Event {
+                check();
+                Session::current().exit(0);
+                return esc::Window_resize{a};
+            },
+            a};
+}
+
+/// Headless terminal of Area \p a that calls each of \p steps after a frame.
+/** The Session exits on the frame after the last step. \p steps is held by
+ *  reference, so it can be filled in after the Session is constructed. */
+[[nodiscard]] inline auto frames(
+    std::vector<std::function<void()>> const& steps,
+    Area a) -> Session_backend
+{
+    return {-1,
+            [&steps, a, i = std::size_t{0}]() mutable -> esc::Event {
+                if (i < steps.size())
+                    steps[i++]();
+                else
+                    Session::current().exit(0);
+                return esc::Window_resize{a};
+            },
+            a};
+}
+
+}  // namespace ox::test
+#endif  // TERMOX_TESTS_HEADLESS_HPP
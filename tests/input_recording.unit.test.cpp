@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <string>
+#include <variant>
+
+#include <esc/event.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/color.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/painter/grapheme.hpp>
+#include <termox/system/input_recording.hpp>
+#include <termox/system/key.hpp>
+#include <termox/system/mouse.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/terminal/terminal.hpp>
+
+namespace {
+
+auto const path = std::string{"input_recording.unit.test.bin"};
+
+}  // namespace
+
+TEST_CASE("Input_replay reads back what Input_recorder wrote", "[Input]")
+{
+    auto session = ox::Session{ox::Session_backend{-1, nullptr}};
+    {
+        auto const scope = ox::Session_scope{&session};
+        auto recorder    = ox::Input_recorder{path};
+        recorder.record(esc::Key_press{ox::Key::a});
+        auto mouse           = ox::Mouse{};
+        mouse.at             = {300, 7};
+        mouse.button         = ox::Mouse::Button::Right;
+        mouse.modifiers.ctrl = true;
+        recorder.record(esc::Mouse_press{mouse});
+        recorder.record(esc::Window_resize{{132, 43}});
+        CHECK(recorder.size() == 3);
+    }
+
+    auto const replay   = ox::Input_replay{path};
+    auto const& records = replay.records();
+    REQUIRE(records.size() == 3);
+    CHECK(records[0].offset <= records[1].offset);
+    CHECK(records[1].offset <= records[2].offset);
+
+    REQUIRE(std::holds_alternative<esc::Key_press>(records[0].event));
+    CHECK(std::get<esc::Key_press>(records[0].event).key == ox::Key::a);
+
+    REQUIRE(std::holds_alternative<esc::Mouse_press>(records[1].event));
+    auto const& m = std::get<esc::Mouse_press>(records[1].event).state;
+    CHECK(m.at.x == 300);
+    CHECK(m.at.y == 7);
+    CHECK(m.button == ox::Mouse::Button::Right);
+    CHECK(m.modifiers.ctrl);
+    CHECK_FALSE(m.modifiers.shift);
+
+    REQUIRE(std::holds_alternative<esc::Window_resize>(records[2].event));
+    auto const& r = std::get<esc::Window_resize>(records[2].event);
+    CHECK(r.new_dimensions.width == 132);
+    CHECK(r.new_dimensions.height == 43);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Input_replay rejects files that are not recordings", "[Input]")
+{
+    CHECK_THROWS(ox::Input_replay{"does/not/exist.bin"});
+    if (auto* const f = std::fopen(path.c_str(), "wb"); f != nullptr) {
+        std::fputs("TOXI\x01\x05", f);  // Delta with no event tag.
+        std::fclose(f);
+    }
+    CHECK_THROWS(ox::Input_replay{path});
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Headless Session counts and discards output", "[Input]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr, {40, 10}}};
+    auto const scope = ox::Session_scope{&session};
+    CHECK(ox::Terminal::area() == ox::Area{40, 10});
+    ox::Terminal::move_cursor({2, 1});
+    CHECK(session.bytes_written() == 6);
+}
+
+TEST_CASE("screen_hash depends on symbols and Brushes", "[Input]")
+{
+    auto a = ox::detail::Canvas{{3, 2}};
+    auto b = ox::detail::Canvas{{3, 2}};
+    CHECK(ox::screen_hash(a) == ox::screen_hash(b));
+    b.at({1, 1}) = ox::Glyph{U'x'};
+    CHECK(ox::screen_hash(a) != ox::screen_hash(b));
+    a.at({1, 1}) = ox::Glyph{U'x', fg(ox::Color::Red)};
+    CHECK(ox::screen_hash(a) != ox::screen_hash(b));
+    CHECK(ox::screen_hash(a) != ox::screen_hash(ox::detail::Canvas{{2, 3}}));
+
+    // Clusters are hashed by their code points, not their interned symbol.
+    auto c = ox::detail::Canvas{{3, 2}};
+    auto d = ox::detail::Canvas{{3, 2}};
+    c.at({0, 0}) = ox::Glyph{ox::intern_grapheme(U"e\u0301")};
+    d.at({0, 0}) = ox::Glyph{ox::intern_grapheme(U"e\u0301")};
+    CHECK(ox::screen_hash(c) == ox::screen_hash(d));
+    d.at({0, 0}) = ox::Glyph{ox::intern_grapheme(U"e\u0300")};
+    CHECK(ox::screen_hash(c) != ox::screen_hash(d));
+}
@@ -0,0 +1,342 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <esc/event.hpp>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/trait.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/system/system.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/terminal/terminal.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/boundary.hpp>
+#include <termox/widget/layouts/horizontal.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/pipe.hpp>
+#include <termox/widget/widget.hpp>
+#include <termox/widget/widgets/checkbox.hpp>
+#include <termox/widget/widgets/graph.hpp>
+#include <termox/widget/widgets/label.hpp>
+#include <termox/widget/widgets/log.hpp>
+#include <termox/widget/widgets/spinner.hpp>
+#include <termox/widget/widgets/textbox.hpp>
+#include <termox/widget/widgets/titlebar.hpp>
+
+// Runs scripted scenarios on a headless Session and checks the bytes written
+// to the terminal against the budgets in output_bytes.budgets. Run with
+// TERMOX_UPDATE_BUDGETS=1 to write the current totals as the new budgets, a
+// scenario missing from the file fails otherwise.
+
+namespace {
+
+auto constexpr area = ox::Area{80, 24};
+
+/// Bytes written to the terminal and cells rewritten by a single frame.
+struct Frame {
+    std::size_t bytes;
+    ox::detail::Canvas::Diff cells;
+};
+
+/// Run a default constructed Head_t in a headless Session.
+/** \p step is called before each frame, frame 0 is initialization and the
+ *  initial paint. Head_t is constructed within the Session so that anything
+ *  it registers, such as animation, belongs to that Session. \p compress is
+ *  passed on to Terminal::set_run_compression(), off like the default. */
+template <typename Head_t>
+auto run_scenario(int frame_count,
+                  std::function<void(Head_t&, int)> const& step,
+                  bool compress = false) -> std::vector<Frame>
+{
+    auto frames     = std::vector<Frame>{};
+    auto last_bytes = std::size_t{0};
+    auto head       = std::unique_ptr<Head_t>{nullptr};
+    auto read       = [&]() -> esc::Event {
+        auto& session    = ox::Session::current();
+        auto const total = session.bytes_written();
+        auto const bytes = total - last_bytes;
+        last_bytes       = total;
+        auto cells       = ox::detail::Canvas::Diff{};
+        if (bytes != 0)
+            cells = ox::Terminal::screen_buffers().last_diff();
+        frames.push_back({bytes, std::move(cells)});
+        if (static_cast<int>(frames.size()) > frame_count)
+            session.exit(0);
+        else
+            step(*head, static_cast<int>(frames.size()) - 1);
+        // Same size, no repaint, only wakes the loop to process step's Events.
+        return esc::Window_resize{area};
+    };
+    auto session     = ox::Session{ox::Session_backend{-1, read, area}};
+    auto const scope = ox::Session_scope{&session};
+    ox::Terminal::set_run_compression(compress);
+    head = std::make_unique<Head_t>();
+    session.run(*head);
+    head.reset();
+    return frames;
+}
+
+/// Return per-frame bytes and the rewritten cells as spans of each row.
+auto frame_report(std::vector<Frame> const& frames) -> std::string
+{
+    auto os = std::ostringstream{};
+    for (auto i = std::size_t{0}; i < frames.size(); ++i) {
+        auto const& f = frames[i];
+        os << "frame " << i << ": " << f.bytes << " bytes, " << f.cells.size()
+           << " cells\n";
+        auto row = std::map<int, std::vector<int>>{};
+        for (auto const& [point, glyph] : f.cells)
+            row[point.y].push_back(point.x);
+        for (auto& [y, xs] : row) {
+            std::sort(std::begin(xs), std::end(xs));
+            os << "    row " << y << ':';
+            for (auto j = std::size_t{0}; j < xs.size();) {
+                auto k = j;
+                while (k + 1 < xs.size() && xs[k + 1] == xs[k] + 1)
+                    ++k;
+                os << ' ' << xs[j];
+                if (k != j)
+                    os << '-' << xs[k];
+                j = k + 1;
+            }
+            os << '\n';
+        }
+    }
+    return os.str();
+}
+
+/// Return the budgets file as a map of scenario name to total bytes.
+auto read_budgets() -> std::map<std::string, std::size_t>
+{
+    auto result = std::map<std::string, std::size_t>{};
+    auto file   = std::ifstream{TERMOX_OUTPUT_BUDGETS};
+    auto line   = std::string{};
+    while (std::getline(file, line)) {
+        if (line.empty() || line.front() == '#')
+            continue;
+        auto ss    = std::istringstream{line};
+        auto name  = std::string{};
+        auto bytes = std::size_t{0};
+        if (ss >> name >> bytes)
+            result[name] = bytes;
+    }
+    return result;
+}
+
+/// Replace the budget of \p name with \p bytes, keeping all others.
+void write_budget(std::string const& name, std::size_t bytes)
+{
+    auto budgets  = read_budgets();
+    budgets[name] = bytes;
+    auto file     = std::ofstream{TERMOX_OUTPUT_BUDGETS};
+    file << "# Maximum bytes written to an 80x24 terminal by each scenario\n"
+            "# in output_bytes.test.cpp.\n"
+            "# Regenerate with TERMOX_UPDATE_BUDGETS=1.\n";
+    for (auto const& [n, b] : budgets)
+        file << n << ' ' << b << '\n';
+}
+
+/// Return the bytes written over all of \p frames.
+auto total_bytes(std::vector<Frame> const& frames) -> std::size_t
+{
+    auto total = std::size_t{0};
+    for (auto const& f : frames)
+        total += f.bytes;
+    return total;
+}
+
+/// Fail if the total bytes of \p frames exceeds the budget for \p name.
+/** A scenario without a budget fails, unless TERMOX_UPDATE_BUDGETS is set. */
+void check_budget(std::string const& name, std::vector<Frame> const& frames)
+{
+    auto const total = total_bytes(frames);
+    if (std::getenv("TERMOX_UPDATE_BUDGETS") != nullptr) {
+        write_budget(name, total);
+        return;
+    }
+    auto const budgets = read_budgets();
+    auto const iter    = budgets.find(name);
+    if (iter == std::end(budgets)) {
+        FAIL(name << ": no budget recorded, " << total
+                  << " bytes written. Run with TERMOX_UPDATE_BUDGETS=1 to "
+                     "record it.");
+    }
+    INFO(name << ": " << total << " bytes, budget " << iter->second << '\n'
+              << frame_report(frames));
+    CHECK(total <= iter->second);
+}
+
+/// Titlebar, Textbox and a column of Checkboxes, like the layout demo.
+class Layout_scenario : public ox::layout::Vertical<> {
+   public:
+    ox::Titlebar& title = this->make_child<ox::Titlebar>(U"Output Bytes");
+    ox::layout::Horizontal<>& body =
+        this->make_child<ox::layout::Horizontal<>>();
+    ox::Textbox& text = body.make_child<ox::Textbox>(U"Scripted text.\n");
+    ox::layout::Vertical<ox::Checkbox1>& boxes =
+        body.make_child<ox::layout::Vertical<ox::Checkbox1>>();
+    ox::HLabel& status = this->make_child<ox::HLabel>(U"Ready");
+
+   public:
+    Layout_scenario()
+    {
+        using namespace ox::pipe;
+        status | fixed_height(1);
+        boxes | fixed_width(16);
+        for (auto i = 0; i < 8; ++i)
+            boxes.make_child();
+    }
+};
+
+/// Vertical column of Spinners, with a period long enough to never fire.
+class Spinner_scenario : public ox::layout::Vertical<ox::Spinner> {
+   public:
+    Spinner_scenario()
+    {
+        for (auto i = 0; i < 12; ++i) {
+            auto& s = this->make_child<ox::Spinner_cycle>();
+            s.set_width(1 + i % 3);
+            s.set_period(std::chrono::hours{1});
+            s.start();
+        }
+    }
+};
+
+/// Widget filled with underlined \p Symbol.
+template <char32_t Symbol>
+class Underlined_scenario : public ox::Widget {
+   public:
+    Underlined_scenario()
+    {
+        this->set_wallpaper(Symbol);
+        *this | ox::Trait::Underline;
+    }
+};
+
+/// Graph over a fixed Boundary, filled in by the scenario.
+class Graph_scenario : public ox::Graph<> {
+   public:
+    Graph_scenario() : ox::Graph<>{ox::Boundary<double>{0, 100, 100, 0}} {}
+};
+
+}  // namespace
+
+TEST_CASE("Output bytes: layout", "[Output]")
+{
+    auto const frames =
+        run_scenario<Layout_scenario>(24, [](Layout_scenario& app, int i) {
+            app.boxes.get_children()[i % 8].toggle();
+            app.status.set_text("Toggled " + std::to_string(i % 8));
+            if (i % 3 == 0) {
+                app.text.append("More text on frame " + std::to_string(i) +
+                                '\n');
+            }
+        });
+    check_budget("layout", frames);
+}
+
+TEST_CASE("Output bytes: Log tail", "[Output]")
+{
+    auto const frames = run_scenario<ox::Log>(60, [](ox::Log& log, int i) {
+        log.post_message("[info] request " + std::to_string(i) +
+                         " served in 12ms");
+    });
+    check_budget("log_tail", frames);
+}
+
+TEST_CASE("Output bytes: spinners", "[Output]")
+{
+    auto const frames =
+        run_scenario<Spinner_scenario>(40, [](Spinner_scenario& app, int) {
+            for (auto& s : app.get_children())
+                ox::System::send_event(ox::Timer_event{s});
+        });
+    check_budget("spinners", frames);
+}
+
+TEST_CASE("Output bytes: graph", "[Output]")
+{
+    auto const frames =
+        run_scenario<Graph_scenario>(50, [](Graph_scenario& graph, int i) {
+            graph.add({i * 2., 50. + (i % 10) * 4.});
+        });
+    check_budget("graph", frames);
+}
+
+TEST_CASE("Output bytes: run compression", "[Output]")
+{
+    auto const blank = [](bool compress) {
+        return run_scenario<ox::Widget>(1, [](ox::Widget&, int) {}, compress);
+    };
+    auto const layout = [](bool compress) {
+        return run_scenario<Layout_scenario>(
+            8,
+            [](Layout_scenario& app, int i) {
+                app.boxes.get_children()[i % 8].toggle();
+            },
+            compress);
+    };
+    auto const log_tail = [](bool compress) {
+        return run_scenario<ox::Log>(
+            20,
+            [](ox::Log& log, int i) {
+                log.post_message("[info] request " + std::to_string(i));
+            },
+            compress);
+    };
+
+    // A uniform screen is written as a single clear.
+    auto const blank_plain      = total_bytes(blank(false));
+    auto const blank_compressed = blank(true);
+    INFO("blank: " << blank_plain << " -> " << total_bytes(blank_compressed)
+                   << " bytes");
+    CHECK(total_bytes(blank_compressed) * 10 < blank_plain);
+    check_budget("blank_compressed", blank_compressed);
+
+    auto const layout_plain      = total_bytes(layout(false));
+    auto const layout_compressed = layout(true);
+    INFO("layout: " << layout_plain << " -> "
+                    << total_bytes(layout_compressed) << " bytes");
+    CHECK(total_bytes(layout_compressed) < layout_plain);
+    check_budget("layout_compressed", layout_compressed);
+
+    auto const log_plain      = total_bytes(log_tail(false));
+    auto const log_compressed = log_tail(true);
+    INFO("log_tail: " << log_plain << " -> " << total_bytes(log_compressed)
+                      << " bytes");
+    CHECK(total_bytes(log_compressed) < log_plain);
+    check_budget("log_tail_compressed", log_compressed);
+}
+
+TEST_CASE("Run compression writes blanks that have Traits", "[Output]")
+{
+    // Frame 1 rewrites every cell with the underline already set by frame 0.
+    // Erasing would drop the underline, so spaces are written like any Glyph.
+    auto const spaces = run_scenario<Underlined_scenario<U'.'>>(
+        1, [](ox::Widget& w, int) { w.set_wallpaper(U' '); }, true);
+    auto const dots = run_scenario<Underlined_scenario<U' '>>(
+        1, [](ox::Widget& w, int) { w.set_wallpaper(U'.'); }, true);
+    REQUIRE(spaces.size() == 2);
+    REQUIRE(dots.size() == 2);
+    CHECK(spaces[1].cells.size() == dots[1].cells.size());
+    CHECK(spaces[1].bytes == dots[1].bytes);
+}
+
+TEST_CASE("Run compression is off by default", "[Output]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr, area}};
+    auto const scope = ox::Session_scope{&session};
+    CHECK_FALSE(ox::Terminal::is_run_compression());
+}
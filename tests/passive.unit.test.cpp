@@ -0,0 +1,53 @@
+#include <functional>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/layouts/passive.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/pipe.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+auto constexpr area = ox::Area{8, 24};
+
+}  // namespace
+
+TEST_CASE("Passive tracks the sum of its children's hints", "[Passive]")
+{
+    auto steps       = std::vector<std::function<void()>>{};
+    auto session     = ox::Session{ox::test::frames(steps, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::layout::Vertical<>{};
+    auto& list       = head.make_child<ox::Passive<ox::layout::Vertical<>>>();
+    auto& a          = list.make_child() | ox::pipe::fixed_height(2);
+    auto& b          = list.make_child() | ox::pipe::fixed_height(3);
+    auto updates     = 0;
+    list.height_policy.policy_updated.connect([&] { ++updates; });
+
+    steps = {
+        [&] {
+            CHECK(list.height_policy == ox::Size_policy::fixed(5));
+            updates = 0;
+            a | ox::pipe::fixed_height(4);
+        },
+        [&] {
+            CHECK(list.height_policy == ox::Size_policy::fixed(7));
+            CHECK(updates == 1);
+            updates = 0;
+            a | ox::pipe::fixed_height(4);  // Same hint, sum is unchanged.
+        },
+        [&] {
+            CHECK(updates == 0);
+            list.remove_and_delete_child(&b);
+        },
+        [&] { CHECK(list.height_policy == ox::Size_policy::fixed(4)); },
+    };
+    session.run(head);
+}
@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <termox/system/event.hpp>
+#include <termox/system/profiler.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+
+namespace {
+
+/// Return the index of \p Event_t in ox::Event, as used by Profiler::record.
+template <typename Event_t>
+auto constexpr event_index = static_cast<std::uint8_t>(
+    ox::detail::Variant_index<Event_t, ox::Event>::value);
+
+auto constexpr paint = event_index<ox::Paint_event>;
+auto constexpr timer = event_index<ox::Timer_event>;
+
+}  // namespace
+
+TEST_CASE("Profiler accumulates per Widget and Event type", "[Profiler]")
+{
+    using namespace std::chrono_literals;
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto const now   = ox::Profiler::Clock_t::now();
+    ox::Profiler::record(3, "list", paint, now, 2ms, 40);
+    ox::Profiler::record(3, "list", paint, now, 6ms, 40);
+    ox::Profiler::record(3, "list", timer, now, 1ms, 0);
+    ox::Profiler::record(7, "graph", paint, now, 20ms, 400);
+
+    auto const entries = ox::Profiler::entries();
+    REQUIRE(entries.size() == 3);
+    CHECK(entries[0].widget_name == "graph");
+    CHECK(entries[1].widget_id == 3);
+    CHECK(entries[1].event == "Paint_event");
+    CHECK(entries[1].count == 2);
+    CHECK(entries[1].total == 8ms);
+    CHECK(entries[1].max == 6ms);
+    CHECK(entries[1].cells == 80);
+    CHECK(entries[2].event == "Timer_event");
+
+    ox::Profiler::clear();
+    CHECK(ox::Profiler::entries().empty());
+}
+
+TEST_CASE("Profiler exports a report and a Chrome trace", "[Profiler]")
+{
+    using namespace std::chrono_literals;
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    ox::Profiler::record(5, "say \"hi\"", paint, ox::Profiler::Clock_t::now(),
+                         1500us, 12);
+
+    auto report = std::ostringstream{};
+    ox::Profiler::write_report(report);
+    CHECK(report.str().find("1.500") != std::string::npos);
+    CHECK(report.str().find("say \"hi\" #5") != std::string::npos);
+
+    auto trace = std::ostringstream{};
+    ox::Profiler::write_chrome_trace(trace);
+    auto const json = trace.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"Paint_event\"") != std::string::npos);
+    CHECK(json.find("\"dur\":1500.000") != std::string::npos);
+    CHECK(json.find("\"widget\":\"say \\\"hi\\\"\"") != std::string::npos);
+}
+
+TEST_CASE("Profiler data belongs to the current Session", "[Profiler]")
+{
+    using namespace std::chrono_literals;
+    auto session = ox::Session{ox::Session_backend{-1, nullptr}};
+    {
+        auto const scope = ox::Session_scope{&session};
+        ox::Profiler::record(1, "a", paint, ox::Profiler::Clock_t::now(), 1ms,
+                             1);
+    }
+    auto other       = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&other};
+    CHECK(ox::Profiler::entries().empty());
+}
@@ -0,0 +1,49 @@
+#include <catch2/catch.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/rect.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+[[nodiscard]] auto equal(ox::Rect a, ox::Rect b) -> bool
+{
+    return a.top_left.x == b.top_left.x && a.top_left.y == b.top_left.y &&
+           a.area.width == b.area.width && a.area.height == b.area.height;
+}
+
+}  // namespace
+
+TEST_CASE("Rect intersection and bounding", "[Rect]")
+{
+    auto const a = ox::Rect{{1, 1}, {3, 2}};
+    auto const b = ox::Rect{{2, 0}, {5, 2}};
+    CHECK(equal(ox::intersection(a, b), {{2, 1}, {2, 1}}));
+    CHECK(equal(ox::bounding(a, b), {{1, 0}, {6, 3}}));
+    CHECK(ox::is_empty(ox::intersection(a, {{4, 1}, {1, 1}})));
+    CHECK(equal(ox::bounding(a, {}), a));
+    CHECK(ox::contains(a, {3, 2}));
+    CHECK_FALSE(ox::contains(a, {4, 2}));
+}
+
+TEST_CASE("Widget::update(Rect) accumulates damage", "[Rect]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto w           = ox::Widget{};
+    w.set_area({10, 5});
+    CHECK(equal(w.damage(), {{0, 0}, {10, 5}}));
+
+    w.update({{2, 1}, {1, 1}});
+    w.update({{4, 3}, {20, 1}});
+    CHECK(equal(w.damage(), {{2, 1}, {8, 3}}));
+
+    w.update();
+    w.update({{0, 0}, {1, 1}});
+    CHECK(equal(w.damage(), {{0, 0}, {10, 5}}));
+
+    w.clear_damage();
+    w.update({{-3, -3}, {4, 4}});
+    CHECK(equal(w.damage(), {{0, 0}, {1, 1}}));
+}
@@ -0,0 +1,68 @@
+#include <catch2/catch.hpp>
+
+#include <termox/painter/glyph.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/terminal/detail/canvas.hpp>
+#include <termox/terminal/detail/screen_buffers.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+/// Fill every cell of \p c with \p g.
+void fill(ox::detail::Canvas& c, ox::Glyph g)
+{
+    for (auto& x : c)
+        x = g;
+}
+
+/// compose(), merge_and_diff() and reset next, as Terminal::refresh() does.
+[[nodiscard]] auto refresh(ox::detail::Screen_buffers& b)
+    -> ox::detail::Canvas::Diff
+{
+    b.compose();
+    auto diff = b.merge_and_diff();
+    b.next.reset();
+    return diff;
+}
+
+}  // namespace
+
+TEST_CASE("Overlay layers are composited above the base", "[Screen_buffers]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto popup       = ox::Widget{};
+    auto b           = ox::detail::Screen_buffers{{4, 2}};
+    auto const a     = ox::Glyph{U'a'};
+    auto const x     = ox::Glyph{U'x'};
+    auto const y     = ox::Glyph{U'y'};
+
+    fill(b.next, a);
+    CHECK(refresh(b).size() == 8);
+
+    b.show_layer(popup, 0, {{1, 0}, {2, 1}});
+    auto& layer = b.canvas_for(popup);
+    CHECK(&layer != &b.next);
+    layer.at({1, 0}) = x;
+    layer.at({2, 0}) = x;
+    auto diff = refresh(b);
+    REQUIRE(diff.size() == 2);
+    CHECK(diff[0].second == x);
+    CHECK(b.layer_at({2, 0}) == &popup);
+    CHECK(b.layer_at({3, 0}) == nullptr);
+
+    // Base repaint beneath the popup is saved, but not shown.
+    fill(b.next, y);
+    diff = refresh(b);
+    CHECK(diff.size() == 6);
+    CHECK(b.current.at({1, 0}) == x);
+
+    // Hiding recomposites the saved base cells, with no base repaint.
+    b.hide_layer(popup);
+    diff = refresh(b);
+    REQUIRE(diff.size() == 2);
+    CHECK(b.current.at({1, 0}) == y);
+    CHECK(b.current.at({2, 0}) == y);
+    CHECK(&b.canvas_for(popup) == &b.next);
+}
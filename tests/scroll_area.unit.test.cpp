@@ -0,0 +1,88 @@
+#include <functional>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/detail/is_paintable.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/pipe.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/rect.hpp>
+#include <termox/widget/scroll_area.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+auto constexpr area = ox::Area{8, 4};
+
+[[nodiscard]] auto equal(ox::Rect a, ox::Rect b) -> bool
+{
+    return a.top_left.x == b.top_left.x && a.top_left.y == b.top_left.y &&
+           a.area.width == b.area.width && a.area.height == b.area.height;
+}
+
+}  // namespace
+
+TEST_CASE("Scroll_area clips content to the viewport", "[Scroll_area]")
+{
+    using ox::detail::is_paintable;
+    using ox::detail::visible_region;
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head = ox::Scroll_area<ox::layout::Vertical<>>{ox::Area{8, 20}};
+    auto& top = head.wrapped.make_child() | ox::pipe::fixed_height(3);
+    auto& mid = head.wrapped.make_child() | ox::pipe::fixed_height(3);
+    auto& low = head.wrapped.make_child() | ox::pipe::fixed_height(14);
+    REQUIRE(head.wrapped.parent() == &head);
+
+    check = [&] {
+        CHECK(head.wrapped.area() == ox::Area{8, 20});
+        CHECK(mid.top_left() == ox::Point{0, 3});
+        CHECK(equal(visible_region(top), {{0, 0}, {8, 3}}));
+        CHECK(equal(visible_region(mid), {{0, 0}, {8, 1}}));
+        CHECK(is_paintable(mid));
+        CHECK(!is_paintable(low));
+        CHECK(equal(visible_region(head.wrapped), {{0, 0}, area}));
+    };
+    session.run(head);
+}
+
+TEST_CASE("Scroll_area moves content by the clamped offset", "[Scroll_area]")
+{
+    using ox::detail::is_paintable;
+    using ox::detail::visible_region;
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head = ox::Scroll_area<ox::layout::Vertical<>>{ox::Area{8, 20}};
+    auto& top = head.wrapped.make_child() | ox::pipe::fixed_height(3);
+    auto& low = head.wrapped.make_child() | ox::pipe::fixed_height(17);
+    head.set_offset({0, 100});
+
+    check = [&] {
+        CHECK(head.offset() == ox::Point{0, 16});
+        CHECK(head.wrapped.top_left() == ox::Point{0, -16});
+        CHECK(!is_paintable(top));
+        CHECK(equal(visible_region(low), {{0, 13}, {8, 4}}));
+    };
+    session.run(head);
+}
+
+TEST_CASE("Scroll_area::scrolled is emitted on each change", "[Scroll_area]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Scroll_area<ox::Widget>{ox::Area{8, 20}};
+    auto count       = 0;
+    head.scrolled.connect([&](ox::Point) { ++count; });
+    head.scroll_down(5);
+    head.scroll_up(10);
+    head.scroll_left();
+    CHECK(head.offset() == ox::Point{0, 0});
+    CHECK(count == 2);
+}
@@ -0,0 +1,78 @@
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/detail/widget_index.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/pipe.hpp>
+#include <termox/widget/select.hpp>
+#include <termox/widget/widget.hpp>
+#include <termox/widget/widgets/label.hpp>
+
+TEST_CASE("select() resolves names, types and descendants", "[select]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto root        = ox::layout::Vertical<>{};
+    auto& status     = root.make_child<ox::layout::Vertical<>>()
+                   | ox::pipe::name("status");
+    auto& inner = status.make_child<ox::HLabel>();
+    auto& outer = root.make_child<ox::HLabel>() | ox::pipe::name("title");
+
+    auto const labels = ox::select(root, "Label");
+    CHECK(labels.size() == 2);
+    CHECK(ox::select(root, "#status Label") ==
+          std::vector<ox::Widget*>{&inner});
+    CHECK(ox::select(root, "Label#title") == std::vector<ox::Widget*>{&outer});
+    CHECK(ox::select(status, "#title").empty());
+    CHECK(ox::select(root, "Linear_layout#status").size() == 1);
+
+    inner.set_name("renamed");
+    CHECK(ox::select(root, "#renamed") == std::vector<ox::Widget*>{&inner});
+    auto removed = root.remove_child(&outer);
+    removed.reset();
+    CHECK(ox::select(root, "Label") == std::vector<ox::Widget*>{&inner});
+}
+
+TEST_CASE("Widget_index only returns Widgets of the current Session",
+          "[select]")
+{
+    auto first  = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto second = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const make_label = [](ox::Session& s) {
+        auto const scope = ox::Session_scope{&s};
+        auto label       = std::make_unique<ox::HLabel>();
+        label->set_name("shared");
+        return label;
+    };
+    auto a = make_label(first);
+    auto b = make_label(second);
+
+    using ox::detail::Widget_index;
+    {
+        auto const scope = ox::Session_scope{&first};
+        CHECK(Widget_index::with_name("shared") ==
+              std::vector<ox::Widget*>{a.get()});
+        a.reset();
+        CHECK(Widget_index::with_name("shared").empty());
+    }
+    auto const scope = ox::Session_scope{&second};
+    CHECK(Widget_index::with_name("shared") ==
+          std::vector<ox::Widget*>{b.get()});
+    b.reset();
+    CHECK(Widget_index::with_name("shared").empty());
+    CHECK(Widget_index::with_name("missing").empty());
+}
+
+TEST_CASE("select() rejects malformed selectors", "[select]")
+{
+    auto const w = ox::Widget{};
+    CHECK_THROWS_AS(ox::select(w, ""), std::invalid_argument);
+    CHECK_THROWS_AS(ox::select(w, "  "), std::invalid_argument);
+    CHECK_THROWS_AS(ox::select(w, "Label#"), std::invalid_argument);
+    CHECK_THROWS_AS(ox::select(w, "#a#b"), std::invalid_argument);
+}
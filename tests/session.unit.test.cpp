@@ -0,0 +1,68 @@
+#include <string>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/color.hpp>
+#include <termox/system/key.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/system/shortcuts.hpp>
+#include <termox/terminal/terminal.hpp>
+
+TEST_CASE("Session_scope selects the current Session", "[Session]")
+{
+    auto& fallback = ox::Session::default_session();
+    CHECK(&ox::Session::current() == &fallback);
+    CHECK(fallback.is_default());
+
+    auto session = ox::Session{};
+    CHECK_FALSE(session.is_default());
+    {
+        auto const scope = ox::Session_scope{&session};
+        CHECK(&ox::Session::current() == &session);
+        {
+            auto const inner = ox::Session_scope{nullptr};
+            CHECK(&ox::Session::current() == &fallback);
+        }
+        CHECK(&ox::Session::current() == &session);
+    }
+    CHECK(&ox::Session::current() == &fallback);
+}
+
+TEST_CASE("Session state is independent", "[Session]")
+{
+    auto session = ox::Session{};
+    auto called  = false;
+    {
+        auto const scope = ox::Session_scope{&session};
+        ox::Terminal::set_palette({{ox::Color{0}, ox::Color_index{4}}});
+        CHECK_FALSE(ox::Shortcuts::send_key(ox::Key::a));
+        ox::Shortcuts::add_shortcut(ox::Key::a).connect([&] { called = true; });
+        CHECK(ox::Shortcuts::send_key(ox::Key::a));
+        CHECK(called);
+    }
+    CHECK_FALSE(ox::Shortcuts::send_key(ox::Key::a));
+    CHECK(ox::Terminal::current_palette().empty());
+    {
+        auto const scope = ox::Session_scope{&session};
+        CHECK(ox::Terminal::current_palette().size() == 1);
+    }
+}
+
+TEST_CASE("Session writes to its output_fd", "[Session]")
+{
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    auto session = ox::Session{ox::Session_backend{fds[1], nullptr}};
+    {
+        auto const scope = ox::Session_scope{&session};
+        ox::Terminal::move_cursor({2, 1});
+    }
+    char buffer[32];
+    auto const n = ::read(fds[0], buffer, sizeof(buffer));
+    CHECK(std::string(buffer, n) == "\033[2;3H");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,130 @@
+#include <termox/common/small_vector.hpp>
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/glyph_string.hpp>
+
+namespace {
+
+using Vec = ox::Small_vector<int, 4>;
+
+[[nodiscard]] auto is_inline(Vec const& v) -> bool
+{
+    auto const* const begin = reinterpret_cast<unsigned char const*>(&v);
+    auto const* const data  = reinterpret_cast<unsigned char const*>(v.data());
+    return data >= begin && data < begin + sizeof(v);
+}
+
+[[nodiscard]] auto iota(int count) -> std::vector<int>
+{
+    auto result = std::vector<int>(count);
+    std::iota(std::begin(result), std::end(result), 0);
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Small_vector stays inline up to N", "[Small_vector]")
+{
+    auto v = Vec{};
+    CHECK(v.empty());
+    CHECK(v.capacity() == 4);
+    for (int i = 0; i < 4; ++i)
+        v.push_back(i);
+    CHECK(is_inline(v));
+    CHECK(v.size() == 4);
+    CHECK(v.back() == 3);
+
+    v.push_back(4);
+    CHECK(!is_inline(v));
+    CHECK(v.capacity() >= 5);
+    CHECK(std::vector<int>(v.begin(), v.end()) == iota(5));
+
+    v.pop_back();
+    v.shrink_to_fit();
+    CHECK(is_inline(v));
+    CHECK(std::vector<int>(v.begin(), v.end()) == iota(4));
+}
+
+TEST_CASE("Small_vector insert and erase", "[Small_vector]")
+{
+    auto v = Vec{0, 1, 4};
+    auto const at = v.insert(v.begin() + 2, {2, 3});
+    CHECK(*at == 2);
+    CHECK(std::vector<int>(v.begin(), v.end()) == iota(5));
+
+    v.insert(v.begin(), 3, 9);
+    CHECK(v.size() == 8);
+    CHECK(v[2] == 9);
+    CHECK(v[3] == 0);
+
+    v.erase(v.begin(), v.begin() + 3);
+    CHECK(std::vector<int>(v.begin(), v.end()) == iota(5));
+
+    // Inserting an element of itself while reallocating.
+    auto w = Vec{7, 8, 9, 10};
+    w.insert(w.begin(), w.back());
+    w.push_back(w.front());
+    CHECK(std::vector<int>(w.begin(), w.end()) ==
+          std::vector<int>{10, 7, 8, 9, 10, 10});
+
+    // Inserting a range of itself, with and without reallocating.
+    auto x = Vec{1, 2, 3};
+    x.insert(x.begin(), x.begin() + 1, x.end());
+    CHECK(std::vector<int>(x.begin(), x.end()) ==
+          std::vector<int>{2, 3, 1, 2, 3});
+    x.insert(x.begin() + 1, x.begin(), x.end());
+    CHECK(std::vector<int>(x.begin(), x.end()) ==
+          std::vector<int>{2, 2, 3, 1, 2, 3, 3, 1, 2, 3});
+    x.assign(x.begin() + 2, x.begin() + 5);
+    CHECK(std::vector<int>(x.begin(), x.end()) == std::vector<int>{3, 1, 2});
+    x.insert(x.begin(), x.begin() + 1, x.end());
+    CHECK(std::vector<int>(x.begin(), x.end()) ==
+          std::vector<int>{1, 2, 3, 1, 2});
+
+    v.resize(2);
+    CHECK(v.size() == 2);
+    v.resize(4, 5);
+    CHECK(v[3] == 5);
+    CHECK_THROWS_AS(v.at(4), std::out_of_range);
+}
+
+TEST_CASE("Small_vector copy, move and swap", "[Small_vector]")
+{
+    auto small = Vec{1, 2};
+    auto large = Vec{1, 2, 3, 4, 5, 6};
+
+    auto copy = large;
+    CHECK(std::vector<int>(copy.begin(), copy.end()) ==
+          std::vector<int>(large.begin(), large.end()));
+    CHECK(copy.data() != large.data());
+
+    auto const* const heap = large.data();
+    auto moved             = std::move(large);
+    CHECK(moved.data() == heap);
+    CHECK(large.empty());
+    CHECK(is_inline(large));
+
+    auto moved_small = std::move(small);
+    CHECK(is_inline(moved_small));
+    CHECK(moved_small.size() == 2);
+
+    moved_small.swap(moved);
+    CHECK(moved_small.size() == 6);
+    CHECK(moved.size() == 2);
+    CHECK(is_inline(moved));
+}
+
+TEST_CASE("Short Glyph_strings are held inline", "[Small_vector]")
+{
+    auto const label = ox::Glyph_string{U"Fifteen glyphs!"};
+    auto const* const begin = reinterpret_cast<unsigned char const*>(&label);
+    auto const* const data =
+        reinterpret_cast<unsigned char const*>(label.data());
+    CHECK(label.size() == 15);
+    CHECK((data >= begin && data < begin + sizeof(label)));
+}
@@ -0,0 +1,94 @@
+#include <memory>
+
+#include <catch2/catch.hpp>
+
+#include <termox/common/fps.hpp>
+#include <termox/system/animation_engine.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/system/system.hpp>
+#include <termox/widget/layouts/stack.hpp>
+#include <termox/widget/widget.hpp>
+
+namespace {
+
+using Stack = ox::layout::Stack<>;
+
+/// Page_factory that counts how many pages it has built.
+[[nodiscard]] auto counting_factory(int& count) -> Stack::Page_factory
+{
+    return [&count] {
+        ++count;
+        return std::make_unique<ox::Widget>();
+    };
+}
+
+}  // namespace
+
+TEST_CASE("Lazy pages are built on first activation", "[Stack]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto stack       = Stack{};
+    auto built_a     = 0;
+    auto built_b     = 0;
+    stack.append_lazy_page(counting_factory(built_a));
+    stack.append_lazy_page(counting_factory(built_b));
+    REQUIRE(stack.size() == 2);
+    CHECK(!stack.is_built(0));
+    CHECK(!stack.is_built(1));
+
+    stack.set_active_page(1);
+    CHECK(built_a == 0);
+    CHECK(built_b == 1);
+    CHECK(stack.is_built(1));
+    CHECK(stack.get_active_page() == &stack.get_children()[1]);
+
+    stack.set_active_page(0);
+    stack.set_active_page(1);
+    CHECK(built_a == 1);
+    CHECK(built_b == 1);
+}
+
+TEST_CASE("Hibernation::Destroy rebuilds lazy pages", "[Stack]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto stack       = Stack{};
+    auto built       = 0;
+    auto built_index = Stack::invalid_index;
+    stack.set_hibernation(Stack::Hibernation::Destroy);
+    stack.page_built.connect(
+        [&](std::size_t i, ox::Widget&) { built_index = i; });
+    stack.append_lazy_page(counting_factory(built));
+    stack.make_page();
+
+    stack.set_active_page(0);
+    CHECK(built_index == 0);
+    stack.set_active_page(1);
+    CHECK(!stack.is_built(0));
+    stack.set_active_page(0);
+    CHECK(built == 2);
+    CHECK(stack.is_built(1));
+}
+
+TEST_CASE("Pages suspended before a policy change are woken", "[Stack]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    auto stack       = Stack{};
+    auto& page       = stack.make_page();
+    stack.make_page();
+    auto& engine = ox::System::animation_engine();
+    engine.register_widget(page, ox::FPS{10});
+
+    stack.set_hibernation(Stack::Hibernation::Suspend);
+    stack.set_active_page(0);
+    stack.set_active_page(1);
+    CHECK(engine.is_empty());
+
+    stack.set_hibernation(Stack::Hibernation::None);
+    stack.set_active_page(0);
+    CHECK(!engine.is_empty());
+    engine.unregister_widget(page);
+}
@@ -0,0 +1,74 @@
+#include <functional>
+
+#include <catch2/catch.hpp>
+
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/layouts/detail/static_geometry.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/pipe.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/tuple.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+using ox::layout::detail::Length_limits;
+using ox::layout::detail::static_lengths;
+
+auto constexpr area = ox::Area{10, 20};
+
+/// Laid out by Static_geometry.
+using Panel = ox::Tuple<ox::layout::Vertical<>, ox::Widget, ox::Widget>;
+
+}  // namespace
+
+TEST_CASE("static_lengths handles fixed and one flexible child",
+          "[Static_geometry]")
+{
+    auto constexpr fixed = Length_limits{3, 3, 3};
+    auto constexpr flex  = Length_limits{1, 2, 8};
+
+    auto constexpr all_fixed = static_lengths<2>({fixed, fixed}, 10);
+    STATIC_REQUIRE(all_fixed.has_value());
+    STATIC_REQUIRE((*all_fixed)[1] == 3);
+
+    auto constexpr stretched = static_lengths<3>({fixed, flex, fixed}, 10);
+    STATIC_REQUIRE(stretched.has_value());
+    STATIC_REQUIRE((*stretched)[1] == 4);
+
+    auto constexpr capped = static_lengths<2>({fixed, flex}, 20);
+    STATIC_REQUIRE(capped.has_value());
+    STATIC_REQUIRE((*capped)[1] == 8);
+
+    STATIC_REQUIRE(!static_lengths<2>({fixed, fixed}, 5).has_value());
+    STATIC_REQUIRE(!static_lengths<2>({flex, flex}, 20).has_value());
+    STATIC_REQUIRE(!static_lengths<2>({fixed, flex}, 3).has_value());
+}
+
+TEST_CASE("Static_geometry matches the general layout", "[Static_geometry]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head =
+        ox::Tuple<ox::layout::Vertical<>, Panel, ox::layout::Vertical<>>{};
+    auto& fast    = head.get<0>() | ox::pipe::fixed_height(10);
+    auto& general = head.get<1>() | ox::pipe::fixed_height(10);
+    auto& g0      = general.make_child();
+    auto& g1      = general.make_child();
+    fast.get<0>() | ox::pipe::fixed_height(3) | ox::pipe::fixed_width(4);
+    g0 | ox::pipe::fixed_height(3) | ox::pipe::fixed_width(4);
+
+    check = [&] {
+        CHECK(fast.get<0>().area() == g0.area());
+        CHECK(fast.get<1>().area() == g1.area());
+        CHECK(fast.get<1>().area() == ox::Area{10, 7});
+        CHECK(fast.get<1>().top_left() == ox::Point{0, 3});
+        CHECK(g1.top_left() == ox::Point{0, 13});
+    };
+    session.run(head);
+}
@@ -0,0 +1,117 @@
+#include <functional>
+#include <memory>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/brush.hpp>
+#include <termox/painter/color.hpp>
+#include <termox/painter/styles.hpp>
+#include <termox/painter/trait.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/layouts/vertical.hpp>
+#include <termox/widget/pipe.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+auto constexpr area = ox::Area{8, 4};
+
+/// Widget that counts calls to update().
+class Counted : public ox::Widget {
+   public:
+    int updates = 0;
+
+   public:
+    void update() override
+    {
+        ++updates;
+        Widget::update();
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Style classes are inherited along the Widget tree", "[Styles]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    ox::Styles::set("panel",
+                    ox::Brush{ox::bg(ox::Color::Blue), ox::Trait::Bold});
+    ox::Styles::set("accent", ox::Brush{ox::fg(ox::Color::Red)});
+
+    auto head = ox::layout::Vertical<>{};
+    head.set_style_class("panel");
+    auto& plain  = head.make_child();
+    auto& accent = head.make_child() | ox::pipe::style_class("accent");
+    accent.brush.background = ox::Color::Green;
+
+    CHECK(plain.effective_brush() ==
+          ox::Brush{ox::bg(ox::Color::Blue), ox::Trait::Bold});
+    CHECK(accent.effective_brush() ==
+          ox::Brush{ox::bg(ox::Color::Green), ox::fg(ox::Color::Red),
+                    ox::Trait::Bold});
+
+    auto const w = ox::Widget{};
+    CHECK(w.effective_brush() == ox::Brush{});
+    CHECK(ox::Styles::get("missing") == ox::Brush{});
+}
+
+TEST_CASE("A theme switch repaints only Widgets whose style changed",
+          "[Styles]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    ox::Styles::set_theme({{"panel", ox::Brush{ox::bg(ox::Color::Blue)}},
+                           {"accent", ox::Brush{ox::fg(ox::Color::Red)}}});
+
+    auto head = ox::layout::Vertical<>{};
+    head.set_style_class("panel");
+    auto& plain  = head.make_child<Counted>();
+    auto& accent = head.make_child<Counted>();
+    accent.set_style_class("accent");
+    auto& own = head.make_child<Counted>();
+    own.brush.background = ox::Color::Green;
+
+    check = [&] {
+        for (auto* w : {&plain, &accent, &own})
+            (void)w->effective_brush();
+        plain.updates  = 0;
+        accent.updates = 0;
+        own.updates    = 0;
+        ox::Styles::set_theme(
+            {{"panel", ox::Brush{ox::bg(ox::Color::Blue)}},
+             {"accent", ox::Brush{ox::fg(ox::Color::Yellow)}}});
+        CHECK(plain.updates == 0);
+        CHECK(accent.updates == 1);
+        CHECK(own.updates == 0);
+        CHECK(accent.effective_brush().foreground == ox::Color::Yellow);
+
+        ox::Styles::set("panel", ox::Brush{ox::bg(ox::Color::Violet)});
+        CHECK(plain.updates == 1);
+        CHECK(accent.updates == 2);
+        CHECK(own.updates == 0);
+        CHECK(plain.effective_brush().background == ox::Color::Violet);
+    };
+    session.run(head);
+}
+
+TEST_CASE("A new parent drops the resolved style", "[Styles]")
+{
+    auto session     = ox::Session{ox::Session_backend{-1, nullptr}};
+    auto const scope = ox::Session_scope{&session};
+    ox::Styles::set("panel", ox::Brush{ox::bg(ox::Color::Blue)});
+
+    auto head  = ox::layout::Vertical<>{};
+    auto child = std::make_unique<ox::Widget>();
+    auto* ptr  = child.get();
+    CHECK(ptr->effective_brush().background == ox::Color::Background);
+
+    head.set_style_class("panel");
+    head.append_child(std::move(child));
+    CHECK(ptr->effective_brush().background == ox::Color::Blue);
+}
@@ -0,0 +1,151 @@
+#include <termox/system/task.hpp>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include <signals_light/signal.hpp>
+
+#include <termox/common/worker_pool.hpp>
+#include <termox/system/session.hpp>
+#include <termox/system/session_scope.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/widget.hpp>
+
+#include "headless.hpp"
+
+namespace {
+
+auto constexpr area    = ox::Area{10, 20};
+auto constexpr timeout = std::chrono::seconds{5};
+
+auto throws() -> ox::Task
+{
+    throw std::runtime_error{"thrown"};
+    co_return;
+}
+
+auto awaits_throws(std::string& caught) -> ox::Task
+{
+    try {
+        co_await throws();
+    }
+    catch (std::runtime_error const& e) {
+        caught = e.what();
+    }
+}
+
+auto sleeps(std::promise<std::chrono::nanoseconds>& done)
+    -> ox::Task
+{
+    auto const begin = std::chrono::steady_clock::now();
+    co_await ox::sleep_for(std::chrono::milliseconds{20});
+    done.set_value(std::chrono::steady_clock::now() - begin);
+}
+
+auto counts_frames(int& frames, std::promise<void>& done)
+    -> ox::Task
+{
+    while (frames < 3) {
+        co_await ox::next_frame();
+        ++frames;
+    }
+    done.set_value();
+}
+
+auto waits_on(sl::Signal<void(int, char)>& signal,
+                            int& received) -> ox::Task
+{
+    auto const [i, c] = co_await ox::on(signal);
+    received          = i + c;
+}
+
+auto works(ox::Worker_pool& pool, std::promise<int>& done)
+    -> ox::Task
+{
+    auto const id = std::this_thread::get_id();
+    auto const x  = co_await ox::in_pool(pool, [id] {
+        return std::this_thread::get_id() == id ? 0 : 42;
+    });
+    done.set_value(x);
+}
+
+}  // namespace
+
+TEST_CASE("Awaiting a Task rethrows its exception", "[Task]")
+{
+    auto caught = std::string{};
+    auto const task = awaits_throws(caught);
+    CHECK(task.is_done());
+    CHECK(caught == "thrown");
+}
+
+TEST_CASE("sleep_for and next_frame resume from the animation loop",
+          "[Task]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+
+    check = [&] {
+        auto slept      = std::promise<std::chrono::nanoseconds>{};
+        auto const task = sleeps(slept);
+        auto result     = slept.get_future();
+        REQUIRE(result.wait_for(timeout) == std::future_status::ready);
+        CHECK(result.get() >= std::chrono::milliseconds{20});
+
+        auto frames          = 0;
+        auto counted         = std::promise<void>{};
+        auto const begin     = std::chrono::steady_clock::now();
+        auto const frame_loop = counts_frames(frames, counted);
+        auto done            = counted.get_future();
+        REQUIRE(done.wait_for(timeout) == std::future_status::ready);
+        CHECK(std::chrono::steady_clock::now() - begin >=
+              2 * ox::Animation_engine::frame_period);
+    };
+    session.run(head);
+}
+
+TEST_CASE("on resumes with the arguments of a single emission", "[Task]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+    auto signal      = sl::Signal<void(int, char)>{};
+    auto received    = 0;
+
+    check = [&] {
+        // Resumed by the Custom_event it posts, after check returns.
+        waits_on(signal, received);
+        signal(1, 'a');
+        signal(2, 'b');
+    };
+    session.run(head);
+    CHECK(received == 1 + 'a');
+}
+
+TEST_CASE("in_pool resumes with the result of work on another thread",
+          "[Task]")
+{
+    auto check       = std::function<void()>{};
+    auto session     = ox::Session{ox::test::first_frame(check, area)};
+    auto const scope = ox::Session_scope{&session};
+    auto head        = ox::Widget{};
+    auto pool        = ox::Worker_pool{2};
+
+    check = [&] {
+        auto worked     = std::promise<int>{};
+        auto const task = works(pool, worked);
+        auto result     = worked.get_future();
+        REQUIRE(result.wait_for(timeout) == std::future_status::ready);
+        CHECK(result.get() == 42);
+    };
+    session.run(head);
+}
@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include <termox/widget/area.hpp>
+#include <termox/widget/widgets/detail/vt_parser.hpp>
+#include <termox/widget/widgets/detail/vt_screen.hpp>
+
+// Measures Vt_parser throughput on fast scrolling output, such as a build log
+// or tail -f, and on a full screen application redrawing with cursor moves.
+
+namespace {
+
+using Clock_t = std::chrono::steady_clock;
+
+auto constexpr area      = ox::Area{160, 50};
+auto constexpr total_mb  = 1'000;
+auto constexpr chunk_max = 64 * 1'024;
+
+/// Return colored compiler-style log lines, about \p size bytes.
+auto build_log(std::size_t size) -> std::string
+{
+    auto result = std::string{};
+    for (auto i = 0; result.size() < size; ++i) {
+        result.append("\033[1m/src/widget/widgets/detail/vt_screen.cpp:")
+            .append(std::to_string(i))
+            .append(":17: \033[35mwarning:\033[0m unused variable ‘x’\r\n");
+    }
+    return result;
+}
+
+/// Return htop-style redraws: positioned, colored cells and erases.
+auto redraws(std::size_t size) -> std::string
+{
+    auto result = std::string{};
+    for (auto i = 0; result.size() < size; ++i) {
+        auto const y = i % area.height + 1;
+        result.append("\033[")
+            .append(std::to_string(y))
+            .append(";1H\033[38;5;")
+            .append(std::to_string(i % 256))
+            .append("m  PID USER      PRI  NI  VIRT   RES ")
+            .append("\033[48;2;30;30;")
+            .append(std::to_string(i % 256))
+            .append("m█████▒▒▒░░░\033[0m\033[K");
+    }
+    return result;
+}
+
+void run(char const* name, std::string const& chunk)
+{
+    auto screen = ox::detail::Vt_screen{area};
+    auto parser = ox::detail::Vt_parser{};
+    auto const iterations =
+        total_mb * std::size_t{1'000'000} / chunk.size() + 1;
+    auto const begin = Clock_t::now();
+    for (auto i = std::size_t{0}; i < iterations; ++i)
+        parser.parse(chunk, screen);
+    auto const seconds =
+        std::chrono::duration<double>(Clock_t::now() - begin).count();
+    std::cout << name << ": "
+              << (iterations * chunk.size()) / seconds / 1'000'000.
+              << " MB/s\n";
+}
+
+}  // namespace
+
+int main()
+{
+    run("scrolling build log", build_log(chunk_max));
+    run("full screen redraws", redraws(chunk_max));
+}
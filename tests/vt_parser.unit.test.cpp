@@ -0,0 +1,143 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch.hpp>
+
+#include <termox/painter/color.hpp>
+#include <termox/painter/glyph.hpp>
+#include <termox/painter/palette/basic.hpp>
+#include <termox/painter/trait.hpp>
+#include <termox/terminal/detail/color_quantizer.hpp>
+#include <termox/widget/area.hpp>
+#include <termox/widget/point.hpp>
+#include <termox/widget/widgets/detail/vt_parser.hpp>
+#include <termox/widget/widgets/detail/vt_screen.hpp>
+
+namespace {
+
+/// Return row \p y of \p screen as a string of its symbols.
+auto row(ox::detail::Vt_screen const& screen, int y) -> std::u32string
+{
+    auto result = std::u32string{};
+    for (auto x = 0; x < screen.area().width; ++x)
+        result.push_back(screen.at({x, y}).symbol);
+    return result;
+}
+
+/// Parse \p bytes one byte at a time, as if each arrived in its own read.
+void parse_bytewise(ox::detail::Vt_parser& parser,
+                    std::string_view bytes,
+                    ox::detail::Vt_screen& screen)
+{
+    for (auto i = std::size_t{0}; i < bytes.size(); ++i)
+        parser.parse(bytes.substr(i, 1), screen);
+}
+
+}  // namespace
+
+TEST_CASE("Vt_parser prints, wraps and scrolls", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{4, 2}};
+    auto parser = ox::detail::Vt_parser{};
+    parser.parse("abcdef", screen);
+    CHECK(row(screen, 0) == U"abcd");
+    CHECK(row(screen, 1) == U"ef  ");
+    CHECK(screen.cursor() == ox::Point{2, 1});
+
+    parser.parse("\r\nxy", screen);
+    CHECK(row(screen, 0) == U"ef  ");
+    CHECK(row(screen, 1) == U"xy  ");
+}
+
+TEST_CASE("Vt_parser cursor movement and erase", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{5, 3}};
+    auto parser = ox::detail::Vt_parser{};
+    parser.parse("11111\r\n22222\r\n33333", screen);
+    parser.parse("\033[2;3H\033[K", screen);
+    CHECK(row(screen, 1) == U"22   ");
+    parser.parse("\033[1J", screen);
+    CHECK(row(screen, 0) == U"     ");
+    CHECK(row(screen, 1) == U"     ");
+    CHECK(row(screen, 2) == U"33333");
+    parser.parse("\033[3;2H\033[2P", screen);
+    CHECK(row(screen, 2) == U"333  ");
+}
+
+TEST_CASE("Vt_parser graphic rendition", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{8, 1}};
+    auto parser = ox::detail::Vt_parser{};
+    parser.parse("\033[1;31ma\033[22;38;5;200;44mb\033[0mc", screen);
+    auto const a = screen.at({0, 0});
+    CHECK(a.brush.foreground == ox::Color::Dark_red);
+    CHECK(a.brush.traits == ox::Traits{ox::Trait::Bold});
+    auto const b = screen.at({1, 0});
+    CHECK(b.brush.foreground == ox::Color{200});
+    CHECK(b.brush.background == ox::Color::Dark_blue);
+    CHECK(b.brush.traits == ox::Traits{ox::Trait::None});
+    CHECK(screen.at({2, 0}) == ox::Glyph{U'c'});
+}
+
+TEST_CASE("Vt_parser maps colors through the palette", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{3, 1}};
+    auto parser = ox::detail::Vt_parser{};
+    screen.set_colors(ox::detail::nearest_palette_colors(ox::basic::palette));
+    parser.parse("\033[31ma\033[38;5;196mb\033[38;2;255;255;255;48;5;0mc",
+                 screen);
+    CHECK(screen.at({0, 0}).brush.foreground == ox::basic::Maroon);
+    CHECK(screen.at({1, 0}).brush.foreground == ox::basic::Red);
+    CHECK(screen.at({2, 0}).brush.foreground == ox::basic::White);
+    CHECK(screen.at({2, 0}).brush.background == ox::basic::Black);
+}
+
+TEST_CASE("Vt_parser resumes sequences split across reads", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{6, 2}};
+    auto parser = ox::detail::Vt_parser{};
+    parse_bytewise(parser, "\033[2;2H\033[32mé┼\033]0;title\007!", screen);
+    CHECK(row(screen, 1) == U" é┼!  ");
+    CHECK(screen.at({1, 1}).brush.foreground == ox::Color::Green);
+    CHECK(parser.state() == ox::detail::Vt_parser::State::Ground);
+}
+
+TEST_CASE("Vt_parser alternate screen and damage", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{3, 2}};
+    auto parser = ox::detail::Vt_parser{};
+    parser.parse("abc", screen);
+    screen.clear_damage();
+    CHECK_FALSE(screen.is_damaged());
+
+    parser.parse("\033[?1049h", screen);
+    CHECK(row(screen, 0) == U"   ");
+    parser.parse("\033[2;1Hz", screen);
+    CHECK(screen.is_damaged(1));
+
+    parser.parse("\033[?1049l", screen);
+    CHECK(row(screen, 0) == U"abc");
+    CHECK(row(screen, 1) == U"   ");
+}
+
+TEST_CASE("Vt_parser answers device status reports", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{10, 5}};
+    auto parser = ox::detail::Vt_parser{};
+    parser.parse("\033[3;7H\033[6n", screen);
+    CHECK(screen.responses() == "\033[3;7R");
+    screen.clear_responses();
+    CHECK(screen.responses().empty());
+}
+
+TEST_CASE("Vt_screen resize keeps the cursor row", "[Vt_parser]")
+{
+    auto screen = ox::detail::Vt_screen{{3, 3}};
+    auto parser = ox::detail::Vt_parser{};
+    parser.parse("a\r\nb\r\nc", screen);
+    screen.resize({4, 2});
+    CHECK(screen.area() == ox::Area{4, 2});
+    CHECK(row(screen, 0) == U"b   ");
+    CHECK(row(screen, 1) == U"c   ");
+    CHECK(screen.cursor() == ox::Point{1, 1});
+}